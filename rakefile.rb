@@ -4,3 +4,99 @@ load "#{PROJECT_CEEDLING_ROOT}/lib/ceedling.rb"
 Ceedling.load_project
 
 task :default => %w[ test:all release ]
+
+################################################################
+# Host builds
+# These link the real game logic from reflex-test/src against the
+# stand-in drivers in reflex-test/host so it can run on a PC.
+################################################################
+HOST_SRC_DIR   = "reflex-test/src"
+HOST_DIR       = "reflex-test/host"
+HOST_BUILD_DIR = "reflex-test/build/host"
+HOST_CC        = ENV.fetch("CC", "gcc")
+HOST_BSP_DIR   = "reflex-test_bsp/ps7_cortexa9_0/include"
+HOST_CFLAGS    = "-O2 -std=gnu99 -Wall -I#{HOST_SRC_DIR} -I#{HOST_DIR} " +
+                 "-Ireflex-test/vendor/supportFiles -I#{HOST_BSP_DIR}"
+HOST_LDFLAGS   = "-lpthread -lm"
+
+# Everything in src/ that does not talk to the ZYBO directly.
+HOST_GAME_SOURCES = FileList["#{HOST_SRC_DIR}/*.c"].exclude(
+  "#{HOST_SRC_DIR}/Main.c",
+  "#{HOST_SRC_DIR}/buttons.c",
+  "#{HOST_SRC_DIR}/leds.c",
+  "#{HOST_SRC_DIR}/intervalTimer.c",
+  "#{HOST_SRC_DIR}/events.c",
+  "#{HOST_SRC_DIR}/secondCore.c")
+# LcdMailbox can hand drawing to the second core; a thread stands in for it.
+HOST_GAME_SOURCES.include("#{HOST_DIR}/secondCore.c")
+
+# Stand-ins for the drivers and support files used by runReflexTest().
+HOST_DRIVER_SOURCES = %w[ hostDrivers.c events.c interrupts.c globalTimer.c ].map { |f| "#{HOST_DIR}/#{f}" }
+
+# Stand-ins driven by a virtual clock and a simulated player.
+HOST_SIM_SOURCES = %w[ simDrivers.c simPlayer.c virtualClock.c ].map { |f| "#{HOST_DIR}/#{f}" }
+
+# Compiles and links the given sources into HOST_BUILD_DIR/name.out
+def host_build(name, sources, defines = [])
+  mkdir_p HOST_BUILD_DIR
+  exe = "#{HOST_BUILD_DIR}/#{name}.out"
+  flags = defines.map { |d| "-D#{d}" }.join(' ')
+  sh "#{HOST_CC} #{HOST_CFLAGS} #{flags} #{sources.join(' ')} -o #{exe} #{HOST_LDFLAGS}"
+  exe
+end
+
+namespace :host do
+  desc "Build and run the Executor dispatch benchmark on the host."
+  task :bench_executor do
+    exe = host_build("bench_Executor", HOST_GAME_SOURCES +
+                     ["#{HOST_DIR}/hostDrivers.c", "#{HOST_DIR}/globalTimer.c",
+                      "#{HOST_DIR}/bench_Executor.c"])
+    sh exe
+  end
+
+  desc "Run the game loop from Main.c in real time on the host (RUN_SECONDS=10, LCD_AMP=1 to draw on a second thread)."
+  task :run do
+    seconds = ENV.fetch("RUN_SECONDS", "10")
+    defines = ["TOTAL_SECONDS=#{seconds}"]
+    defines << "LCD_AMP" if ENV["LCD_AMP"]
+    exe = host_build("reflex-test", HOST_GAME_SOURCES + HOST_DRIVER_SOURCES +
+                     ["#{HOST_SRC_DIR}/Main.c"], defines)
+    sh exe
+  end
+
+  desc "Run the game loop from Main.c on a virtual clock with a simulated player (SIM_SECONDS=3600, SIM_SEED=1, SIM_OUT=file, SIM_LOG=1 to dump the input log, SIM_TRACE=1 to drain the trace)."
+  task :sim do
+    seconds = ENV.fetch("SIM_SECONDS", "3600")
+    seed = ENV.fetch("SIM_SEED", "1")
+    out = ENV["SIM_OUT"]
+    defines = ["TOTAL_SECONDS=#{seconds}", "SIM_SEED=#{seed}"]
+    defines << "DUMP_INPUT_LOG" if ENV["SIM_LOG"]
+    defines << "TRACE_DRAIN" if ENV["SIM_TRACE"]
+    exe = host_build("reflex-test-sim", HOST_GAME_SOURCES + HOST_SIM_SOURCES +
+                     ["#{HOST_SRC_DIR}/Main.c"], defines)
+    sh(out ? "#{exe} > #{out}" : exe)
+  end
+
+  desc "Replay an input log through the game logic and time every tick (LOG=file)."
+  task :replay do
+    log = ENV.fetch("LOG") { abort "Set LOG to a binary input log or a capture of InputLog_Print()." }
+    exe = host_build("replay", HOST_GAME_SOURCES +
+                     ["#{HOST_DIR}/hostDrivers.c", "#{HOST_DIR}/globalTimer.c", "#{HOST_DIR}/replay.c"])
+    sh "#{exe} #{log}"
+  end
+
+  desc "Decode the state transition trace in a capture of the UART output (LOG=file)."
+  task :trace do
+    log = ENV.fetch("LOG") { abort "Set LOG to a file that holds the output of Trace_Drain()." }
+    exe = host_build("traceDecoder", %w[ ReflexTestData.c ].map { |f| "#{HOST_SRC_DIR}/#{f}" } +
+                     ["#{HOST_DIR}/traceDecoder.c"])
+    sh "#{exe} #{log}"
+  end
+
+  desc "Simulate many players in parallel on a work-stealing pool (MC_ARGS=\"-p 100000 -t 4\")."
+  task :montecarlo do
+    exe = host_build("monteCarlo", HOST_GAME_SOURCES +
+                     %w[ simDrivers.c workPool.c monteCarlo.c ].map { |f| "#{HOST_DIR}/#{f}" })
+    sh "#{exe} #{ENV.fetch("MC_ARGS", "")}"
+  end
+end
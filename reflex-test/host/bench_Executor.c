@@ -0,0 +1,213 @@
+//*****************************************************************************
+// Host benchmark for the Executor's per-state conductor dispatch.
+//
+// For every state, this measures how many ticks per second the executor can
+// run before (every conductor's Run is called and each one switches on the
+// state, as the conductors did before the state->action table) and after
+// (only the actions in the Executor's state->action table are called). The
+// hardware drivers are no-op stand-ins, so the numbers show the cost of the
+// game logic alone.
+//*****************************************************************************
+
+#include "Executor.h"
+#include "ButtonConductor.h"
+#include "LedConductor.h"
+#include "TimerConductor.h"
+#include "LcdConductor.h"
+#include "ReflexTestData.h"
+#include "ButtonModel.h"
+#include "TimerModel.h"
+#include "Calibration.h"
+#include "LedModel.h"
+#include "LcdModel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_TICKS_PER_STATE 2000000
+
+static ReflexTest_Context game;
+
+// Defined in Executor.c
+ReflexTest_st ReflexTest_TickFunction(ReflexTest_Context* context,
+                                      ReflexTest_st currentState, uint64_t now);
+
+/**
+ * Returns the current time of the monotonic clock in seconds.
+ */
+static double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+// The conductors' actions are private to them, so the switch-based copies
+// below reach them through pointers taken once by bench_initSwitches().
+static ReflexTest_Action buttonPollButtons, buttonWatchForEarlyPresses,
+                         buttonDiscardEarlyPresses, buttonPollResponse;
+static ReflexTest_Action timerStartTiming, timerStartRound, timerRecordResponse,
+                         timerCalculateStats;
+static ReflexTest_Action ledBlankLeds, ledFlashLed, ledNextLed;
+static ReflexTest_Action lcdShowInfo, lcdContinueFrame, lcdBlankScreen, lcdShowTarget,
+                         lcdHideTarget, lcdShowStats;
+
+static void bench_initSwitches(void) {
+  buttonPollButtons          = ButtonConductor_GetAction(wait_info_st);
+  buttonWatchForEarlyPresses = ButtonConductor_GetAction(wait_between_flash_st);
+  buttonDiscardEarlyPresses  = ButtonConductor_GetAction(blink_led_st);
+  buttonPollResponse         = ButtonConductor_GetAction(wait_for_button_st);
+  timerStartTiming           = TimerConductor_GetAction(show_info_st);
+  timerStartRound            = TimerConductor_GetAction(blank_screen_st);
+  timerRecordResponse        = TimerConductor_GetAction(button_pressed_st);
+  timerCalculateStats        = TimerConductor_GetAction(show_stats_st);
+  ledBlankLeds               = LedConductor_GetAction(wait_info_st);
+  ledFlashLed                = LedConductor_GetAction(blink_led_st);
+  ledNextLed                 = LedConductor_GetAction(button_pressed_st);
+  lcdShowInfo                = LcdConductor_GetAction(show_info_st);
+  lcdContinueFrame           = LcdConductor_GetAction(wait_info_st);
+  lcdBlankScreen             = LcdConductor_GetAction(blank_screen_st);
+  lcdShowTarget              = LcdConductor_GetAction(blink_led_st);
+  lcdHideTarget              = LcdConductor_GetAction(button_pressed_st);
+  lcdShowStats               = LcdConductor_GetAction(show_stats_st);
+}
+
+// Copies of the conductors' Run functions from before the table: each one
+// asks its model for the state and switches on it.
+static void bench_buttonConductorSwitch(ReflexTest_Context* context) {
+  switch (ButtonModel_GetCurrentState(context)) {
+    case wait_info_st:
+    case wait_five_seconds_st:
+      buttonPollButtons(context);
+      break;
+    case wait_between_flash_st:
+      buttonWatchForEarlyPresses(context);
+      break;
+    case blink_led_st:
+      buttonDiscardEarlyPresses(context);
+      break;
+    case wait_for_button_st:
+      buttonPollResponse(context);
+      break;
+    default:
+      break;
+  }
+}
+
+static void bench_timerConductorSwitch(ReflexTest_Context* context) {
+  switch (TimerModel_GetCurrentState(context)) {
+    case show_info_st:
+      timerStartTiming(context);
+      break;
+    case blank_screen_st:
+      timerStartRound(context);
+      break;
+    case button_pressed_st:
+      timerRecordResponse(context);
+      break;
+    case show_stats_st:
+      timerCalculateStats(context);
+      break;
+    default:
+      break;
+  }
+}
+
+static void bench_ledConductorSwitch(ReflexTest_Context* context) {
+  switch (LedModel_GetCurrentState(context)) {
+    case show_info_st:
+    case wait_info_st:
+      ledBlankLeds(context);
+      break;
+    case blink_led_st:
+      ledFlashLed(context);
+      break;
+    case button_pressed_st:
+      ledNextLed(context);
+      break;
+    default:
+      break;
+  }
+}
+
+static void bench_lcdConductorSwitch(ReflexTest_Context* context) {
+  switch (LcdModel_GetCurrentState(context)) {
+    case show_info_st:
+      lcdShowInfo(context);
+      break;
+    case wait_info_st:
+    case wait_five_seconds_st:
+    case wait_between_flash_st:
+    case wait_stats_st:
+      lcdContinueFrame(context);
+      break;
+    case blank_screen_st:
+    case update_scores_st:
+      lcdBlankScreen(context);
+      break;
+    case blink_led_st:
+      lcdShowTarget(context);
+      break;
+    case button_pressed_st:
+      lcdHideTarget(context);
+      break;
+    case show_stats_st:
+      lcdShowStats(context);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * The executor tick as it was before the state->action table: every
+ * conductor is run and switches on the state for itself.
+ */
+static void bench_runAllConductors(void) {
+  bench_buttonConductorSwitch(&game);
+  bench_timerConductorSwitch(&game);
+  bench_ledConductorSwitch(&game);
+  bench_lcdConductorSwitch(&game);
+  ReflexTest_st nextState = ReflexTest_TickFunction(&game, ReflexTestData_GetCurrentState(&game),
+                                                    TimerConductor_GetCurrentTime());
+  ReflexTestData_SetCurrentState(&game, nextState);
+}
+
+/**
+ * The executor tick with table-driven dispatch.
+ */
+static void bench_runExecutor(void) {
+  Executor_Run(&game);
+}
+
+/**
+ * Runs BENCH_TICKS_PER_STATE ticks in the given state. The state is forced
+ * back before every tick so that each tick does the work of that state.
+ * @return The number of ticks per second.
+ */
+static double bench_ticksPerSecond(ReflexTest_st state, void (*tick)(void)) {
+  int i;
+  double start = bench_now();
+  for (i = 0; i < BENCH_TICKS_PER_STATE; i++) {
+    ReflexTestData_SetCurrentState(&game, state);
+    tick();
+  }
+  return BENCH_TICKS_PER_STATE / (bench_now() - start);
+}
+
+int main(void) {
+  int state;
+  Executor_Init(&game);
+  Calibration_Run();
+  TimerModel_SetOverhead(&game, Calibration_GetStimulusOverhead());
+  bench_initSwitches();
+
+  printf("%-24s %16s %16s %8s\n", "state", "before (ticks/s)",
+         "after (ticks/s)", "speedup");
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    double before = bench_ticksPerSecond(state, bench_runAllConductors);
+    double after = bench_ticksPerSecond(state, bench_runExecutor);
+    printf("%-24s %16.0f %16.0f %7.2fx\n", ReflexTestData_GetStateName(state),
+           before, after, after / before);
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+//*****************************************************************************
+// Host stand-in for the event flags.
+// A condition variable takes the place of WFI: events_wait() blocks the
+// calling thread until another thread (e.g. the timer thread) posts an event.
+//*****************************************************************************
+
+#include "events.h"
+#include <pthread.h>
+
+static pthread_mutex_t eventsMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t eventsPosted = PTHREAD_COND_INITIALIZER;
+
+// Events that have been posted but not yet taken by events_wait().
+static uint32_t pendingEvents = EVENTS_NONE;
+
+void events_init() {
+  pthread_mutex_lock(&eventsMutex);
+  pendingEvents = EVENTS_NONE;
+  pthread_mutex_unlock(&eventsMutex);
+}
+
+void events_post(uint32_t events) {
+  pthread_mutex_lock(&eventsMutex);
+  pendingEvents |= events;
+  pthread_cond_signal(&eventsPosted);
+  pthread_mutex_unlock(&eventsMutex);
+}
+
+uint32_t events_wait() {
+  uint32_t events;
+  pthread_mutex_lock(&eventsMutex);
+  while (pendingEvents == EVENTS_NONE) {
+    pthread_cond_wait(&eventsPosted, &eventsMutex);
+  }
+  events = pendingEvents;
+  pendingEvents = EVENTS_NONE;
+  pthread_mutex_unlock(&eventsMutex);
+  return events;
+}
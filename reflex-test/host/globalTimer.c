@@ -0,0 +1,26 @@
+//*****************************************************************************
+// Host stand-in for the ARM global timer, backed by the monotonic clock.
+//*****************************************************************************
+
+#include "globalTimer.h"
+#include <time.h>
+
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+
+u64 globalTimer_getTimerValue(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  // Scale to GLOBAL_TIMER_TICKS_PER_SECOND so the values match the board.
+  return ((u64)ts.tv_sec * GLOBAL_TIMER_TICKS_PER_SECOND) +
+         (((u64)ts.tv_nsec * GLOBAL_TIMER_TICKS_PER_SECOND) / NANOSECONDS_PER_SECOND);
+}
+
+void globalTimer_startTimer(bool printStatusFlag) {
+}
+
+void globalTimer_stopTimer(bool printStatusFlag) {
+}
+
+u32 globalTimer_test(bool printStatusFlag) {
+  return 0;
+}
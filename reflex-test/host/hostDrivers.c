@@ -0,0 +1,160 @@
+//*****************************************************************************
+// Host stand-ins for the ZYBO drivers used by the Hardware layer.
+// These do no I/O at all, so anything built against them measures only the
+// cost of the game logic itself.
+//*****************************************************************************
+
+#include "buttons.h"
+#include "leds.h"
+#include "display.h"
+#include "intervalTimer.h"
+
+#define HOSTDRIVERS_DISPLAY_WIDTH  320
+#define HOSTDRIVERS_DISPLAY_HEIGHT 240
+#define HOSTDRIVERS_TIMER_FREQUENCY 100000000  // the AXI timers' clock on the board
+
+//****************************** buttons.h ************************************
+
+int buttons_init() {
+  return BUTTONS_INIT_STATUS_OK;
+}
+
+// There is no GPIO interrupt on the host, so the buttons are only polled.
+int buttons_enableInterrupts(buttons_edgeHandler_t handler) {
+  return BUTTONS_INIT_STATUS_FAIL;
+}
+
+int32_t buttons_read() {
+  return 0;  // no buttons pressed
+}
+
+//******************************** leds.h *************************************
+
+int leds_init(bool printFailedStatusFlag) {
+  return 0;
+}
+
+int leds_write(int ledValue) {
+  return 0;
+}
+
+int leds_writeLd4(int ledValue) {
+  return 0;
+}
+
+//******************************* display.h ***********************************
+
+void display_init() {
+}
+
+void display_fillScreen(uint16_t color) {
+}
+
+void display_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+}
+
+void display_setCursor(int16_t x, int16_t y) {
+}
+
+void display_setTextColor(uint16_t c) {
+}
+
+void display_setTextSize(uint8_t s) {
+}
+
+size_t display_println(const char str[]) {
+  return 0;
+}
+
+int16_t display_height() {
+  return HOSTDRIVERS_DISPLAY_HEIGHT;
+}
+
+int16_t display_width() {
+  return HOSTDRIVERS_DISPLAY_WIDTH;
+}
+
+// There is no touch controller on the host, so the panel is never touched.
+void display_initTouch() {
+}
+
+int display_enableTouchInterrupts(display_touchHandler_t handler) {
+  return DISPLAY_TOUCH_STATUS_FAIL;
+}
+
+uint8_t display_readTouchedPoints(display_touchPoint_t points[], uint8_t maxPoints) {
+  return 0;
+}
+
+bool display_isTouched(void) {
+  return false;
+}
+
+void display_clearOldTouchData() {
+}
+
+//**************************** intervalTimer.h ********************************
+
+uint32_t intervalTimer_start(uint32_t timerNumber) {
+  return 0;
+}
+
+uint32_t intervalTimer_stop(uint32_t timerNumber) {
+  return 0;
+}
+
+uint32_t intervalTimer_reset(uint32_t timerNumber) {
+  return 0;
+}
+
+uint32_t intervalTimer_init(uint32_t timerNumber) {
+  return 0;
+}
+
+uint32_t intervalTimer_initAll() {
+  return 0;
+}
+
+uint32_t intervalTimer_resetAll() {
+  return 0;
+}
+
+uint32_t intervalTimer_getTotalDurationInSeconds(uint32_t timerNumber,
+                                                 double *seconds) {
+  *seconds = 0.0;
+  return 0;
+}
+
+uint32_t intervalTimer_getTotalDurationInMicroseconds(uint32_t timerNumber,
+                                                      uint64_t *microseconds) {
+  *microseconds = 0;
+  return 0;
+}
+
+uint32_t intervalTimer_getHandle(uint32_t timerNumber, intervalTimer_Handle* handle) {
+  handle->registers = NULL;
+  handle->tcsr0 = INTERVALTIMER_ENABLE_CASC_MASK;
+  handle->timerNumber = timerNumber;
+  handle->frequency = HOSTDRIVERS_TIMER_FREQUENCY;
+  handle->wrapMicroseconds = UINT32_MAX;
+  return 0;
+}
+
+void intervalTimer_fastStart(intervalTimer_Handle* handle) {
+}
+
+void intervalTimer_fastStop(intervalTimer_Handle* handle) {
+}
+
+void intervalTimer_fastReset(intervalTimer_Handle* handle) {
+}
+
+uint64_t intervalTimer_fastRead(const intervalTimer_Handle* handle) {
+  return 0;
+}
+
+uint64_t intervalTimer_fastElapsed(const intervalTimer_Handle* handle,
+                                   uint64_t start,
+                                   uint32_t boundMicroseconds) {
+  return 0;
+}
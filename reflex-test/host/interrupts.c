@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Host stand-in for the interrupt support code.
+// The ARM private timer is replaced by a thread that calls the timer "ISR"
+// once per period of real time. Like XScuTimer_LoadTimer() on the board,
+// loading a new value restarts the count.
+//*****************************************************************************
+
+#include "interrupts.h"
+#include "xparameters.h"
+#include "events.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+// The private timer clock is 1/2 the processor frequency, as on the ZYBO board.
+#define ZYBO_BUS_CLOCK (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+#define PRIVATE_TIMER_LOAD_VALUE_DEFAULT 3249  // Provides a 10 us interrupt period.
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+
+volatile int interrupts_isrFlagGlobal = 0;
+
+static volatile u32 isrInvocationCount = 0;
+static volatile u32 privateTimerLoadValue = PRIVATE_TIMER_LOAD_VALUE_DEFAULT;
+static volatile bool timerRunning = false;
+static volatile bool timerIntsEnabled = false;
+static volatile bool armIntsEnabled = false;
+static pthread_t timerThread;
+// Wakes the timer thread early when the load value changes.
+static pthread_mutex_t timerLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timerLoaded;
+static bool reloaded = false;
+
+// Stands in for timerIsr() in interrupts.c.
+static void timerIsr(void) {
+  isrInvocationCount++;
+  interrupts_isrFlagGlobal = 1;
+  events_post(EVENTS_TIMER_TICK);
+}
+
+// Moves a time one period of the private timer on.
+static void addPeriod(struct timespec* time) {
+  u64 period = ((u64)(privateTimerLoadValue + 1) * NANOSECONDS_PER_SECOND) / ZYBO_BUS_CLOCK;
+  time->tv_nsec += period;
+  while (time->tv_nsec >= NANOSECONDS_PER_SECOND) {
+    time->tv_nsec -= NANOSECONDS_PER_SECOND;
+    time->tv_sec++;
+  }
+}
+
+// Ticks the "private timer" at the rate given by the load value.
+static void* timerThreadMain(void* arg) {
+  struct timespec next;
+  pthread_mutex_lock(&timerLock);
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  addPeriod(&next);
+  while (timerRunning) {
+    int status = pthread_cond_timedwait(&timerLoaded, &timerLock, &next);
+    if (reloaded) {
+      // A new load value: the next interrupt is one new period from now.
+      reloaded = false;
+      clock_gettime(CLOCK_MONOTONIC, &next);
+      addPeriod(&next);
+    }
+    else if (status == ETIMEDOUT) {
+      addPeriod(&next);
+      if (timerIntsEnabled && armIntsEnabled) {
+        pthread_mutex_unlock(&timerLock);
+        timerIsr();
+        pthread_mutex_lock(&timerLock);
+      }
+    }
+  }
+  pthread_mutex_unlock(&timerLock);
+  return NULL;
+}
+
+int interrupts_initAll(bool printFailedStatusFlag) {
+  return 0;
+}
+
+int interrupts_enableArmInts() {
+  armIntsEnabled = true;
+  return 0;
+}
+
+int interrupts_disableArmInts() {
+  armIntsEnabled = false;
+  return 0;
+}
+
+int interrupts_enableTimerGlobalInts() {
+  timerIntsEnabled = true;
+  return 0;
+}
+
+int interrupts_disableTimerGlobalInts() {
+  timerIntsEnabled = false;
+  return 0;
+}
+
+int interrupts_startArmPrivateTimer() {
+  if (!timerRunning) {
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&timerLoaded, &attributes);
+    pthread_condattr_destroy(&attributes);
+    reloaded = false;
+    timerRunning = true;
+    pthread_create(&timerThread, NULL, timerThreadMain, NULL);
+  }
+  return 0;
+}
+
+int interrupts_stopArmPrivateTimer() {
+  if (timerRunning) {
+    pthread_mutex_lock(&timerLock);
+    timerRunning = false;
+    pthread_cond_signal(&timerLoaded);
+    pthread_mutex_unlock(&timerLock);
+    pthread_join(timerThread, NULL);
+    pthread_cond_destroy(&timerLoaded);
+  }
+  return 0;
+}
+
+void interrupts_setPrivateTimerLoadValue(u32 loadValue) {
+  pthread_mutex_lock(&timerLock);
+  privateTimerLoadValue = loadValue;
+  if (timerRunning) {
+    reloaded = true;
+    pthread_cond_signal(&timerLoaded);
+  }
+  pthread_mutex_unlock(&timerLock);
+}
+
+u32 interrupts_isrInvocationCount() {
+  return isrInvocationCount;
+}
+
+u32 interrupts_getPrivateTimerTicksPerSecond() {
+  return ZYBO_BUS_CLOCK / (privateTimerLoadValue + 1);
+}
@@ -0,0 +1,483 @@
+//*****************************************************************************
+// Monte Carlo player simulator.
+//
+// Simulates many synthetic players on the real game logic (Executor,
+// Conductors and Models) to measure how fast the game logic runs and how the
+// flash waits and scoring treat different players. Players are split into
+// stations of playersPerStation players each. Every station is one
+// ReflexTest_Context with its own virtual clock, and the stations are run in
+// parallel by a work-stealing thread pool.
+//
+// Each tick jumps the station's virtual clock straight to the next time
+// something can change (a software timer deadline or a button press or
+// release), so waits cost one tick instead of thousands. Ticks stay on the
+// per-state tick period grid from Executor_GetTickPeriod().
+//
+// Some players guess: between two LEDs they press a button before the next
+// one lights, and hold it until they see it. The game should then not count
+// their response to that LED, which shows up as a false start.
+//
+// Usage: monteCarlo [-p players] [-g playersPerStation] [-t threads]
+//                   [-m meanMs] [-d deviationMs] [-v playerSpreadMs]
+//                   [-x missPercent] [-e earlyPercent] [-r seed]
+//*****************************************************************************
+
+#include "Executor.h"
+#include "Calibration.h"
+#include "TimerModel.h"
+#include "ReflexTestData.h"
+#include "SoftTimer.h"
+#include "buttons.h"
+#include "intervalTimer.h"
+#include "globalTimer.h"
+#include "virtualClock.h"
+#include "simPlayer.h"
+#include "workPool.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MC_TICKS_PER_MILLISECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000)
+#define MC_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+#define MC_MS_TO_TICKS(ms) ((uint64_t) ((ms) * (GLOBAL_TIMER_TICKS_PER_SECOND / 1000)))
+
+#define MC_HOLD_MS              5500  // long enough to start a game
+#define MC_PRESS_MS             100   // how long a button is pressed
+#define MC_MIN_REACTION_MS      100
+#define MC_MAX_REACTION_MS      4000
+#define MC_EARLY_WINDOW_MS      1000  // guesses come this soon after an LED goes off,
+                                      // before the shortest wait for the next one
+#define MC_MICROSECONDS_PER_SECOND REFLEXTESTDATA_MICROSECONDS_PER_SECOND
+#define MC_NO_SCORE             REFLEXTESTDATA_SLOWEST_RESPONSE_TIME  // initial high score
+
+typedef struct {
+  uint32_t players;
+  uint32_t playersPerStation;
+  uint32_t threads;
+  double meanMs;        // average reaction time over all players
+  double deviationMs;   // spread of one player's reactions
+  double spreadMs;      // spread of the players' own average reaction times
+  uint32_t missPercent; // chance of not noticing an LED, ending the game
+  uint32_t earlyPercent; // chance of pressing before the next LED lights
+  uint32_t seed;
+} mc_config;
+
+// Results for one station.
+typedef struct {
+  uint32_t gamesCompleted;
+  uint32_t gamesAborted;
+  uint64_t sumOfAverages;   // microseconds, like the scores below
+  uint32_t falseStarts;     // responses that did not count
+  uint32_t fastestAverage;
+  uint32_t slowestAverage;
+  uint64_t dwell[REFLEXTESTDATA_NUMBER_OF_STATES];  // global timer ticks
+  uint32_t highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES];
+} mc_result;
+
+// One station: a game, its virtual clock, and the player at it.
+typedef struct {
+  ReflexTest_Context game;
+  uint64_t now;              // global timer ticks
+  unsigned int seed;
+  double playerMeanMs;
+  int32_t litLed;
+  int32_t heldButtons;
+  uint64_t releaseTime;
+  int32_t plannedButtons;
+  uint64_t pressTime;
+  bool guessing;             // the planned or held press came before the LED
+  uint64_t tickStart;        // when the tick timer was last loaded
+  uint64_t tickPeriod;       // global timer ticks between executor ticks
+} mc_station;
+
+typedef struct {
+  const mc_config* config;
+  const ReflexTest_Context* initialGame;
+  mc_result* results;
+} mc_run;
+
+// The station that the drivers on this thread are talking to.
+static __thread mc_station* station;
+
+//******************** Virtual clock and player stand-ins ********************
+// simDrivers.c reads the buttons and time, and reports LED writes, through
+// these functions. Here they go to the current thread's station.
+
+uint64_t virtualClock_now() {
+  return station->now;
+}
+
+void virtualClock_advanceTo(uint64_t ticks) {
+  if (ticks > station->now) {
+    station->now = ticks;
+  }
+}
+
+double virtualClock_seconds() {
+  return (double) station->now / GLOBAL_TIMER_TICKS_PER_SECOND;
+}
+
+u64 globalTimer_getTimerValue(void) {
+  return station->now;
+}
+
+void globalTimer_startTimer(bool printStatusFlag) {
+}
+
+void globalTimer_stopTimer(bool printStatusFlag) {
+}
+
+u32 globalTimer_test(bool printStatusFlag) {
+  return 0;
+}
+
+/**
+ * Returns a normally distributed random number (Box-Muller).
+ */
+static double mc_normal(unsigned int* seed, double mean, double deviation) {
+  double u1 = (rand_r(seed) + 1.0) / (RAND_MAX + 2.0);
+  double u2 = (rand_r(seed) + 1.0) / (RAND_MAX + 2.0);
+  return mean + deviation * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static const mc_config* config;
+
+void simPlayer_ledsWritten(int32_t ledValue) {
+  if (ledValue == station->litLed) {
+    return;
+  }
+  station->litLed = ledValue;
+  if (ledValue == 0) {
+    // Waiting for the next LED, the player may guess a button and press it.
+    if (config->earlyPercent != 0 &&
+        (uint32_t) (rand_r(&station->seed) % 100) < config->earlyPercent) {
+      uint32_t guessMs = MC_MIN_REACTION_MS +
+                         rand_r(&station->seed) % (MC_EARLY_WINDOW_MS - MC_MIN_REACTION_MS);
+      station->plannedButtons = 1 << (rand_r(&station->seed) % REFLEXTESTDATA_NUMBER_OF_LEDS);
+      station->pressTime = station->now + MC_MS_TO_TICKS(guessMs);
+      station->guessing = true;
+    }
+    return;
+  }
+  // A player who guessed lets go on seeing the LED, then responds as usual.
+  if (station->guessing) {
+    station->heldButtons = 0;
+    station->plannedButtons = 0;
+    station->guessing = false;
+  }
+  if ((uint32_t) (rand_r(&station->seed) % 100) < config->missPercent) {
+    return;
+  }
+  double reactionMs = mc_normal(&station->seed, station->playerMeanMs,
+                                config->deviationMs);
+  reactionMs = fmin(fmax(reactionMs, MC_MIN_REACTION_MS), MC_MAX_REACTION_MS);
+  station->plannedButtons = ledValue;
+  station->pressTime = station->now + MC_MS_TO_TICKS(reactionMs);
+}
+
+/**
+ * Presses and releases the player's buttons up to the current time.
+ */
+static void mc_updatePlayer(void) {
+  if (station->plannedButtons != 0 && station->now >= station->pressTime) {
+    station->heldButtons = station->plannedButtons;
+    station->plannedButtons = 0;
+    // A guess is held until the LED lights.
+    station->releaseTime = station->guessing ? UINT64_MAX :
+                           station->now + MC_MS_TO_TICKS(MC_PRESS_MS);
+  }
+  if (station->heldButtons != 0 && station->now >= station->releaseTime) {
+    station->heldButtons = 0;
+  }
+}
+
+int32_t simPlayer_readButtons() {
+  mc_updatePlayer();
+  return station->heldButtons;
+}
+
+//******************************* Simulation *********************************
+
+/**
+ * Returns the first executor tick at or after the given time.
+ */
+static uint64_t mc_nextTickAtOrAfter(uint64_t time) {
+  uint64_t periods = (time - station->tickStart + station->tickPeriod - 1) / station->tickPeriod;
+  return station->tickStart + (periods * station->tickPeriod);
+}
+
+/**
+ * Reloads the tick timer for the given state, as runReflexTest() does.
+ */
+static void mc_setTickPeriod(ReflexTest_st state) {
+  station->tickStart = station->now;
+  station->tickPeriod = (uint64_t) Executor_GetTickPeriod(state) * MC_TICKS_PER_MICROSECOND;
+}
+
+/**
+ * Returns the next time at which the player's buttons change.
+ */
+static uint64_t mc_nextPlayerEvent(void) {
+  uint64_t next = UINT64_MAX;
+  mc_updatePlayer();
+  if (station->plannedButtons != 0) {
+    next = station->pressTime;
+  }
+  if (station->heldButtons != 0 && station->releaseTime < next) {
+    next = station->releaseTime;
+  }
+  return next;
+}
+
+/**
+ * Plays one game with a new player, from show_info_st until the scores are
+ * updated or the player misses an LED and the game gives up.
+ */
+static void mc_playGame(mc_result* result) {
+  ReflexTest_Context* game = &station->game;
+
+  // A new player walks up and holds a button to start.
+  station->playerMeanMs = fmax(mc_normal(&station->seed, config->meanMs, config->spreadMs),
+                               MC_MIN_REACTION_MS);
+  station->heldButtons = BUTTONS_BTN0_MASK;
+  station->releaseTime = station->now + MC_MS_TO_TICKS(MC_HOLD_MS);
+  station->plannedButtons = 0;
+  station->guessing = false;
+
+  while (true) {
+    ReflexTest_st before = ReflexTestData_GetCurrentState(game);
+    Executor_Run(game);
+    ReflexTest_st after = ReflexTestData_GetCurrentState(game);
+
+    // Nothing changes until a deadline passes or the player's buttons
+    // change, so skip the ticks in between.
+    uint64_t next;
+    if (after != before) {
+      if (Executor_GetTickPeriod(after) != Executor_GetTickPeriod(before)) {
+        mc_setTickPeriod(after);
+      }
+      next = mc_nextTickAtOrAfter(station->now + 1);
+    }
+    else {
+      uint64_t deadline = SoftTimer_GetNextDeadline(&game->timers);
+      uint64_t wake = mc_nextPlayerEvent();
+      uint64_t settle = Debounce_GetNextSettle(&game->debounce);
+      if (deadline != SOFTTIMER_NEVER && deadline * MC_TICKS_PER_MICROSECOND < wake) {
+        wake = deadline * MC_TICKS_PER_MICROSECOND;
+      }
+      // A press only counts once a read sees that it has held still.
+      if (settle > station->now && settle < wake) {
+        wake = settle;
+      }
+      if (wake <= station->now) {
+        wake = station->now + 1;
+      }
+      next = (wake == UINT64_MAX) ? station->now + station->tickPeriod : mc_nextTickAtOrAfter(wake);
+    }
+    result->dwell[after] += next - station->now;
+    station->now = next;
+
+    if (before == update_scores_st) {
+      uint32_t average = ReflexTestData_GetAverageResponseTime(game);
+      result->gamesCompleted++;
+      result->sumOfAverages += average;
+      result->falseStarts += ReflexTestData_GetFalseStarts(game);
+      if (average < result->fastestAverage) {
+        result->fastestAverage = average;
+      }
+      if (average > result->slowestAverage) {
+        result->slowestAverage = average;
+      }
+      return;
+    }
+    if (before == wait_for_button_st && after == show_info_st) {
+      result->gamesAborted++;
+      return;
+    }
+  }
+}
+
+/**
+ * Work pool task: plays all of the games at one station.
+ */
+static void mc_runStation(uint32_t stationNumber, void* arg) {
+  mc_run* run = arg;
+  mc_result* result = &run->results[stationNumber];
+  mc_station thisStation;
+  uint32_t first = stationNumber * config->playersPerStation;
+  uint32_t players = config->players - first;
+  uint32_t i;
+
+  if (players > config->playersPerStation) {
+    players = config->playersPerStation;
+  }
+  memset(&thisStation, 0, sizeof(thisStation));
+  thisStation.game = *run->initialGame;
+  thisStation.seed = config->seed * 7919 + stationNumber;
+  station = &thisStation;
+  intervalTimer_initAll();
+  mc_setTickPeriod(ReflexTestData_GetCurrentState(&thisStation.game));
+
+  memset(result, 0, sizeof(*result));
+  result->fastestAverage = MC_NO_SCORE;
+  for (i = 0; i < players; i++) {
+    mc_playGame(result);
+  }
+  memcpy(result->highScores, ReflexTestData_GetHighScores(&thisStation.game),
+         sizeof(result->highScores));
+  station = NULL;
+}
+
+static int mc_compareScores(const void* a, const void* b) {
+  uint32_t x = *(const uint32_t*) a;
+  uint32_t y = *(const uint32_t*) b;
+  return (x > y) - (x < y);
+}
+
+static void mc_printReport(const mc_config* config, const mc_result* results,
+                           uint32_t stations, uint32_t steals, double wallSeconds) {
+  mc_result total;
+  uint32_t* allScores = malloc(stations * REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES * sizeof(uint32_t));
+  uint32_t numberOfScores = 0;
+  uint32_t i, j;
+
+  memset(&total, 0, sizeof(total));
+  total.fastestAverage = MC_NO_SCORE;
+  for (i = 0; i < stations; i++) {
+    total.gamesCompleted += results[i].gamesCompleted;
+    total.gamesAborted += results[i].gamesAborted;
+    total.sumOfAverages += results[i].sumOfAverages;
+    total.falseStarts += results[i].falseStarts;
+    if (results[i].fastestAverage < total.fastestAverage) {
+      total.fastestAverage = results[i].fastestAverage;
+    }
+    if (results[i].slowestAverage > total.slowestAverage) {
+      total.slowestAverage = results[i].slowestAverage;
+    }
+    for (j = 0; j < REFLEXTESTDATA_NUMBER_OF_STATES; j++) {
+      total.dwell[j] += results[i].dwell[j];
+    }
+    for (j = 0; j < REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES; j++) {
+      if (results[i].highScores[j] < MC_NO_SCORE) {
+        allScores[numberOfScores++] = results[i].highScores[j];
+      }
+    }
+  }
+  qsort(allScores, numberOfScores, sizeof(uint32_t), mc_compareScores);
+
+  uint64_t totalDwell = 0;
+  for (j = 0; j < REFLEXTESTDATA_NUMBER_OF_STATES; j++) {
+    totalDwell += total.dwell[j];
+  }
+  uint32_t games = total.gamesCompleted + total.gamesAborted;
+
+  printf("players:             %lu on %lu stations, %lu threads (%lu stations stolen)\n",
+         (unsigned long) config->players, (unsigned long) stations,
+         (unsigned long) config->threads, (unsigned long) steals);
+  printf("reaction times:      mean %.0f ms, deviation %.0f ms, player spread %.0f ms, "
+         "%lu%% missed, %lu%% early\n",
+         config->meanMs, config->deviationMs, config->spreadMs,
+         (unsigned long) config->missPercent, (unsigned long) config->earlyPercent);
+  printf("games completed:     %lu (%lu gave up after a missed LED)\n",
+         (unsigned long) total.gamesCompleted, (unsigned long) total.gamesAborted);
+  printf("wall-clock time:     %.2f s\n", wallSeconds);
+  printf("games per second:    %.0f\n", games / wallSeconds);
+  printf("simulated play time: %.1f days\n",
+         (double) totalDwell / GLOBAL_TIMER_TICKS_PER_SECOND / 86400);
+  if (total.gamesCompleted > 0) {
+    printf("average score:       %.4f s (best game %.4f s, worst game %.4f s)\n",
+           (double) total.sumOfAverages / total.gamesCompleted / MC_MICROSECONDS_PER_SECOND,
+           (double) total.fastestAverage / MC_MICROSECONDS_PER_SECOND,
+           (double) total.slowestAverage / MC_MICROSECONDS_PER_SECOND);
+    printf("false starts:        %lu (%.3f per game)\n", (unsigned long) total.falseStarts,
+           (double) total.falseStarts / total.gamesCompleted);
+  }
+
+  printf("\nleaderboard (best of every station's high scores):\n");
+  for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES && i < numberOfScores; i++) {
+    printf("  %2lu. %.4f s\n", (unsigned long) (i + 1),
+           (double) allScores[i] / MC_MICROSECONDS_PER_SECOND);
+  }
+
+  printf("\n%-24s %14s %8s\n", "state", "ms per game", "time");
+  for (j = 0; j < REFLEXTESTDATA_NUMBER_OF_STATES; j++) {
+    if (total.dwell[j] == 0) {
+      continue;
+    }
+    printf("%-24s %14.1f %7.2f%%\n", ReflexTestData_GetStateName(j),
+           (double) total.dwell[j] / MC_TICKS_PER_MILLISECOND / games,
+           100.0 * total.dwell[j] / totalDwell);
+  }
+  free(allScores);
+}
+
+int main(int argc, char* argv[]) {
+  mc_config settings = {
+    .players = 100000,
+    .playersPerStation = 1000,
+    .threads = sysconf(_SC_NPROCESSORS_ONLN),
+    .meanMs = 300,
+    .deviationMs = 60,
+    .spreadMs = 50,
+    .missPercent = 1,
+    .earlyPercent = 2,
+    .seed = 1,
+  };
+  int option;
+  while ((option = getopt(argc, argv, "p:g:t:m:d:v:x:e:r:")) != -1) {
+    switch (option) {
+      case 'p': settings.players = strtoul(optarg, NULL, 0); break;
+      case 'g': settings.playersPerStation = strtoul(optarg, NULL, 0); break;
+      case 't': settings.threads = strtoul(optarg, NULL, 0); break;
+      case 'm': settings.meanMs = atof(optarg); break;
+      case 'd': settings.deviationMs = atof(optarg); break;
+      case 'v': settings.spreadMs = atof(optarg); break;
+      case 'x': settings.missPercent = strtoul(optarg, NULL, 0); break;
+      case 'e': settings.earlyPercent = strtoul(optarg, NULL, 0); break;
+      case 'r': settings.seed = strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "usage: %s [-p players] [-g playersPerStation] [-t threads] "
+                "[-m meanMs] [-d deviationMs] [-v playerSpreadMs] [-x missPercent] "
+                "[-e earlyPercent] [-r seed]\n", argv[0]);
+        return 1;
+    }
+  }
+  if (settings.threads == 0) {
+    settings.threads = 1;
+  }
+  if (settings.playersPerStation == 0) {
+    settings.playersPerStation = 1;
+  }
+  config = &settings;
+
+  // Initialize one game and copy it to every station. This also builds the
+  // Executor's action table once, before any threads start.
+  mc_station initialStation;
+  memset(&initialStation, 0, sizeof(initialStation));
+  station = &initialStation;
+  Executor_Init(&initialStation.game);
+  Calibration_Run();
+  TimerModel_SetOverhead(&initialStation.game, Calibration_GetStimulusOverhead());
+  station = NULL;
+
+  uint32_t stations = (settings.players + settings.playersPerStation - 1) /
+                      settings.playersPerStation;
+  mc_run run = {
+    .config = &settings,
+    .initialGame = &initialStation.game,
+    .results = calloc(stations, sizeof(mc_result)),
+  };
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  uint32_t steals = workPool_run(settings.threads, stations, mc_runStation, &run);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double wallSeconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+
+  mc_printReport(&settings, run.results, stations, steals, wallSeconds);
+  free(run.results);
+  return 0;
+}
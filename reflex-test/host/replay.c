@@ -0,0 +1,163 @@
+//*****************************************************************************
+// Replays a recorded input log through the game logic.
+//
+// The log is either a raw binary log or the text printed by InputLog_Print()
+// (for example a capture of the board's UART, or the output of
+// "rake host:sim SIM_LOG=..."). Every tick is run through Executor_Run with
+// the recorded inputs, and every recorded state change is checked, so the
+// replay proves that it matches the original session. Each tick is also
+// timed, which makes a recorded session a benchmark for changes to the game
+// logic.
+//
+// Usage: replay <log>
+//*****************************************************************************
+
+#include "Executor.h"
+#include "Calibration.h"
+#include "TimerModel.h"
+#include "InputLog.h"
+#include "ReflexTestData.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPLAY_LINE_LENGTH 256
+
+// Tick count and cost per state.
+static uint64_t ticks[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint64_t totalNanoseconds[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint64_t longestNanoseconds[REFLEXTESTDATA_NUMBER_OF_STATES];
+
+static ReflexTest_Context game;
+
+static uint64_t replay_nanoseconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+/**
+ * Reads the whole file into memory.
+ */
+static uint8_t* replay_readFile(const char* path, uint32_t* size) {
+  FILE* file = fopen(path, "rb");
+  uint8_t* data;
+  long length;
+  if (file == NULL) {
+    return NULL;
+  }
+  fseek(file, 0, SEEK_END);
+  length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  data = malloc(length + 1);
+  *size = fread(data, 1, length, file);
+  data[*size] = '\0';
+  fclose(file);
+  return data;
+}
+
+/**
+ * If the file holds InputLog_Print() output, decodes the hex between the
+ * begin and end lines in place.
+ */
+static void replay_decodeHexDump(uint8_t* data, uint32_t* size) {
+  char* text = strstr((char*) data, "inputlog begin");
+  uint32_t decoded = 0;
+  char line[REPLAY_LINE_LENGTH];
+
+  if (text == NULL) {
+    return;
+  }
+  text += strcspn(text, "\r\n");
+  while (*text != '\0') {
+    text += strspn(text, "\r\n");
+    size_t length = strcspn(text, "\r\n");
+    if (length >= REPLAY_LINE_LENGTH) {
+      length = REPLAY_LINE_LENGTH - 1;
+    }
+    memcpy(line, text, length);
+    line[length] = '\0';
+    text += length;
+    if (strncmp(line, "inputlog end", 12) == 0) {
+      break;
+    }
+    size_t i;
+    for (i = 0; i + 1 < length; i += 2) {
+      unsigned int byte;
+      sscanf(&line[i], "%2x", &byte);
+      data[decoded++] = (uint8_t) byte;
+    }
+  }
+  *size = decoded;
+}
+
+int main(int argc, char* argv[]) {
+  uint32_t size;
+  uint8_t* log;
+  uint64_t stateChanges = 0;
+  uint64_t allTicks = 0;
+  uint64_t allNanoseconds = 0;
+  int state;
+
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <log>\n", argv[0]);
+    return 1;
+  }
+  log = replay_readFile(argv[1], &size);
+  if (log == NULL) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+  replay_decodeHexDump(log, &size);
+  if (!InputLog_StartReplay(log, size)) {
+    fprintf(stderr, "%s is not an input log\n", argv[1]);
+    return 1;
+  }
+
+  Executor_Init(&game);
+  // The overhead the board measured comes back out of the log.
+  TimerModel_SetOverhead(&game, Calibration_GetStimulusOverhead());
+  while (!InputLog_IsReplayDone() && !InputLog_HasDiverged()) {
+    ReflexTest_st before = ReflexTestData_GetCurrentState(&game);
+    uint64_t start = replay_nanoseconds();
+    Executor_Run(&game);
+    uint64_t cost = replay_nanoseconds() - start;
+    ReflexTest_st after = ReflexTestData_GetCurrentState(&game);
+    if (after != before) {
+      InputLog_State(after);
+      stateChanges++;
+    }
+    ticks[before]++;
+    totalNanoseconds[before] += cost;
+    if (cost > longestNanoseconds[before]) {
+      longestNanoseconds[before] = cost;
+    }
+  }
+
+  printf("\nlog:           %lu bytes\n", (unsigned long) size);
+  if (InputLog_HasDiverged()) {
+    printf("result:        DIVERGED at byte %lu, after %llu state changes\n",
+           (unsigned long) InputLog_GetSize(), (unsigned long long) stateChanges);
+  }
+  else {
+    printf("result:        matched the recording (%llu state changes)\n",
+           (unsigned long long) stateChanges);
+  }
+
+  printf("\n%-24s %12s %12s %12s\n", "state", "ticks", "ns per tick", "longest ns");
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    if (ticks[state] == 0) {
+      continue;
+    }
+    printf("%-24s %12llu %12.1f %12llu\n", ReflexTestData_GetStateName(state),
+           (unsigned long long) ticks[state], (double) totalNanoseconds[state] / ticks[state],
+           (unsigned long long) longestNanoseconds[state]);
+    allTicks += ticks[state];
+    allNanoseconds += totalNanoseconds[state];
+  }
+  printf("%-24s %12llu %12.1f\n", "all", (unsigned long long) allTicks,
+         allTicks ? (double) allNanoseconds / allTicks : 0.0);
+  free(log);
+  return InputLog_HasDiverged() ? 1 : 0;
+}
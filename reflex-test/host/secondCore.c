@@ -0,0 +1,43 @@
+//*****************************************************************************
+// Host stand-in for the second core.
+// A thread takes the place of CPU1, and a flag guarded by a condition
+// variable takes the place of the event register behind SEV/WFE: a notify
+// that comes before the wait is remembered, so it is never lost.
+//*****************************************************************************
+
+#include "secondCore.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+static pthread_mutex_t secondCoreMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t secondCoreSignalled = PTHREAD_COND_INITIALIZER;
+
+// Set by secondCore_notify() and cleared by secondCore_wait(), like SEV/WFE.
+static bool eventRegister = false;
+
+static void* secondCore_thread(void* entry) {
+  ((void (*)(void)) entry)();
+  return NULL;
+}
+
+void secondCore_start(void (*entry)(void)) {
+  pthread_t thread;
+  pthread_create(&thread, NULL, secondCore_thread, (void*) entry);
+  pthread_detach(thread);
+}
+
+void secondCore_notify() {
+  pthread_mutex_lock(&secondCoreMutex);
+  eventRegister = true;
+  pthread_cond_signal(&secondCoreSignalled);
+  pthread_mutex_unlock(&secondCoreMutex);
+}
+
+void secondCore_wait() {
+  pthread_mutex_lock(&secondCoreMutex);
+  while (!eventRegister) {
+    pthread_cond_wait(&secondCoreSignalled, &secondCoreMutex);
+  }
+  eventRegister = false;
+  pthread_mutex_unlock(&secondCoreMutex);
+}
@@ -0,0 +1,238 @@
+//*****************************************************************************
+// Host stand-ins for the ZYBO drivers used by the Hardware layer, driven by
+// the virtual clock and the simulated player. The display draws nothing.
+//*****************************************************************************
+
+#include "buttons.h"
+#include "leds.h"
+#include "display.h"
+#include "intervalTimer.h"
+#include "globalTimer.h"
+#include "virtualClock.h"
+#include "simPlayer.h"
+#include <stdbool.h>
+
+#define SIMDRIVERS_DISPLAY_WIDTH  320
+#define SIMDRIVERS_DISPLAY_HEIGHT 240
+#define SIMDRIVERS_NUMBER_OF_TIMERS (INTERVALTIMER_TIMER2 + 1)
+
+//****************************** buttons.h ************************************
+
+int buttons_init() {
+  return BUTTONS_INIT_STATUS_OK;
+}
+
+// The simulated player is only polled; it raises no interrupts.
+int buttons_enableInterrupts(buttons_edgeHandler_t handler) {
+  return BUTTONS_INIT_STATUS_FAIL;
+}
+
+int32_t buttons_read() {
+  return simPlayer_readButtons();
+}
+
+//******************************** leds.h *************************************
+
+int leds_init(bool printFailedStatusFlag) {
+  return 0;
+}
+
+int leds_write(int ledValue) {
+  simPlayer_ledsWritten(ledValue);
+  return 0;
+}
+
+int leds_writeLd4(int ledValue) {
+  return 0;
+}
+
+//******************************* display.h ***********************************
+
+void display_init() {
+}
+
+void display_fillScreen(uint16_t color) {
+}
+
+void display_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+}
+
+void display_setCursor(int16_t x, int16_t y) {
+}
+
+void display_setTextColor(uint16_t c) {
+}
+
+void display_setTextSize(uint8_t s) {
+}
+
+size_t display_println(const char str[]) {
+  return 0;
+}
+
+int16_t display_height() {
+  return SIMDRIVERS_DISPLAY_HEIGHT;
+}
+
+int16_t display_width() {
+  return SIMDRIVERS_DISPLAY_WIDTH;
+}
+
+// The simulated player only presses buttons; it never touches the panel.
+void display_initTouch() {
+}
+
+int display_enableTouchInterrupts(display_touchHandler_t handler) {
+  return DISPLAY_TOUCH_STATUS_FAIL;
+}
+
+uint8_t display_readTouchedPoints(display_touchPoint_t points[], uint8_t maxPoints) {
+  return 0;
+}
+
+bool display_isTouched(void) {
+  return false;
+}
+
+void display_clearOldTouchData() {
+}
+
+//**************************** intervalTimer.h ********************************
+
+// Each interval timer accumulates virtual time while it is running. These are
+// thread-local so that the Monte Carlo simulator can run a station per thread.
+static __thread bool timerRunning[SIMDRIVERS_NUMBER_OF_TIMERS];
+static __thread uint64_t timerStart[SIMDRIVERS_NUMBER_OF_TIMERS];
+static __thread uint64_t timerTotal[SIMDRIVERS_NUMBER_OF_TIMERS];
+
+uint32_t intervalTimer_start(uint32_t timerNumber) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  if (!timerRunning[timerNumber]) {
+    timerRunning[timerNumber] = true;
+    timerStart[timerNumber] = virtualClock_now();
+  }
+  return 0;
+}
+
+uint32_t intervalTimer_stop(uint32_t timerNumber) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  if (timerRunning[timerNumber]) {
+    timerRunning[timerNumber] = false;
+    timerTotal[timerNumber] += virtualClock_now() - timerStart[timerNumber];
+  }
+  return 0;
+}
+
+uint32_t intervalTimer_reset(uint32_t timerNumber) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  timerTotal[timerNumber] = 0;
+  timerStart[timerNumber] = virtualClock_now();
+  return 0;
+}
+
+uint32_t intervalTimer_init(uint32_t timerNumber) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  timerRunning[timerNumber] = false;
+  return intervalTimer_reset(timerNumber);
+}
+
+uint32_t intervalTimer_initAll() {
+  uint32_t status = 0;
+  int i;
+  for (i = 0; i < SIMDRIVERS_NUMBER_OF_TIMERS; i++) {
+    status |= intervalTimer_init(i);
+  }
+  return status;
+}
+
+uint32_t intervalTimer_resetAll() {
+  uint32_t status = 0;
+  int i;
+  for (i = 0; i < SIMDRIVERS_NUMBER_OF_TIMERS; i++) {
+    status |= intervalTimer_reset(i);
+  }
+  return status;
+}
+
+uint32_t intervalTimer_getTotalDurationInSeconds(uint32_t timerNumber,
+                                                 double *seconds) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  uint64_t total = timerTotal[timerNumber];
+  if (timerRunning[timerNumber]) {
+    total += virtualClock_now() - timerStart[timerNumber];
+  }
+  *seconds = (double) total / GLOBAL_TIMER_TICKS_PER_SECOND;
+  return 0;
+}
+
+uint32_t intervalTimer_getTotalDurationInMicroseconds(uint32_t timerNumber,
+                                                      uint64_t *microseconds) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  uint64_t total = timerTotal[timerNumber];
+  if (timerRunning[timerNumber]) {
+    total += virtualClock_now() - timerStart[timerNumber];
+  }
+  *microseconds = total / (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000);
+  return 0;
+}
+
+// The fast path shares the virtual timers above; a handle only remembers
+// which one it stands for.
+uint32_t intervalTimer_getHandle(uint32_t timerNumber, intervalTimer_Handle* handle) {
+  if (timerNumber >= SIMDRIVERS_NUMBER_OF_TIMERS) {
+    return INTERVALTIMER_TIMER_ERROR;
+  }
+  handle->registers = NULL;
+  handle->tcsr0 = INTERVALTIMER_ENABLE_CASC_MASK;
+  handle->timerNumber = timerNumber;
+  handle->frequency = GLOBAL_TIMER_TICKS_PER_SECOND;
+  handle->wrapMicroseconds = (uint32_t) ((1ULL << INTERVALTIMER_REGISTER_WIDTH) /
+                                         (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000));
+  return intervalTimer_init(timerNumber);
+}
+
+void intervalTimer_fastStart(intervalTimer_Handle* handle) {
+  handle->tcsr0 |= INTERVALTIMER_ENABLE_ENT0_MASK;
+  intervalTimer_start(handle->timerNumber);
+}
+
+void intervalTimer_fastStop(intervalTimer_Handle* handle) {
+  handle->tcsr0 &= INTERVALTIMER_CLEAR_ENT0_MASK;
+  intervalTimer_stop(handle->timerNumber);
+}
+
+void intervalTimer_fastReset(intervalTimer_Handle* handle) {
+  intervalTimer_reset(handle->timerNumber);
+}
+
+uint64_t intervalTimer_fastRead(const intervalTimer_Handle* handle) {
+  uint64_t total = timerTotal[handle->timerNumber];
+  if (timerRunning[handle->timerNumber]) {
+    total += virtualClock_now() - timerStart[handle->timerNumber];
+  }
+  return total;
+}
+
+// The virtual timers have no 32-bit half, so the bound only picks the path
+// that the board would take.
+uint64_t intervalTimer_fastElapsed(const intervalTimer_Handle* handle,
+                                   uint64_t start,
+                                   uint32_t boundMicroseconds) {
+  uint64_t now = intervalTimer_fastRead(handle);
+  if (boundMicroseconds < handle->wrapMicroseconds) {
+    return (uint32_t) ((uint32_t) now - (uint32_t) start);
+  }
+  return now - start;
+}
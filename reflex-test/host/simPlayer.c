@@ -0,0 +1,114 @@
+//*****************************************************************************
+// Simulated player for the host simulation build.
+//*****************************************************************************
+
+#include "simPlayer.h"
+#include "virtualClock.h"
+#include "buttons.h"
+#include "globalTimer.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef SIM_SEED
+#define SIM_SEED 1
+#endif
+
+#define SIMPLAYER_HOLD_SECONDS       5.5    // long enough to start a game
+#define SIMPLAYER_IDLE_SECONDS       8.0    // no LED for this long: game over
+#define SIMPLAYER_PRESS_SECONDS      0.1    // how long a button is pressed
+#define SIMPLAYER_MIN_REACTION_MS    150
+#define SIMPLAYER_MAX_REACTION_MS    450
+#define SIMPLAYER_MISS_PERCENT       2      // LEDs the player doesn't notice
+
+#define SECONDS_TO_TICKS(s) ((uint64_t) ((s) * GLOBAL_TIMER_TICKS_PER_SECOND))
+
+static unsigned int seed;
+static int32_t litLed;           // the LED value the player last saw
+static int32_t heldButtons;      // the buttons held down right now
+static uint64_t releaseTime;     // when heldButtons will be released
+static int32_t plannedButtons;   // buttons that will be pressed at pressTime
+static uint64_t pressTime;
+static uint64_t lastActivity;    // last LED flash or button release
+
+// Counters for the report.
+static uint32_t gamesStarted;
+static uint32_t ledsSeen;
+static uint32_t ledsMissed;
+static uint32_t buttonsPressed;
+static struct timespec wallStart;
+
+/**
+ * Prints what the player did and how fast the simulation ran.
+ */
+static void simPlayer_printReport(void) {
+  struct timespec wallEnd;
+  clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+  double wallSeconds = (wallEnd.tv_sec - wallStart.tv_sec) +
+                       ((wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9);
+  double simSeconds = virtualClock_seconds();
+
+  printf("simulated time:   %.0f s\n\r", simSeconds);
+  printf("wall-clock time:  %.2f s (%.0fx real time)\n\r", wallSeconds,
+         simSeconds / wallSeconds);
+  printf("games started:    %lu\n\r", (unsigned long) gamesStarted);
+  printf("LEDs seen:        %lu (%lu missed)\n\r", (unsigned long) ledsSeen,
+         (unsigned long) ledsMissed);
+  printf("buttons pressed:  %lu\n\r", (unsigned long) buttonsPressed);
+}
+
+void simPlayer_init() {
+  seed = SIM_SEED;
+  litLed = 0;
+  heldButtons = 0;
+  plannedButtons = 0;
+  lastActivity = virtualClock_now();
+  gamesStarted = ledsSeen = ledsMissed = buttonsPressed = 0;
+  clock_gettime(CLOCK_MONOTONIC, &wallStart);
+  atexit(simPlayer_printReport);
+}
+
+void simPlayer_ledsWritten(int32_t ledValue) {
+  uint64_t now = virtualClock_now();
+  if (ledValue == litLed) {
+    return;  // The LEDs are rewritten every tick in some states.
+  }
+  litLed = ledValue;
+  if (ledValue == 0) {
+    return;
+  }
+  ledsSeen++;
+  lastActivity = now;
+  if ((rand_r(&seed) % 100) < SIMPLAYER_MISS_PERCENT) {
+    ledsMissed++;
+    return;
+  }
+  // The LEDs and buttons line up, so press the button with the LED's value.
+  uint32_t reactionMs = SIMPLAYER_MIN_REACTION_MS +
+      (rand_r(&seed) % (SIMPLAYER_MAX_REACTION_MS - SIMPLAYER_MIN_REACTION_MS));
+  plannedButtons = ledValue;
+  pressTime = now + SECONDS_TO_TICKS(reactionMs / 1000.0);
+}
+
+int32_t simPlayer_readButtons() {
+  uint64_t now = virtualClock_now();
+  if (plannedButtons != 0 && now >= pressTime) {
+    heldButtons = plannedButtons;
+    plannedButtons = 0;
+    releaseTime = now + SECONDS_TO_TICKS(SIMPLAYER_PRESS_SECONDS);
+    buttonsPressed++;
+  }
+  if (heldButtons != 0 && now >= releaseTime) {
+    heldButtons = 0;
+    lastActivity = now;
+  }
+  // Nothing has happened for a while, so the game is waiting for a new player.
+  if (heldButtons == 0 && plannedButtons == 0 &&
+      now - lastActivity >= SECONDS_TO_TICKS(SIMPLAYER_IDLE_SECONDS)) {
+    heldButtons = BUTTONS_BTN0_MASK;
+    releaseTime = now + SECONDS_TO_TICKS(SIMPLAYER_HOLD_SECONDS);
+    gamesStarted++;
+  }
+  return heldButtons;
+}
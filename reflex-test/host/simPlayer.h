@@ -0,0 +1,22 @@
+//*****************************************************************************
+// Simulated player for the host simulation build.
+// The player holds a button to start a game, then presses the button under
+// each LED that lights up after a random reaction time. Everything is timed
+// with the virtual clock.
+//*****************************************************************************
+
+#ifndef SIMPLAYER_H_
+#define SIMPLAYER_H_
+
+#include <stdint.h>
+
+// Resets the player and prints a report when the program exits.
+void simPlayer_init();
+
+// Tells the player which LEDs were just written (see leds_write()).
+void simPlayer_ledsWritten(int32_t ledValue);
+
+// Returns the buttons the player is holding down at the current virtual time.
+int32_t simPlayer_readButtons();
+
+#endif /* SIMPLAYER_H_ */
@@ -0,0 +1,121 @@
+//*****************************************************************************
+// Turns the "trace" lines printed by Trace_Drain() into a readable timeline.
+//
+// Each line holds one 16 byte Trace_Entry in hex, as it sat in the board's
+// little-endian memory. Other lines (the rest of the UART output) are
+// skipped, and gaps in the sequence numbers are reported as dropped entries.
+// After the timeline, the time spent in each state is summed up.
+//
+// Usage: traceDecoder [file]   (reads standard input without a file)
+//*****************************************************************************
+
+#include "ReflexTestData.h"
+#include "Trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACEDECODER_LINE_LENGTH 256
+#define TRACEDECODER_PREFIX "trace "
+
+typedef struct {
+  uint64_t timestamp;
+  uint32_t sequence;
+  uint8_t from;
+  uint8_t to;
+  uint8_t actions;
+} traceDecoder_entry;
+
+static uint64_t little(const uint8_t* bytes, int size) {
+  uint64_t value = 0;
+  int i;
+  for (i = size - 1; i >= 0; i--) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
+
+/**
+ * Decodes one "trace" line. Returns false if it is not a valid entry.
+ */
+static bool traceDecoder_parse(const char* hex, traceDecoder_entry* entry) {
+  uint8_t bytes[sizeof(Trace_Entry)];
+  size_t i;
+  for (i = 0; i < sizeof(bytes); i++) {
+    unsigned int byte;
+    if (sscanf(&hex[2 * i], "%2x", &byte) != 1) {
+      return false;
+    }
+    bytes[i] = (uint8_t) byte;
+  }
+  entry->timestamp = little(&bytes[0], 8);
+  entry->sequence = (uint32_t) little(&bytes[8], 4);
+  entry->from = bytes[12];
+  entry->to = bytes[13];
+  entry->actions = bytes[14];
+  return entry->from < REFLEXTESTDATA_NUMBER_OF_STATES && entry->to < REFLEXTESTDATA_NUMBER_OF_STATES;
+}
+
+int main(int argc, char* argv[]) {
+  FILE* input = stdin;
+  char line[TRACEDECODER_LINE_LENGTH];
+  traceDecoder_entry entry;
+  traceDecoder_entry previous = { 0 };
+  bool havePrevious = false;
+  uint64_t entries = 0;
+  uint64_t dropped = 0;
+  uint64_t dwell[REFLEXTESTDATA_NUMBER_OF_STATES] = { 0 };
+  uint32_t visits[REFLEXTESTDATA_NUMBER_OF_STATES] = { 0 };
+  int state;
+
+  if (argc > 1 && (input = fopen(argv[1], "r")) == NULL) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  printf("%14s %12s  %-48s %s\n", "time (s)", "+ms", "transition", "actions");
+  while (fgets(line, sizeof(line), input) != NULL) {
+    const char* hex = strstr(line, TRACEDECODER_PREFIX);
+    if (hex == NULL || !traceDecoder_parse(hex + strlen(TRACEDECODER_PREFIX), &entry)) {
+      continue;
+    }
+    entries++;
+    double sincePrevious = 0;
+    if (havePrevious) {
+      if (entry.sequence != previous.sequence + 1) {
+        uint32_t gap = entry.sequence - previous.sequence - 1;
+        dropped += gap;
+        printf("%14s %12s  ... %lu entries dropped ...\n", "", "", (unsigned long) gap);
+      }
+      else if (entry.from == previous.to) {
+        // Only time a state when both of its ends are in the trace.
+        dwell[entry.from] += entry.timestamp - previous.timestamp;
+        visits[entry.from]++;
+      }
+      sincePrevious = (entry.timestamp - previous.timestamp) / 1000.0;
+    }
+
+    char transition[64];
+    snprintf(transition, sizeof(transition), "%s -> %s", ReflexTestData_GetStateName(entry.from),
+             ReflexTestData_GetStateName(entry.to));
+    printf("%14.6f %12.3f  %-48s %c%c%c%c\n", entry.timestamp / 1e6, sincePrevious, transition,
+           (entry.actions & TRACE_BUTTON_ACTION) ? 'B' : '-',
+           (entry.actions & TRACE_TIMER_ACTION) ? 'T' : '-',
+           (entry.actions & TRACE_LED_ACTION) ? 'L' : '-',
+           (entry.actions & TRACE_LCD_ACTION) ? 'D' : '-');
+    previous = entry;
+    havePrevious = true;
+  }
+
+  printf("\n%lu entries, %lu dropped\n", (unsigned long) entries, (unsigned long) dropped);
+  printf("%-24s %8s %14s\n", "state", "visits", "ms per visit");
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    if (visits[state] != 0) {
+      printf("%-24s %8lu %14.3f\n", ReflexTestData_GetStateName(state),
+             (unsigned long) visits[state], dwell[state] / 1000.0 / visits[state]);
+    }
+  }
+  if (input != stdin) {
+    fclose(input);
+  }
+  return 0;
+}
@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Host stand-ins for the timing support code, driven by the virtual clock.
+// The private timer "interrupt" fires inside events_wait(): instead of
+// sleeping until the next tick, events_wait() jumps the virtual clock to it.
+//*****************************************************************************
+
+#include "virtualClock.h"
+#include "simPlayer.h"
+#include "events.h"
+#include "globalTimer.h"
+#include "interrupts.h"
+#include "xparameters.h"
+#include <stdbool.h>
+
+// The private timer clock is 1/2 the processor frequency, as on the ZYBO board.
+#define ZYBO_BUS_CLOCK (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+#define PRIVATE_TIMER_LOAD_VALUE_DEFAULT 3249  // Provides a 10 us interrupt period.
+
+volatile int interrupts_isrFlagGlobal = 0;
+
+static uint64_t now = 0;
+static uint64_t nextTick = 0;
+static u32 isrInvocationCount = 0;
+static u32 privateTimerLoadValue = PRIVATE_TIMER_LOAD_VALUE_DEFAULT;
+static bool timerRunning = false;
+static bool timerIntsEnabled = false;
+static bool armIntsEnabled = false;
+static uint32_t pendingEvents = EVENTS_NONE;
+
+//***************************** virtualClock.h *********************************
+
+uint64_t virtualClock_now() {
+  return now;
+}
+
+void virtualClock_advanceTo(uint64_t ticks) {
+  if (ticks > now) {
+    now = ticks;
+  }
+}
+
+double virtualClock_seconds() {
+  return (double) now / GLOBAL_TIMER_TICKS_PER_SECOND;
+}
+
+//***************************** globalTimer.h **********************************
+
+u64 globalTimer_getTimerValue(void) {
+  return now;
+}
+
+void globalTimer_startTimer(bool printStatusFlag) {
+}
+
+void globalTimer_stopTimer(bool printStatusFlag) {
+}
+
+u32 globalTimer_test(bool printStatusFlag) {
+  return 0;
+}
+
+//******************************* events.h *************************************
+
+void events_init() {
+  pendingEvents = EVENTS_NONE;
+}
+
+void events_post(uint32_t events) {
+  pendingEvents |= events;
+}
+
+uint32_t events_wait() {
+  uint32_t events;
+  // Nothing else can post an event, so "sleep" until the next timer tick.
+  if (pendingEvents == EVENTS_NONE && timerRunning) {
+    virtualClock_advanceTo(nextTick);
+    nextTick += privateTimerLoadValue + 1;
+    if (timerIntsEnabled && armIntsEnabled) {
+      // Stands in for timerIsr() in interrupts.c.
+      isrInvocationCount++;
+      interrupts_isrFlagGlobal = 1;
+      pendingEvents |= EVENTS_TIMER_TICK;
+    }
+  }
+  events = pendingEvents;
+  pendingEvents = EVENTS_NONE;
+  return events;
+}
+
+//***************************** interrupts.h ***********************************
+
+int interrupts_initAll(bool printFailedStatusFlag) {
+  simPlayer_init();
+  return 0;
+}
+
+int interrupts_enableArmInts() {
+  armIntsEnabled = true;
+  return 0;
+}
+
+int interrupts_disableArmInts() {
+  armIntsEnabled = false;
+  return 0;
+}
+
+int interrupts_enableTimerGlobalInts() {
+  timerIntsEnabled = true;
+  return 0;
+}
+
+int interrupts_disableTimerGlobalInts() {
+  timerIntsEnabled = false;
+  return 0;
+}
+
+int interrupts_startArmPrivateTimer() {
+  if (!timerRunning) {
+    timerRunning = true;
+    nextTick = now + privateTimerLoadValue + 1;
+  }
+  return 0;
+}
+
+int interrupts_stopArmPrivateTimer() {
+  timerRunning = false;
+  return 0;
+}
+
+void interrupts_setPrivateTimerLoadValue(u32 loadValue) {
+  privateTimerLoadValue = loadValue;
+  // Like the real private timer, loading it restarts the count.
+  if (timerRunning) {
+    nextTick = now + privateTimerLoadValue + 1;
+  }
+}
+
+u32 interrupts_isrInvocationCount() {
+  return isrInvocationCount;
+}
+
+u32 interrupts_getPrivateTimerTicksPerSecond() {
+  return ZYBO_BUS_CLOCK / (privateTimerLoadValue + 1);
+}
@@ -0,0 +1,22 @@
+//*****************************************************************************
+// Virtual clock for the host simulation build.
+// Time only moves when the simulation advances it, so the game runs as fast
+// as the host can execute it instead of in real time. Time is kept in global
+// timer ticks so that it can stand in for globalTimer_getTimerValue().
+//*****************************************************************************
+
+#ifndef VIRTUALCLOCK_H_
+#define VIRTUALCLOCK_H_
+
+#include <stdint.h>
+
+// Returns the current virtual time in global timer ticks.
+uint64_t virtualClock_now();
+
+// Moves the virtual time forward to the given tick. Earlier times are ignored.
+void virtualClock_advanceTo(uint64_t ticks);
+
+// Returns the current virtual time in seconds.
+double virtualClock_seconds();
+
+#endif /* VIRTUALCLOCK_H_ */
@@ -0,0 +1,128 @@
+//*****************************************************************************
+// A small work-stealing thread pool for the host tools.
+//*****************************************************************************
+
+#include "workPool.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// The tasks a thread has left are the range [top, bottom). The owner takes
+// from the bottom and thieves take from the top.
+typedef struct {
+  pthread_mutex_t lock;
+  uint32_t top;
+  uint32_t bottom;
+} workPool_deque;
+
+typedef struct {
+  workPool_deque* deques;
+  uint32_t numberOfThreads;
+  workPool_task task;
+  void* arg;
+  uint32_t steals;
+  pthread_mutex_t stealsLock;
+} workPool_pool;
+
+typedef struct {
+  workPool_pool* pool;
+  uint32_t thread;
+} workPool_worker;
+
+// Takes a task from the bottom of the thread's own deque.
+static bool workPool_pop(workPool_deque* deque, uint32_t* taskNumber) {
+  bool found = false;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->top < deque->bottom) {
+    *taskNumber = --deque->bottom;
+    found = true;
+  }
+  pthread_mutex_unlock(&deque->lock);
+  return found;
+}
+
+// Takes a task from the top of another thread's deque.
+static bool workPool_steal(workPool_deque* deque, uint32_t* taskNumber) {
+  bool found = false;
+  pthread_mutex_lock(&deque->lock);
+  if (deque->top < deque->bottom) {
+    *taskNumber = deque->top++;
+    found = true;
+  }
+  pthread_mutex_unlock(&deque->lock);
+  return found;
+}
+
+static void* workPool_workerMain(void* workerArg) {
+  workPool_worker* worker = workerArg;
+  workPool_pool* pool = worker->pool;
+  unsigned int seed = worker->thread + 1;
+  uint32_t taskNumber;
+
+  while (true) {
+    if (workPool_pop(&pool->deques[worker->thread], &taskNumber)) {
+      pool->task(taskNumber, pool->arg);
+      continue;
+    }
+    // Out of work: try every other thread, starting at a random one. Tasks
+    // are never added, so if nobody has any left we are done.
+    uint32_t start = rand_r(&seed) % pool->numberOfThreads;
+    bool stole = false;
+    uint32_t i;
+    for (i = 0; i < pool->numberOfThreads && !stole; i++) {
+      uint32_t victim = (start + i) % pool->numberOfThreads;
+      if (victim != worker->thread &&
+          workPool_steal(&pool->deques[victim], &taskNumber)) {
+        stole = true;
+      }
+    }
+    if (!stole) {
+      break;
+    }
+    pthread_mutex_lock(&pool->stealsLock);
+    pool->steals++;
+    pthread_mutex_unlock(&pool->stealsLock);
+    pool->task(taskNumber, pool->arg);
+  }
+  return NULL;
+}
+
+uint32_t workPool_run(uint32_t numberOfThreads, uint32_t numberOfTasks,
+                      workPool_task task, void* arg) {
+  workPool_pool pool;
+  pthread_t* threads = calloc(numberOfThreads, sizeof(pthread_t));
+  workPool_worker* workers = calloc(numberOfThreads, sizeof(workPool_worker));
+  uint32_t i;
+
+  pool.deques = calloc(numberOfThreads, sizeof(workPool_deque));
+  pool.numberOfThreads = numberOfThreads;
+  pool.task = task;
+  pool.arg = arg;
+  pool.steals = 0;
+  pthread_mutex_init(&pool.stealsLock, NULL);
+
+  // Deal out an even, contiguous share of the tasks to each thread.
+  for (i = 0; i < numberOfThreads; i++) {
+    pthread_mutex_init(&pool.deques[i].lock, NULL);
+    pool.deques[i].top = (uint64_t) numberOfTasks * i / numberOfThreads;
+    pool.deques[i].bottom = (uint64_t) numberOfTasks * (i + 1) / numberOfThreads;
+  }
+
+  for (i = 0; i < numberOfThreads; i++) {
+    workers[i].pool = &pool;
+    workers[i].thread = i;
+    pthread_create(&threads[i], NULL, workPool_workerMain, &workers[i]);
+  }
+  for (i = 0; i < numberOfThreads; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  for (i = 0; i < numberOfThreads; i++) {
+    pthread_mutex_destroy(&pool.deques[i].lock);
+  }
+  pthread_mutex_destroy(&pool.stealsLock);
+  free(pool.deques);
+  free(workers);
+  free(threads);
+  return pool.steals;
+}
@@ -0,0 +1,22 @@
+//*****************************************************************************
+// A small work-stealing thread pool for the host tools.
+// Tasks are numbered 0 to numberOfTasks-1. Each thread starts with an even,
+// contiguous share of the tasks in its own deque and takes work from the
+// bottom of it. A thread that runs out steals from the top of another
+// thread's deque, so uneven tasks still keep every core busy.
+//*****************************************************************************
+
+#ifndef WORKPOOL_H_
+#define WORKPOOL_H_
+
+#include <stdint.h>
+
+// Called once for every task, from whichever thread ended up running it.
+typedef void (*workPool_task)(uint32_t taskNumber, void* arg);
+
+// Runs every task on numberOfThreads threads and returns once all are done.
+// Returns the number of tasks that were stolen.
+uint32_t workPool_run(uint32_t numberOfThreads, uint32_t numberOfTasks,
+                      workPool_task task, void* arg);
+
+#endif /* WORKPOOL_H_ */
@@ -5,50 +5,95 @@
 #include <stdint.h>
 #include <stdio.h>
 
-void ButtonConductor_Init() {
-  ButtonModel_Init();
-  ButtonHardware_Init();
-}
-
-void ButtonConductor_Run() {
-
-  int32_t pressedButton = 0;
-
-  // state actions
-  switch (ButtonModel_GetCurrentState()) {
-    case init_st:
-      break;
-    case show_info_st:
-      break;
-    case wait_info_st:
-      // Poll the buttons in this state.
-      pressedButton = ButtonHardware_Read();
-      ButtonModel_SetPressedButton(pressedButton);
-      break;
-    case wait_five_seconds_st:
-      // Poll the buttons in this state.
-      pressedButton = ButtonHardware_Read();
-      ButtonModel_SetPressedButton(pressedButton);
-      break;
-    case blank_screen_st:
-      break;
-    case wait_between_flash_st:
-      break;
-    case blink_led_st:
-      break;
-    case wait_for_button_st:
-      // Poll the buttons in this state.
-      pressedButton = ButtonHardware_Read();
-      ButtonModel_SetPressedButton(pressedButton);
-      break;
-    case button_pressed_st:
-      break;
-    case show_stats_st:
-      break;
-    case wait_stats_st:
-      break;
-    case update_scores_st:
-      break;
+/**
+ * Poll the buttons and pass the one that went down first on to the model,
+ * along with when the press happened if it is new.
+ */
+static void ButtonConductor_ReadButtons(ReflexTest_Context* context, ButtonHardware_Press* press) {
+  ButtonHardware_Read(&context->debounce, &context->lastTouchPoll, press);
+  ButtonModel_SetPressedButton(context, press->button);
+  if (press->count != 0) {
+    ButtonModel_SetPressTime(context, press->time);
   }
+}
+
+/**
+ * Poll the buttons while nothing but a press matters.
+ */
+static void ButtonConductor_PollButtons(ReflexTest_Context* context) {
+  ButtonHardware_Press press;
+  ButtonConductor_ReadButtons(context, &press);
+}
+
+/**
+ * Poll the buttons while waiting for the response, and have the model
+ * score presses of the wrong button.
+ */
+static void ButtonConductor_PollResponse(ReflexTest_Context* context) {
+  ButtonHardware_Press press;
+  ButtonConductor_ReadButtons(context, &press);
+  if (press.count != 0) {
+    ButtonModel_CheckResponse(context, press.time, press.count);
+  }
+}
+
+/**
+ * Keep reading the buttons while waiting for the next LED. A press now is a
+ * guess, and the response to the next LED will not count. Ticks are skipped
+ * in this state, but the GPIO interrupt timestamps the edges in between.
+ */
+static void ButtonConductor_WatchForEarlyPresses(ReflexTest_Context* context) {
+  ButtonHardware_Press press;
+  ButtonHardware_Read(&context->debounce, &context->lastTouchPoll, &press);
+  if (press.count != 0) {
+    ButtonModel_SetAnticipated(context);
+  }
+}
+
+/**
+ * Forget presses made before the LED goes on, so that they are not taken
+ * for the response. If there were any, or a button is still held down, the
+ * player went early.
+ */
+static void ButtonConductor_DiscardEarlyPresses(ReflexTest_Context* context) {
+  if (ButtonHardware_DiscardEdges(&context->debounce, &context->lastTouchPoll) != 0) {
+    ButtonModel_SetAnticipated(context);
+  }
+}
+
+void ButtonConductor_DrainEdges(ReflexTest_Context* context) {
+  ButtonHardware_DrainEdges(&context->debounce, &context->lastTouchPoll);
+}
+
+// state actions. States that do not read the buttons still drain the edges,
+// so that the GPIO interrupt's queue never fills up.
+static const ReflexTest_Action ButtonConductor_Actions[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [init_st]               = ButtonConductor_DrainEdges,
+  [show_info_st]          = ButtonConductor_DrainEdges,
+  [wait_info_st]          = ButtonConductor_PollButtons,
+  [wait_five_seconds_st]  = ButtonConductor_PollButtons,
+  [blank_screen_st]       = ButtonConductor_DrainEdges,
+  [blink_led_st]          = ButtonConductor_DiscardEarlyPresses,
+  [wait_for_button_st]    = ButtonConductor_PollResponse,
+  [button_pressed_st]     = ButtonConductor_DrainEdges,
+  [wait_between_flash_st] = ButtonConductor_WatchForEarlyPresses,
+  [show_stats_st]         = ButtonConductor_DrainEdges,
+  [wait_stats_st]         = ButtonConductor_DrainEdges,
+  [update_scores_st]      = ButtonConductor_DrainEdges,
+};
 
+void ButtonConductor_Init(ReflexTest_Context* context) {
+  ButtonModel_Init(context);
+  ButtonHardware_Init(&context->debounce, &context->lastTouchPoll);
+}
+
+ReflexTest_Action ButtonConductor_GetAction(ReflexTest_st state) {
+  return ButtonConductor_Actions[state];
+}
+
+void ButtonConductor_Run(ReflexTest_Context* context) {
+  ReflexTest_Action action = ButtonConductor_GetAction(ButtonModel_GetCurrentState(context));
+  if (action != NULL) {
+    action(context);
+  }
 }
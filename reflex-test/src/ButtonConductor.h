@@ -1,16 +1,35 @@
 #ifndef _ButtonConductor_H
 #define _ButtonConductor_H
 
+#include "ReflexTestData.h"
+
 /**
  * ButtonConductor_Init should call the ButtonModel
  * and ButtonHardware Init functions.
+ * @param context The game to work on.
+ */
+void ButtonConductor_Init(ReflexTest_Context* context);
+
+/**
+ * Returns the button action for the given state.
+ * @param  state The state to look up.
+ * @return       The action to perform, or NULL if there is nothing to do.
+ */
+ReflexTest_Action ButtonConductor_GetAction(ReflexTest_st state);
+
+/**
+ * Feeds the button edges and touches queued since the last read into the
+ * debouncer. This is the action of every state that does not read the
+ * buttons, and Executor_Run calls it on the ticks it skips.
+ * @param context The game to work on.
  */
-void ButtonConductor_Init(void);
+void ButtonConductor_DrainEdges(ReflexTest_Context* context);
 
 /**
  * Called by ReflexTest_tick_function in the executor
  * Drives all button actions.
+ * @param context The game to work on.
  */
-void ButtonConductor_Run(void);
+void ButtonConductor_Run(ReflexTest_Context* context);
 
 #endif //_ButtonConductor_H
@@ -1,14 +1,181 @@
 #include "ButtonHardware.h"
+#include "TouchHardware.h"
 #include "buttons.h"
+#include "InputLog.h"
+#include "SpscQueue.h"
+#include "Debounce.h"
 #include "intervalTimer.h"
+#include "../vendor/supportFiles/globalTimer.h"
 #include <stdio.h>
 
-void ButtonHardware_Init(void) {
+// Number of global timer ticks in one microsecond.
+#define BUTTONHARDWARE_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+
+// The value passed through the input log packs the buttons in the low
+// byte, the first button above them, and the number of presses above that.
+// The first button is left out when it is the lowest of the buttons, so a
+// button held on its own still logs as a single byte. Replay reads a
+// timestamp too when the count is not 0.
+#define BUTTONHARDWARE_BUTTON_BITS  0xFF
+#define BUTTONHARDWARE_FIRST_SHIFT  8
+#define BUTTONHARDWARE_COUNT_SHIFT  16
+#define BUTTONHARDWARE_MAX_COUNT    0xFF
+
+// Edges captured by the GPIO interrupt, waiting for ButtonHardware_Read().
+static ButtonHardware_Edge edgeBuffer[BUTTONHARDWARE_EDGE_CAPACITY];
+static SpscQueue edges;
+
+// Edges the GPIO interrupt found no room for. Only the interrupt writes it.
+static volatile uint32_t droppedEdges;
+
+/**
+ * Runs in the GPIO interrupt on every edge: stamps it and queues it. The
+ * timestamp is the raw global timer, so the handler does no division.
+ */
+static void ButtonHardware_CaptureEdge(void) {
+  ButtonHardware_Edge edge;
+  edge.timestamp = globalTimer_getTimerValue();
+  edge.buttons = buttons_read();
+  if (!SpscQueue_Push(&edges, &edge)) {
+    droppedEdges++;
+  }
+}
+
+/**
+ * Helper function that reports the targets as the buttons they stand for.
+ */
+static int32_t ButtonHardware_FoldTargets(int32_t inputs) {
+  return (inputs | (inputs >> BUTTONHARDWARE_TOUCH_SHIFT)) & BUTTONHARDWARE_BUTTONS_MASK;
+}
+
+/**
+ * Helper function that feeds one change of the buttons or of the targets
+ * into the debouncer, keeping the raw level of the others.
+ */
+static void ButtonHardware_Sample(Debounce* debounce, int32_t inputs, int32_t mask, uint64_t now) {
+  int32_t raw = (Debounce_GetRaw(debounce) & ~mask) | (inputs & mask);
+  Debounce_Sample(debounce, raw, now);
+}
+
+/**
+ * Feeds the edges that the GPIO interrupt captured and the touches since
+ * the last read into the debouncer, merged by their timestamps.
+ */
+static void ButtonHardware_SampleEdges(Debounce* debounce, uint64_t* lastTouchPoll) {
+  TouchHardware_Event touches[TOUCHHARDWARE_MAX_EVENTS];
+  ButtonHardware_Edge edge;
+  int32_t touched = Debounce_GetRaw(debounce) >> BUTTONHARDWARE_TOUCH_SHIFT;
+  uint32_t count = TouchHardware_Read(lastTouchPoll, touched, touches);
+  uint32_t next = 0;
+
+  while (SpscQueue_Pop(&edges, &edge)) {
+    for (; next < count && touches[next].timestamp <= edge.timestamp; next++) {
+      ButtonHardware_Sample(debounce, touches[next].targets << BUTTONHARDWARE_TOUCH_SHIFT,
+                            ~BUTTONHARDWARE_BUTTONS_MASK, touches[next].timestamp);
+    }
+    ButtonHardware_Sample(debounce, edge.buttons, BUTTONHARDWARE_BUTTONS_MASK, edge.timestamp);
+  }
+  for (; next < count; next++) {
+    ButtonHardware_Sample(debounce, touches[next].targets << BUTTONHARDWARE_TOUCH_SHIFT,
+                          ~BUTTONHARDWARE_BUTTONS_MASK, touches[next].timestamp);
+  }
+}
+
+void ButtonHardware_Init(Debounce* debounce, uint64_t* lastTouchPoll) {
 
   buttons_init(); //sets the buttons as inputs
 
+  SpscQueue_Init(&edges, edgeBuffer, sizeof(ButtonHardware_Edge), BUTTONHARDWARE_EDGE_CAPACITY);
+  droppedEdges = 0;
+  Debounce_Init(debounce, (uint64_t) BUTTONHARDWARE_STABLE_WINDOW * BUTTONHARDWARE_TICKS_PER_MICROSECOND);
+  *lastTouchPoll = 0;
+  // Without the interrupt, the buttons are simply polled.
+  buttons_enableInterrupts(ButtonHardware_CaptureEdge);
+  TouchHardware_Init();
+}
+
+int32_t ButtonHardware_Read(Debounce* debounce, uint64_t* lastTouchPoll, ButtonHardware_Press* press) {
+  uint64_t firstPress = 0;
+
+  // The interrupts' edges and touches carry their own time, and the value
+  // now lets bursts that have gone quiet settle.
+  ButtonHardware_SampleEdges(debounce, lastTouchPoll);
+  int32_t raw = buttons_read();
+  ButtonHardware_Sample(debounce, raw, BUTTONHARDWARE_BUTTONS_MASK, globalTimer_getTimerValue());
+
+  // Buttons that went down since the last read count as pressed even if
+  // they are already up again, and the first of them is timestamped. With
+  // no new press, the first is whichever has been held down the longest.
+  uint32_t count = Debounce_GetPendingPresses(debounce);
+  int32_t pressedSinceLastRead = Debounce_TakePresses(debounce, &firstPress);
+  int32_t inputs = Debounce_GetButtons(debounce) | pressedSinceLastRead;
+  int32_t first = ButtonHardware_FoldTargets(Debounce_GetFirstButton(debounce,
+      (pressedSinceLastRead != 0) ? pressedSinceLastRead : inputs));
+  int32_t buttons = ButtonHardware_FoldTargets(inputs);
+  if (count > BUTTONHARDWARE_MAX_COUNT) {
+    count = BUTTONHARDWARE_MAX_COUNT;
+  }
+
+  if (first == (buttons & (~buttons + 1))) {
+    first = 0;
+  }
+
+  // Read the value of the buttons and return it, through the input log.
+  int32_t logged = InputLog_Buttons(buttons | (first << BUTTONHARDWARE_FIRST_SHIFT) |
+                                    (count << BUTTONHARDWARE_COUNT_SHIFT));
+  buttons = logged & BUTTONHARDWARE_BUTTON_BITS;
+  press->button = (logged >> BUTTONHARDWARE_FIRST_SHIFT) & BUTTONHARDWARE_BUTTON_BITS;
+  if (press->button == 0) {
+    press->button = buttons & (~buttons + 1);
+  }
+  press->count = (logged >> BUTTONHARDWARE_COUNT_SHIFT) & BUTTONHARDWARE_MAX_COUNT;
+  if (press->count != 0) {
+    press->time = InputLog_Timestamp(firstPress / BUTTONHARDWARE_TICKS_PER_MICROSECOND);
+  }
+  return buttons;
+}
+
+int32_t ButtonHardware_DiscardEdges(Debounce* debounce, uint64_t* lastTouchPoll) {
+  uint64_t firstPress;
+  // The edges still count towards the bounce statistics.
+  ButtonHardware_SampleEdges(debounce, lastTouchPoll);
+  int32_t raw = (buttons_read() & BUTTONHARDWARE_BUTTONS_MASK) |
+                (Debounce_GetRaw(debounce) & ~BUTTONHARDWARE_BUTTONS_MASK);
+  Debounce_Resync(debounce, raw, globalTimer_getTimerValue());
+  int32_t early = Debounce_TakePresses(debounce, &firstPress) | Debounce_GetButtons(debounce);
+  return InputLog_Buttons(ButtonHardware_FoldTargets(early));
+}
+
+void ButtonHardware_DrainEdges(Debounce* debounce, uint64_t* lastTouchPoll) {
+  ButtonHardware_SampleEdges(debounce, lastTouchPoll);
+}
+
+uint32_t ButtonHardware_GetDroppedEdges(void) {
+  return droppedEdges;
+}
+
+void ButtonHardware_SetStableWindow(Debounce* debounce, uint32_t button, uint32_t microseconds) {
+  Debounce_SetWindow(debounce, button, (uint64_t) microseconds * BUTTONHARDWARE_TICKS_PER_MICROSECOND);
 }
 
-int32_t ButtonHardware_Read() {
-  return buttons_read();  // Read the value of the buttons and return.
+void ButtonHardware_PrintBounceStats(const Debounce* debounce) {
+  uint32_t i;
+  printf("button  edges  glitches  bounces  mean bounce (us)  longest (us)\n\r");
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    if (i == BUTTONHARDWARE_NUMBER_OF_BUTTONS) {
+      printf("target\n\r");
+    }
+    const Debounce_Stats* stats = Debounce_GetStats(debounce, i);
+    uint32_t bursts = stats->edges + stats->glitches;
+    uint64_t mean = (bursts == 0) ? 0 : stats->totalBounceTime / bursts;
+    uint64_t longest = stats->longestBounceTime / BUTTONHARDWARE_TICKS_PER_MICROSECOND;
+    printf("%6lu %6lu %9lu %8lu %17lu %13lu%s\n\r",
+           (unsigned long) (i % BUTTONHARDWARE_NUMBER_OF_BUTTONS),
+           (unsigned long) stats->edges, (unsigned long) stats->glitches,
+           (unsigned long) stats->bounces,
+           (unsigned long) (mean / BUTTONHARDWARE_TICKS_PER_MICROSECOND),
+           (unsigned long) longest,
+           (longest >= BUTTONHARDWARE_WORN_BOUNCE_TIME) ? "  worn?" : "");
+  }
+  printf("edges dropped with the queue full: %lu\n\r", (unsigned long) droppedEdges);
 }
@@ -2,24 +2,126 @@
 #define _ButtonHardware_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "Debounce.h"
+
+// The push buttons are the lowest bits of the debouncer. The on-screen
+// targets are debounced as the same number of buttons above them, and a
+// touch is reported as a press of the button its target stands for.
+#define BUTTONHARDWARE_NUMBER_OF_BUTTONS 4
+#define BUTTONHARDWARE_BUTTONS_MASK ((1 << BUTTONHARDWARE_NUMBER_OF_BUTTONS) - 1)
+#define BUTTONHARDWARE_TOUCH_SHIFT BUTTONHARDWARE_NUMBER_OF_BUTTONS
+
+// Number of button edges the GPIO interrupt can queue between two reads.
+// A bouncing contact makes several edges per press.
+#define BUTTONHARDWARE_EDGE_CAPACITY 64
+
+// How long a button must hold still before a press or release counts, in us.
+#define BUTTONHARDWARE_STABLE_WINDOW 5000
+
+// A button whose longest bounce reaches this many us is reported as worn.
+#define BUTTONHARDWARE_WORN_BOUNCE_TIME (BUTTONHARDWARE_STABLE_WINDOW / 2)
+
 
 /**
- * Calls buttons_init to set the button GPIOs as inputs
+ * Which button came first, as seen by one ButtonHardware_Read().
  */
-void ButtonHardware_Init(void);
+typedef struct {
+  int32_t button;   // one bit for the button that went down first, or 0
+  uint64_t time;    // when it went down in us, if count is not 0
+  uint32_t count;   // presses since the last read, counting repeats
+} ButtonHardware_Press;
 
 /**
-* This reads the value of the GPIO of the buttons.
-* Each button corresponds with a bit in the lower 4 bits
-* of the GPIO register.
+ * One edge of the buttons, as captured by the GPIO interrupt.
+ */
+typedef struct {
+  uint64_t timestamp;   // global timer ticks when the interrupt ran
+  int32_t buttons;      // the value of the buttons right after the edge
+  uint32_t reserved;
+} ButtonHardware_Edge;
+
+/**
+ * Calls buttons_init to set the button GPIOs as inputs, and enables the GPIO
+ * interrupt that timestamps every edge. Starts the touchscreen too. Every
+ * button and target starts released, with a stable window of
+ * BUTTONHARDWARE_STABLE_WINDOW and no bounce statistics.
+ * @param debounce      The game's debouncer.
+ * @param lastTouchPoll The game's time of the last touch poll, see
+ *                      TouchHardware_Read. Starts at 0.
+ */
+void ButtonHardware_Init(Debounce* debounce, uint64_t* lastTouchPoll);
+
+/**
+ * This reads the debounced value of the buttons, feeding the edges that the
+ * interrupt captured, the touches on the screen's targets and the GPIO's
+ * value now into the debouncer, in the order they happened.
+ * Each button corresponds with a bit in the lower 4 bits
+ * of the GPIO register. Touching a target counts as pressing its button.
  * @return  The value of the buttons being read.
  *              BUTTONS_BTN0_MASK       0x1
  *              BUTTONS_BTN1_MASK       0x2
  *              BUTTONS_BTN2_MASK       0x4
  *              BUTTONS_BTN3_MASK       0x8
  *              If multiple buttons are pressed the total value is returned.
+ *              Buttons pressed since the last read are included even if
+ *              they have been released again.
+ * @param debounce      The game's debouncer. Its times are global timer ticks.
+ * @param lastTouchPoll The game's time of the last touch poll.
+ * @param press         Where to store which button came first. If any went
+ *                      down since the last read, that is the earliest of
+ *                      them, dated to the first edge of its bounce as stamped
+ *                      by the GPIO interrupt, or to the tick that first saw
+ *                      it if the interrupt is not available. Otherwise it is
+ *                      the button held down the longest, and count is 0.
+ */
+int32_t ButtonHardware_Read(Debounce* debounce, uint64_t* lastTouchPoll, ButtonHardware_Press* press);
+
+/**
+ * Throws away edges that have not been read yet, so that presses from before
+ * now cannot be taken for a response. The buttons may not have been read
+ * for a while, so the debounced level is set to the GPIO's value now.
+ * @param  debounce      The game's debouncer.
+ * @param  lastTouchPoll The game's time of the last touch poll.
+ * @return               The buttons that went down since the last read or
+ *                       are down now, through the input log. Anything but 0
+ *                       means the player pressed early.
+ */
+int32_t ButtonHardware_DiscardEdges(Debounce* debounce, uint64_t* lastTouchPoll);
+
+/**
+ * Feeds the edges and touches queued since the last read into the debouncer
+ * without reading the buttons, so that the GPIO interrupt's queue does not
+ * fill up while nothing reads them. Presses among them are kept for the
+ * next read.
+ * @param debounce      The game's debouncer.
+ * @param lastTouchPoll The game's time of the last touch poll.
+ */
+void ButtonHardware_DrainEdges(Debounce* debounce, uint64_t* lastTouchPoll);
+
+/**
+ * Returns how many edges the GPIO interrupt had to drop since
+ * ButtonHardware_Init() because the queue was full.
+ * @return The number of edges dropped.
+ */
+uint32_t ButtonHardware_GetDroppedEdges(void);
+
+/**
+ * Changes how long one button must hold still before it counts.
+ * @param debounce     The game's debouncer.
+ * @param button       The button, 0 to DEBOUNCE_NUMBER_OF_BUTTONS-1. The
+ *                     targets follow the buttons.
+ * @param microseconds The stable window in us. 0 turns debouncing off.
+ */
+void ButtonHardware_SetStableWindow(Debounce* debounce, uint32_t button, uint32_t microseconds);
+
+/**
+ * Prints each button's and target's bounce statistics, flagging the buttons whose
+ * longest bounce reached BUTTONHARDWARE_WORN_BOUNCE_TIME, and how many edges
+ * were dropped.
+ * @param debounce The game's debouncer.
  */
-int32_t ButtonHardware_Read(void);
+void ButtonHardware_PrintBounceStats(const Debounce* debounce);
 
 
 #endif //_ButtonHardware_H
@@ -1,13 +1,13 @@
 #include "ButtonModel.h"
 
-void ButtonModel_Init() {
+void ButtonModel_Init(ReflexTest_Context* context) {
 
 }
 
-void ButtonModel_SetPressedButton(int32_t value) {
+void ButtonModel_SetPressedButton(ReflexTest_Context* context, int32_t value) {
 
-  //defines precedence that users can't press multiple buttons simultaneously
-  //button0 has highest precedence, button3 has lowest
+  //ButtonHardware passes the button that went down first. Should several
+  //still come in, button0 has highest precedence, button3 has lowest
   value &= ~value + 1; //find the least significant set bit
 
   // Map button #s to corresponding LED #s
@@ -25,13 +25,32 @@ void ButtonModel_SetPressedButton(int32_t value) {
       value = 4;
       break;
   }
-  ReflexTestData_SetPressedButton(value);
+  ReflexTestData_SetPressedButton(context, value);
 }
 
-int32_t ButtonModel_GetPressedButton() {
-  return ReflexTestData_GetPressedButton();
+void ButtonModel_SetPressTime(ReflexTest_Context* context, uint64_t timestamp) {
+  ReflexTestData_SetPressTime(context, timestamp);
 }
 
-ReflexTest_st ButtonModel_GetCurrentState() {
-  return ReflexTestData_GetCurrentState();
+void ButtonModel_SetAnticipated(ReflexTest_Context* context) {
+  ReflexTestData_SetAnticipated(context, true);
+}
+
+void ButtonModel_CheckResponse(ReflexTest_Context* context, uint64_t timestamp, uint32_t count) {
+  if (ReflexTestData_IsCorrectButtonPressed(context)) {
+    return;
+  }
+  uint64_t stimulusTime = ReflexTestData_GetStimulusTime(context);
+  uint64_t latency = (timestamp > stimulusTime) ? timestamp - stimulusTime : 0;
+  ReflexTestData_RecordWrongPresses(context, count, (uint32_t) latency);
+  // Forget the wrong press, so that it does not time the right one.
+  ReflexTestData_SetPressTime(context, 0);
+}
+
+int32_t ButtonModel_GetPressedButton(ReflexTest_Context* context) {
+  return ReflexTestData_GetPressedButton(context);
+}
+
+ReflexTest_st ButtonModel_GetCurrentState(ReflexTest_Context* context) {
+  return ReflexTestData_GetCurrentState(context);
 }
@@ -11,27 +11,57 @@
 
 /**
  * Initialize ButtonModel variables in ReflexTestData if necessary.
+ * @param context The game to work on.
  */
-void ButtonModel_Init(void);
+void ButtonModel_Init(ReflexTest_Context* context);
 
 /**
- * This will take the value, determine the highest precedence
- * button pressed, and store it in ReflexTestData.
+ * This will take the value and store the button pressed in ReflexTestData.
+ * ButtonHardware already passes the button that went down first; if the
+ * value still has several buttons in it, the lowest one is taken.
+ * @param context The game to work on.
  * @param value number representing which button(s) was/were pressed
  */
-void ButtonModel_SetPressedButton(int32_t value);
+void ButtonModel_SetPressedButton(ReflexTest_Context* context, int32_t value);
+
+/**
+ * Stores when the button press happened, as stamped by the GPIO interrupt.
+ * @param context   The game to work on.
+ * @param timestamp The time of the press in microseconds.
+ */
+void ButtonModel_SetPressTime(ReflexTest_Context* context, uint64_t timestamp);
+
+/**
+ * Notes that a button went down before the LED went on, so that the
+ * response to it is a false start.
+ * @param context The game to work on.
+ */
+void ButtonModel_SetAnticipated(ReflexTest_Context* context);
+
+/**
+ * Scores a press made while waiting for the response. If the first button
+ * pressed was not the LED's, the presses are counted as wrong, along with
+ * how soon after the LED they came, and the response will be timed from
+ * the right button instead.
+ * @param context   The game to work on.
+ * @param timestamp When the first of the presses happened, in us.
+ * @param count     How many presses there were, counting repeats.
+ */
+void ButtonModel_CheckResponse(ReflexTest_Context* context, uint64_t timestamp, uint32_t count);
 
 /**
  * Whenever a timer is stopped in ButtonHardware, this function
  * will pass on the elapsed time to ReflexTestData.
- * @param time a value representing the elapsed time in seconds
+ * @param context The game to work on.
+ * @param time a value representing the elapsed time in microseconds
  */
-void ButtonModel_SetResponseTime(double time);
+void ButtonModel_SetResponseTime(ReflexTest_Context* context, uint32_t time);
 
 /**
  * Called by the Conductor to get the current state from ReflexTestData.
+ * @param  context The game to work on.
  * @return  returns the current state
  */
-ReflexTest_st ButtonModel_GetCurrentState(void);
+ReflexTest_st ButtonModel_GetCurrentState(ReflexTest_Context* context);
 
 #endif //BUTTONMODEL_H_
@@ -0,0 +1,99 @@
+#include "Calibration.h"
+#include "InputLog.h"
+#include "ReflexTestData.h"
+#include "intervalTimer.h"
+#include "leds.h"
+#include "../vendor/supportFiles/globalTimer.h"
+#include <stdio.h>
+
+// Converts global timer ticks to nanoseconds.
+#define CALIBRATION_TICKS_TO_NANOSECONDS(ticks) \
+  ((uint32_t) (((uint64_t) (ticks) * 1000000000) / GLOBAL_TIMER_TICKS_PER_SECOND))
+
+static Calibration_Constants constants;
+
+// TIMER0 on the fast path, for comparing it with the numbered functions.
+static intervalTimer_Handle timer;
+
+/**
+ * Returns the fastest time between two back-to-back timer reads, less the
+ * timestamp cost measured so far.
+ */
+static uint32_t Calibration_Measure(void (*operation)(void)) {
+  uint32_t fastest = UINT32_MAX;
+  int i;
+  for (i = 0; i < CALIBRATION_SAMPLES; i++) {
+    uint64_t start = globalTimer_getTimerValue();
+    operation();
+    uint64_t ticks = globalTimer_getTimerValue() - start;
+    if (ticks < fastest) {
+      fastest = (uint32_t) ticks;
+    }
+  }
+  return (fastest > constants.timestampTicks) ? fastest - constants.timestampTicks : 0;
+}
+
+static void Calibration_Nothing(void) {
+}
+
+static void Calibration_LedWrite(void) {
+  leds_write(0x0);
+}
+
+static void Calibration_TimerReset(void) {
+  intervalTimer_reset(INTERVALTIMER_TIMER0);
+}
+
+static void Calibration_TimerStart(void) {
+  intervalTimer_start(INTERVALTIMER_TIMER0);
+}
+
+static void Calibration_TimerRead(void) {
+  uint64_t microseconds;
+  intervalTimer_getTotalDurationInMicroseconds(INTERVALTIMER_TIMER0, &microseconds);
+}
+
+static void Calibration_FastStart(void) {
+  intervalTimer_fastStart(&timer);
+}
+
+static void Calibration_FastRead(void) {
+  intervalTimer_fastRead(&timer);
+}
+
+static void Calibration_FastElapsed(void) {
+  intervalTimer_fastElapsed(&timer, 0, REFLEXTESTDATA_SLOWEST_RESPONSE_TIME);
+}
+
+void Calibration_Run(void) {
+  constants.timestampTicks = 0;
+  constants.timestampTicks = Calibration_Measure(Calibration_Nothing);
+  constants.ledWriteTicks = Calibration_Measure(Calibration_LedWrite);
+  constants.timerResetTicks = Calibration_Measure(Calibration_TimerReset);
+  constants.timerStartTicks = Calibration_Measure(Calibration_TimerStart);
+  constants.timerReadTicks = Calibration_Measure(Calibration_TimerRead);
+  intervalTimer_getHandle(INTERVALTIMER_TIMER0, &timer);
+  constants.fastStartTicks = Calibration_Measure(Calibration_FastStart);
+  constants.fastReadTicks = Calibration_Measure(Calibration_FastRead);
+  constants.fastElapsedTicks = Calibration_Measure(Calibration_FastElapsed);
+  intervalTimer_fastReset(&timer);
+}
+
+const Calibration_Constants* Calibration_Get() {
+  return &constants;
+}
+
+uint32_t Calibration_GetStimulusOverhead() {
+  uint32_t ticks = constants.timestampTicks + constants.ledWriteTicks;
+  return InputLog_Calibration(CALIBRATION_TICKS_TO_NANOSECONDS(ticks));
+}
+
+void Calibration_Print() {
+  printf("calibration (global timer ticks): timestamp %lu, LED write %lu, "
+         "timer reset %lu, timer start %lu, timer read %lu, "
+         "fast start %lu, fast read %lu, fast elapsed %lu\n\r",
+         (unsigned long) constants.timestampTicks, (unsigned long) constants.ledWriteTicks,
+         (unsigned long) constants.timerResetTicks, (unsigned long) constants.timerStartTicks,
+         (unsigned long) constants.timerReadTicks, (unsigned long) constants.fastStartTicks,
+         (unsigned long) constants.fastReadTicks, (unsigned long) constants.fastElapsedTicks);
+}
@@ -0,0 +1,56 @@
+#ifndef CALIBRATION_H_
+#define CALIBRATION_H_
+
+#include <stdint.h>
+
+// The LED, the interval timer and the global timer are all reached through
+// memory-mapped registers, and each access takes time that ends up inside a
+// measured response. Calibration_Run() measures these fixed costs once at
+// startup with the global timer so that TimerModel can take them back out.
+// Each cost is the fastest of CALIBRATION_SAMPLES runs, less the cost of
+// reading the global timer itself. The interval timer is measured through
+// both the numbered functions and a fast-path handle, so the two can be
+// compared on the board.
+#define CALIBRATION_SAMPLES 16
+
+/**
+ * The measured costs, in global timer ticks.
+ */
+typedef struct {
+  uint32_t timestampTicks;   // reading the global timer
+  uint32_t ledWriteTicks;    // leds_write(), which turns the LED on
+  uint32_t timerResetTicks;  // intervalTimer_reset() on TIMER0
+  uint32_t timerStartTicks;  // intervalTimer_start() on TIMER0
+  uint32_t timerReadTicks;   // intervalTimer_getTotalDurationInMicroseconds() on TIMER0
+  uint32_t fastStartTicks;   // intervalTimer_fastStart() on TIMER0
+  uint32_t fastReadTicks;    // intervalTimer_fastRead() on TIMER0
+  uint32_t fastElapsedTicks; // intervalTimer_fastElapsed() over a response
+} Calibration_Constants;
+
+/**
+ * Measures the costs. Call once the LEDs and the timers are initialized;
+ * the LEDs are left off and TIMER0 is left running from 0.
+ */
+void Calibration_Run(void);
+
+/**
+ * Returns the costs measured by the last Calibration_Run().
+ * @return The calibration constants.
+ */
+const Calibration_Constants* Calibration_Get(void);
+
+/**
+ * Returns how long after the stimulus timestamp the LED is on: reading the
+ * timestamp, then writing the LED, see LedHardware_Stimulus. Responses are
+ * timed from that timestamp, so the interval timer's costs are measured for
+ * reference but never counted. Passes through the input log.
+ * @return The overhead in nanoseconds.
+ */
+uint32_t Calibration_GetStimulusOverhead(void);
+
+/**
+ * Prints the calibration constants, so that they can be checked.
+ */
+void Calibration_Print(void);
+
+#endif /* CALIBRATION_H_ */
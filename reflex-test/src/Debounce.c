@@ -0,0 +1,159 @@
+#include "Debounce.h"
+#include <string.h>
+
+/**
+ * Helper function that ends a burst once its raw level has held for the
+ * window: the debounced level follows it, or it was a glitch.
+ */
+static void Debounce_Settle(Debounce* debounce, uint32_t button, uint64_t now) {
+  Debounce_Button* b = &debounce->buttons[button];
+
+  // Compared this way so that a sample older than lastChange cannot wrap.
+  if (!b->settling || now < b->lastChange + b->window) {
+    return;
+  }
+  b->settling = false;
+
+  uint64_t bounceTime = b->lastChange - b->burstStart;
+  b->stats.bounces += b->burstTransitions - 1;
+  b->stats.totalBounceTime += bounceTime;
+  if (bounceTime > b->stats.longestBounceTime) {
+    b->stats.longestBounceTime = bounceTime;
+  }
+
+  if (b->raw == b->stable) {
+    b->stats.glitches++;
+    return;
+  }
+  b->stable = b->raw;
+  b->stats.edges++;
+  if (b->stable) {
+    // A repeat before the press was taken keeps the earlier time.
+    if ((debounce->pressed & (1 << button)) == 0) {
+      b->pressStart = b->burstStart;
+    }
+    debounce->pressed |= 1 << button;
+    debounce->presses++;
+  }
+}
+
+void Debounce_Init(Debounce* debounce, uint64_t window) {
+  uint32_t i;
+  memset(debounce, 0, sizeof(*debounce));
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    debounce->buttons[i].window = window;
+  }
+}
+
+void Debounce_SetWindow(Debounce* debounce, uint32_t button, uint64_t window) {
+  debounce->buttons[button].window = window;
+}
+
+void Debounce_Sample(Debounce* debounce, int32_t raw, uint64_t now) {
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    Debounce_Button* b = &debounce->buttons[i];
+    bool level = (raw & (1 << i)) != 0;
+
+    Debounce_Settle(debounce, i, now);
+    if (level != b->raw) {
+      if (!b->settling) {
+        b->settling = true;
+        b->burstStart = now;
+        b->burstTransitions = 0;
+      }
+      b->burstTransitions++;
+      b->raw = level;
+      b->lastChange = now;
+      // With no window, the edge is taken at once.
+      Debounce_Settle(debounce, i, now);
+    }
+  }
+}
+
+void Debounce_Resync(Debounce* debounce, int32_t raw, uint64_t now) {
+  uint32_t i;
+  Debounce_Sample(debounce, raw, now);
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    Debounce_Button* b = &debounce->buttons[i];
+    if (b->raw && !b->stable) {
+      b->pressStart = now;  // nobody saw it go down, so it is as new as can be
+    }
+    b->settling = false;
+    b->stable = b->raw;
+  }
+}
+
+int32_t Debounce_GetButtons(const Debounce* debounce) {
+  int32_t buttons = 0;
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    if (debounce->buttons[i].stable) {
+      buttons |= 1 << i;
+    }
+  }
+  return buttons;
+}
+
+int32_t Debounce_GetRaw(const Debounce* debounce) {
+  int32_t raw = 0;
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    if (debounce->buttons[i].raw) {
+      raw |= 1 << i;
+    }
+  }
+  return raw;
+}
+
+int32_t Debounce_TakePresses(Debounce* debounce, uint64_t* firstPress) {
+  int32_t pressed = debounce->pressed;
+  int32_t first = Debounce_GetFirstButton(debounce, pressed);
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    if (first == (1 << i)) {
+      *firstPress = debounce->buttons[i].pressStart;
+    }
+  }
+  debounce->pressed = 0;
+  debounce->presses = 0;
+  return pressed;
+}
+
+uint32_t Debounce_GetPendingPresses(const Debounce* debounce) {
+  return debounce->presses;
+}
+
+int32_t Debounce_GetFirstButton(const Debounce* debounce, int32_t buttons) {
+  int32_t first = 0;
+  uint64_t firstTime = 0;
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    uint64_t time = debounce->buttons[i].pressStart;
+    if ((buttons & (1 << i)) != 0 && (first == 0 || time < firstTime)) {
+      first = 1 << i;
+      firstTime = time;
+    }
+  }
+  return first;
+}
+
+uint64_t Debounce_GetPressTime(const Debounce* debounce, uint32_t button) {
+  return debounce->buttons[button].pressStart;
+}
+
+uint64_t Debounce_GetNextSettle(const Debounce* debounce) {
+  uint64_t next = DEBOUNCE_NEVER;
+  uint32_t i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    const Debounce_Button* b = &debounce->buttons[i];
+    if (b->settling && b->lastChange + b->window < next) {
+      next = b->lastChange + b->window;
+    }
+  }
+  return next;
+}
+
+const Debounce_Stats* Debounce_GetStats(const Debounce* debounce, uint32_t button) {
+  return &debounce->buttons[button].stats;
+}
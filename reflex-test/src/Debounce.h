@@ -0,0 +1,165 @@
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Debounces the push buttons from timestamped samples of their raw value.
+// A button's raw level has to hold for its stable window before the
+// debounced level follows it. The edge is then dated to the first raw
+// transition of the burst, not to when it settled, so debouncing delays
+// when a press is seen but not when it happened. A burst that settles back
+// where it started is a glitch and never becomes an edge.
+//
+// Samples can come from the GPIO interrupt's edges or from the tick; all
+// that matters is that their timestamps do not go backwards by more than a
+// window. Times are in whatever unit the caller uses, as long as windows and
+// timestamps agree.
+
+// Number of buttons, one per bit starting from bit 0. ButtonHardware
+// debounces the touch targets as four more buttons above the real ones.
+#define DEBOUNCE_NUMBER_OF_BUTTONS 8
+
+// Returned by Debounce_GetNextSettle when no button is bouncing.
+#define DEBOUNCE_NEVER UINT64_MAX
+
+/**
+ * How one button has been bouncing, to flag worn contacts.
+ */
+typedef struct {
+  uint32_t edges;              // debounced presses and releases
+  uint32_t glitches;           // bursts that settled back where they started
+  uint32_t bounces;            // raw transitions beyond the first of each burst
+  uint64_t totalBounceTime;    // first to last transition, summed over bursts
+  uint64_t longestBounceTime;  // the longest of them
+} Debounce_Stats;
+
+/**
+ * The state of one button. Should only be touched by Debounce functions.
+ */
+typedef struct {
+  uint64_t window;             // how long the raw level must hold
+  uint64_t burstStart;         // first raw transition of the current burst
+  uint64_t lastChange;         // latest raw transition
+  uint64_t pressStart;         // first transition of its latest press
+  uint32_t burstTransitions;   // raw transitions in the current burst
+  bool raw;                    // the latest raw level
+  bool stable;                 // the debounced level
+  bool settling;               // TRUE during a burst
+  Debounce_Stats stats;
+} Debounce_Button;
+
+/**
+ * A set of DEBOUNCE_NUMBER_OF_BUTTONS buttons. Should only be touched by
+ * Debounce functions.
+ */
+typedef struct Debounce {
+  Debounce_Button buttons[DEBOUNCE_NUMBER_OF_BUTTONS];
+  int32_t pressed;      // debounced presses not taken yet
+  uint32_t presses;     // how many, counting a button pressed again
+} Debounce;
+
+/**
+ * Releases every button, clears the statistics and gives every button the
+ * same stable window.
+ * @param debounce The buttons.
+ * @param window   How long a raw level must hold. 0 turns debouncing off.
+ */
+void Debounce_Init(Debounce* debounce, uint64_t window);
+
+/**
+ * Changes the stable window of one button.
+ * @param debounce The buttons.
+ * @param button   The button, 0 to DEBOUNCE_NUMBER_OF_BUTTONS-1.
+ * @param window   How long its raw level must hold.
+ */
+void Debounce_SetWindow(Debounce* debounce, uint32_t button, uint64_t window);
+
+/**
+ * Feeds one sample of the raw buttons in. Bursts that have held for their
+ * window by now settle first, so the sample can start a new one.
+ * @param debounce The buttons.
+ * @param raw      The raw value of the buttons, one bit per button.
+ * @param now      When the sample was taken.
+ */
+void Debounce_Sample(Debounce* debounce, int32_t raw, uint64_t now);
+
+/**
+ * Takes the raw value of the buttons as their debounced level at once,
+ * ending any burst, for when nobody has been watching them. Pending presses
+ * are kept; presses and releases it makes are not.
+ * @param debounce The buttons.
+ * @param raw      The raw value of the buttons, one bit per button.
+ * @param now      When the value was read.
+ */
+void Debounce_Resync(Debounce* debounce, int32_t raw, uint64_t now);
+
+/**
+ * Returns the debounced level of the buttons.
+ * @param  debounce The buttons.
+ * @return          One bit per button that is held down.
+ */
+int32_t Debounce_GetButtons(const Debounce* debounce);
+
+/**
+ * Returns the raw level of the buttons as of the latest sample, so that a
+ * caller that samples only some of them can keep the others as they are.
+ * @param  debounce The buttons.
+ * @return          One bit per button whose raw level is down.
+ */
+int32_t Debounce_GetRaw(const Debounce* debounce);
+
+/**
+ * Returns the buttons that went down since the last call, even if they are
+ * up again, and forgets them.
+ * @param  debounce   The buttons.
+ * @param  firstPress Where to store the edge time of the earliest press.
+ *                    Left alone if there were none.
+ * @return            One bit per button that was pressed.
+ */
+int32_t Debounce_TakePresses(Debounce* debounce, uint64_t* firstPress);
+
+/**
+ * Returns how many presses Debounce_TakePresses() would take, counting a
+ * button that went down more than once each time, so that mashing shows.
+ * @param  debounce The buttons.
+ * @return          The number of presses not taken yet.
+ */
+uint32_t Debounce_GetPendingPresses(const Debounce* debounce);
+
+/**
+ * Returns which of the given buttons went down first. A press not taken
+ * yet is dated to the earliest of its repeats; a button that is only held
+ * down, to the press that it is held from. Ties go to the lowest button.
+ * @param  debounce The buttons.
+ * @param  buttons  The buttons to choose from, one bit per button.
+ * @return          One bit for the first of them, or 0 if there were none.
+ */
+int32_t Debounce_GetFirstButton(const Debounce* debounce, int32_t buttons);
+
+/**
+ * Returns when the latest press of a button began, see
+ * Debounce_GetFirstButton.
+ * @param  debounce The buttons.
+ * @param  button   The button, 0 to DEBOUNCE_NUMBER_OF_BUTTONS-1.
+ * @return          The time of the first transition of the press.
+ */
+uint64_t Debounce_GetPressTime(const Debounce* debounce, uint32_t button);
+
+/**
+ * Returns when the earliest burst will have held for its window, if no
+ * other edge comes first. A sample then is needed for it to settle.
+ * @param  debounce The buttons.
+ * @return          The time, or DEBOUNCE_NEVER if no button is bouncing.
+ */
+uint64_t Debounce_GetNextSettle(const Debounce* debounce);
+
+/**
+ * Returns how a button has been bouncing since Debounce_Init().
+ * @param  debounce The buttons.
+ * @param  button   The button, 0 to DEBOUNCE_NUMBER_OF_BUTTONS-1.
+ * @return          Its statistics.
+ */
+const Debounce_Stats* Debounce_GetStats(const Debounce* debounce, uint32_t button);
+
+#endif /* DEBOUNCE_H_ */
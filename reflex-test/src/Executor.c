@@ -4,124 +4,119 @@
 #include "TimerConductor.h"
 #include "LcdConductor.h"
 #include "ReflexTestData.h"
+#include "SoftTimer.h"
+#include "Trace.h"
 #include <stdlib.h>
-#include <stdio.h>
 
-#define TICK_PERIOD       1                       // 1ms tick period
-#define FIVE_SECOND_WAIT  (5000 / (TICK_PERIOD))  // 5000ms = 5s
-#define TWO_SECOND_WAIT   (2000 / (TICK_PERIOD))
-#define ONE_SECOND_WAIT   (1000 / (TICK_PERIOD))
+#define FIVE_SECOND_WAIT  5000  // 5000ms = 5s
+#define TWO_SECOND_WAIT   2000
+#define ONE_SECOND_WAIT   1000
+
+// Returns the absolute deadline (in microseconds) that is ms from now.
+#define DEADLINE(now, ms) ((now) + ((uint64_t) (ms) * 1000))
+
+// Software timers used by the state machine. Each wait is armed once as an
+// absolute deadline when its state is entered, so late or missed ticks never
+// stretch it.
+#define HOLD_TIMER            0   // button held down in wait_five_seconds_st
+#define FLASH_TIMER           1   // wait before the next LED flash
+#define BUTTON_TIMEOUT_TIMER  2   // wait for the user to press a button
+#define STATS_TIMER           3   // time the stats stay on the screen
+
+#define EXECUTOR_NUMBER_OF_CONDUCTORS 4
+
+// Per-state list of conductor actions, terminated by NULL. This is built once
+// in Executor_Init from each conductor's action table so that Executor_Run
+// only calls the actions that actually exist for the current state.
+static ReflexTest_Action actionTable[REFLEXTESTDATA_NUMBER_OF_STATES]
+                                    [EXECUTOR_NUMBER_OF_CONDUCTORS + 1];
+
+// TRACE_*_ACTION bits for the actions in actionTable, for the trace.
+static uint8_t actionMasks[REFLEXTESTDATA_NUMBER_OF_STATES];
+
+// States that only wait for a deadline. After the first tick in one of these
+// states, ticks are skipped until a timer expires, unless the LCD still has
+// a frame to finish. Skipped ticks only drain the button edges.
+static const bool waitsOnDeadline[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [wait_between_flash_st] = true,
+  [wait_stats_st]         = true,
+};
+
+// How often each state needs to be ticked, in microseconds. Idle states only
+// watch for a held button or a deadline and tick slowly, while
+// wait_for_button_st samples the buttons quickly so the response time is
+// fine-grained. Every wait is an absolute deadline, so changing the rate
+// never changes how long a wait lasts.
+static const uint32_t tickPeriods[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [init_st]               = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [show_info_st]          = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [wait_info_st]          = EXECUTOR_IDLE_TICK_PERIOD,
+  [wait_five_seconds_st]  = EXECUTOR_IDLE_TICK_PERIOD,
+  [blank_screen_st]       = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [blink_led_st]          = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [wait_for_button_st]    = EXECUTOR_RESPONSE_TICK_PERIOD,
+  [button_pressed_st]     = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [wait_between_flash_st] = EXECUTOR_IDLE_TICK_PERIOD,
+  [show_stats_st]         = EXECUTOR_DEFAULT_TICK_PERIOD,
+  [wait_stats_st]         = EXECUTOR_IDLE_TICK_PERIOD,
+  [update_scores_st]      = EXECUTOR_DEFAULT_TICK_PERIOD,
+};
 
 /**
- * This is a helper function that can print out the current state of the SM.
- * This only prints out the state when the state changes, and can be useful
- * in visually seeing how the state transitions are happening.
+ * Helper function that fills in actionTable from the conductors. The order of
+ * the actions within a state matches the order the conductors must run in.
  */
-void verboseStatePrint(ReflexTest_st currentState) {
-  static ReflexTest_st previousState;
-  static bool firstPass = true;
-  // Only print the message if:
-  // 1. This the first pass and the value for previousState is unknown.
-  // 2. previousState != currentState - this prevents reprinting the same stat.
-  if (previousState != currentState || firstPass) {
-    firstPass = false;     // previousState will be defined, firstPass is false.
-    previousState = currentState; // keep track of the last state you were in.
-    switch(currentState) {  // prints info based on the state that you're in.
-      case init_st:
-        printf("init_st\n\r");
-        break;
-      case show_info_st:
-        printf("show_info_st\n\r");
-        break;
-      case wait_info_st:
-        printf("wait_info_st\n\r");
-        break;
-      case wait_five_seconds_st:
-        printf("wait_five_seconds_st\n\r");
-        break;
-      case blank_screen_st:
-        printf("blank_screen_st\n\r");
-        break;
-      case blink_led_st:
-        printf("blink_led_st\n\r");
-        break;
-      case wait_for_button_st:
-        printf("wait_for_button_st\n\r");
-        break;
-      case button_pressed_st:
-        printf("button_pressed_st\n\r");
-        break;
-      case wait_between_flash_st:
-        printf("wait_between_flash_st\n\r");
-        break;
-      case show_stats_st:
-        printf("show_stats_st\n\r");
-        break;
-      case wait_stats_st:
-        printf("wait_stats_st\n\r");
-        break;
-      case update_scores_st:
-        printf("update_scores_st\n\r");
-        break;
-      default:
-        printf("Shouldn't have hit this default case\n");
-        break;
-     }
+static void Executor_BuildActionTable(void) {
+  // The trace bit of each conductor, in the order of conductorActions.
+  static const uint8_t conductorTraceBits[EXECUTOR_NUMBER_OF_CONDUCTORS] = {
+    TRACE_BUTTON_ACTION, TRACE_TIMER_ACTION, TRACE_LED_ACTION, TRACE_LCD_ACTION,
+  };
+  int state;
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    // The order of these actions matters, see Executor_Run.
+    ReflexTest_Action conductorActions[EXECUTOR_NUMBER_OF_CONDUCTORS] = {
+      ButtonConductor_GetAction(state), // First, read the buttons
+      TimerConductor_GetAction(state),  // Next, perform any timing operations
+      LedConductor_GetAction(state),    // Next do LED information
+      LcdConductor_GetAction(state),    // Finally, show state
+    };
+
+    // Only keep the actions that exist, and terminate the list with NULL.
+    int i, count = 0;
+    actionMasks[state] = 0;
+    for (i = 0; i < EXECUTOR_NUMBER_OF_CONDUCTORS; i++) {
+      if (conductorActions[i] != NULL) {
+        actionTable[state][count++] = conductorActions[i];
+        actionMasks[state] |= conductorTraceBits[i];
+      }
+    }
+    actionTable[state][count] = NULL;
   }
 }
 
 /**
  * This is the primary tick function that drives the game's state machine.
  * It takes the current state of the game, performs the necessary actions,
- * and then returns the next state of the game.
+ * and then returns the next state of the game. Waits are armed as software
+ * timers on the transition into the waiting state and checked with
+ * SoftTimer_HasExpired, so they are measured from now rather than counted
+ * in ticks.
+ * @param  context      The game to work on.
  * @param  currentState The current state of the game.
+ * @param  now          The current time in microseconds.
  * @return              The next state of the game.
  */
-ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
-  // Uncomment the line below to visually see state transitions.
-  //verboseStatePrint(currentState);
-
-  static uint32_t fiveSecondTimer = 0;
-  static uint32_t flashTimer = 0;
-  static uint32_t flashWait = 0;  // value for randomized flash wait
-  static uint32_t buttonTimeoutTimer = 0;
-  static uint32_t waitStatsTimer = 0;
+ReflexTest_st ReflexTest_TickFunction(ReflexTest_Context* context,
+                                      ReflexTest_st currentState, uint64_t now) {
+  SoftTimer_Group* timers = &context->timers;
+  uint32_t flashWait;  // value for randomized flash wait, in ms
 
   // state actions
   switch (currentState) {
-    case init_st:
-      break;
-    case show_info_st:
-      break;
-    case wait_info_st:
-      fiveSecondTimer = 0;  // reset 5 second timer
-      break;
-    case wait_five_seconds_st:
-      fiveSecondTimer++;
-      break;
-    case blank_screen_st:
-      flashTimer = 0; // reset flash timer
-      break;
-    case wait_between_flash_st:
-      flashTimer++;
-      break;
-    case blink_led_st:
-      buttonTimeoutTimer = 0; // reset button timeout timer
-      break;
-    case wait_for_button_st:
-      buttonTimeoutTimer++;
-      break;
-    case button_pressed_st:
-      flashTimer = 0; // reset flash timer
-      break;
-    case show_stats_st:
-      waitStatsTimer = 0;
-      break;
-    case wait_stats_st:
-      waitStatsTimer++;
-      break;
     case update_scores_st:
-      ReflexTestData_UpdateScores();
+      ReflexTestData_UpdateScores(context);
+      break;
+    default:
       break;
   }
 
@@ -135,7 +130,8 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
       break;
     case wait_info_st:
       // Wait here until the user pressed a button
-      if (ReflexTestData_GetPressedButton() != 0x0) {
+      if (ReflexTestData_GetPressedButton(context) != 0x0) {
+        SoftTimer_Arm(timers, HOLD_TIMER, DEADLINE(now, FIVE_SECOND_WAIT));
         currentState = wait_five_seconds_st;
       }
       else {
@@ -144,12 +140,14 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
       break;
     case wait_five_seconds_st:
       // Wait here until a user pushes a button and holds it for 5 sec.
-      if (  fiveSecondTimer >= FIVE_SECOND_WAIT &&
-            (ReflexTestData_GetPressedButton() != 0x0)) {
+      if (  SoftTimer_HasExpired(timers, HOLD_TIMER) &&
+            (ReflexTestData_GetPressedButton(context) != 0x0)) {
+        SoftTimer_Cancel(timers, HOLD_TIMER);
         currentState = blank_screen_st;
       }
       // If they let go of the button before 5 sec, go back to waiting.
-      else if (ReflexTestData_GetPressedButton() == 0x0) {
+      else if (ReflexTestData_GetPressedButton(context) == 0x0) {
+        SoftTimer_Cancel(timers, HOLD_TIMER);
         currentState = wait_info_st;
       }
       else {
@@ -158,20 +156,22 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
       break;
     case blank_screen_st:
       currentState = wait_between_flash_st;
-      srand((unsigned) ReflexTestData_GetResponseTime());
-      ReflexTestData_GenerateSequence(rand());      // Seed a random number
+      context->randomSeed = (unsigned) ReflexTestData_GetResponseTime(context);
+      ReflexTestData_GenerateSequence(context, rand_r(&context->randomSeed));      // Seed a random number
 
       // Get a flash wait time between 2 and 4 seconds.
       // e.g. v3 = rand() % 30 + 1985;  <-- v3 in the range 1985-2014
-      flashWait = (rand() % TWO_SECOND_WAIT) + TWO_SECOND_WAIT;
+      flashWait = (rand_r(&context->randomSeed) % TWO_SECOND_WAIT) + TWO_SECOND_WAIT;
+      SoftTimer_Arm(timers, FLASH_TIMER, DEADLINE(now, flashWait));
       break;
     case wait_between_flash_st:
       // Wait here for flashWait and then blink LED if we're not finished
-      if (flashTimer >= flashWait && !ReflexTestData_IsSequenceDone()) {
+      if (SoftTimer_HasExpired(timers, FLASH_TIMER) && !ReflexTestData_IsSequenceDone(context)) {
         currentState = blink_led_st;
       }
       // If we are all done, show stats
-      else if (ReflexTestData_IsSequenceDone()) {
+      else if (ReflexTestData_IsSequenceDone(context)) {
+        SoftTimer_Cancel(timers, FLASH_TIMER);
         currentState = show_stats_st;
       }
       else {
@@ -179,15 +179,17 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
       }
       break;
     case blink_led_st:
+      SoftTimer_Arm(timers, BUTTON_TIMEOUT_TIMER, DEADLINE(now, FIVE_SECOND_WAIT));
       currentState = wait_for_button_st;
       break;
     case wait_for_button_st:
       // If the user doesn't push a button within two seconds, start the game over
-      if ((buttonTimeoutTimer >= FIVE_SECOND_WAIT) && !ReflexTestData_IsCorrectButtonPressed()) {
+      if (SoftTimer_HasExpired(timers, BUTTON_TIMEOUT_TIMER) && !ReflexTestData_IsCorrectButtonPressed(context)) {
         currentState = show_info_st;
       }
       // the moment they do push a button, move states.
-      else if (ReflexTestData_IsCorrectButtonPressed()) {
+      else if (ReflexTestData_IsCorrectButtonPressed(context)) {
+        SoftTimer_Cancel(timers, BUTTON_TIMEOUT_TIMER);
         currentState = button_pressed_st;
       }
       else {
@@ -197,14 +199,16 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
     case button_pressed_st:
       // Get a flash wait time between 2 and 4 seconds.
       // e.g. v3 = rand() % 30 + 1985;  <-- v3 in the range 1985-2014
-      flashWait = (rand() % TWO_SECOND_WAIT) + ONE_SECOND_WAIT;
+      flashWait = (rand_r(&context->randomSeed) % TWO_SECOND_WAIT) + ONE_SECOND_WAIT;
+      SoftTimer_Arm(timers, FLASH_TIMER, DEADLINE(now, flashWait));
       currentState = wait_between_flash_st;
       break;
     case show_stats_st:
+      SoftTimer_Arm(timers, STATS_TIMER, DEADLINE(now, FIVE_SECOND_WAIT));
       currentState = wait_stats_st;
       break;
     case wait_stats_st:
-      if (waitStatsTimer >= FIVE_SECOND_WAIT) {
+      if (SoftTimer_HasExpired(timers, STATS_TIMER)) {
         currentState = update_scores_st;
       }
       break;
@@ -216,25 +220,56 @@ ReflexTest_st ReflexTest_TickFunction(ReflexTest_st currentState) {
   return currentState;
 }
 
-void Executor_Init(void) {
+void Executor_Init(ReflexTest_Context* context) {
   //call init on each of the conductors
-  ButtonConductor_Init();
-  LedConductor_Init();
-  TimerConductor_Init();
-  LcdConductor_Init();
-  ReflexTestData_Init();
+  ButtonConductor_Init(context);
+  LedConductor_Init(context);
+  TimerConductor_Init(context);
+  LcdConductor_Init(context);
+  ReflexTestData_Init(context);
+  SoftTimer_Init(&context->timers);
+  Executor_BuildActionTable();
+  context->previousState = (ReflexTest_st) REFLEXTESTDATA_NUMBER_OF_STATES;
+}
+
+uint32_t Executor_GetTickPeriod(ReflexTest_st state) {
+  if (state >= REFLEXTESTDATA_NUMBER_OF_STATES) {
+    return EXECUTOR_DEFAULT_TICK_PERIOD;
+  }
+  return tickPeriods[state];
 }
 
-bool Executor_Run(void) {
+bool Executor_Run(ReflexTest_Context* context) {
+  ReflexTest_st currentState = ReflexTestData_GetCurrentState(context);
+  uint64_t now = TimerConductor_GetCurrentTime();
+  uint32_t expiredTimers = SoftTimer_Poll(&context->timers, now);
+
+  // Nothing can happen in a waiting state until one of its deadlines passes,
+  // so those ticks only keep the button edges from piling up.
+  if (waitsOnDeadline[currentState] && currentState == context->previousState &&
+      expiredTimers == 0 && LcdConductor_IsFrameDone(context)) {
+    ButtonConductor_DrainEdges(context);
+    return true;
+  }
+  context->previousState = currentState;
+
   // Each sub-triad conductor performs ONLY Moore actions
-  // based on the current state. The order of these actions matters.
-  ButtonConductor_Run();  // First, read the buttons
-  TimerConductor_Run();   // Next, perform any timing operations
-  LedConductor_Run();     // Next do LED information, which updates the index
-  LcdConductor_Run();     // Finally, show state after all computation is done
+  // based on the current state. The order of these actions matters:
+  // buttons, then timers, then LEDs (which updates the index), and finally
+  // the LCD to show state after all computation is done. States where no
+  // conductor has anything to do skip straight to the state update.
+  ReflexTest_Action* action;
+  for (action = actionTable[currentState]; *action != NULL; action++) {
+    (*action)(context);
+  }
 
   //state update next
-  ReflexTest_st nextState = ReflexTest_TickFunction(ReflexTestData_GetCurrentState());
-  ReflexTestData_SetCurrentState(nextState);
+  ReflexTest_st nextState = ReflexTest_TickFunction(context, currentState, now);
+  if (nextState != currentState) {
+    // Transitions go to the trace rather than to printf, which would stall
+    // the tick on the UART.
+    Trace_RecordTransition(now, currentState, nextState, actionMasks[currentState]);
+  }
+  ReflexTestData_SetCurrentState(context, nextState);
   return true;  // always return true so it can be the condition of a while(1)
 }
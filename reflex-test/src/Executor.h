@@ -2,18 +2,34 @@
 #define _EXECUTOR_H
 
 #include <stdbool.h>
+#include "ReflexTestData.h"
+
+// Tick periods in microseconds, see Executor_GetTickPeriod().
+#define EXECUTOR_DEFAULT_TICK_PERIOD   1000  // 1 ms
+#define EXECUTOR_IDLE_TICK_PERIOD     10000  // 10 ms while only waiting
+#define EXECUTOR_RESPONSE_TICK_PERIOD    50  // 50 us while timing a response
 
 /**
  * Initialization function for the executor that initializes all of the
  * conductors in the program.
+ * @param context The game to work on.
  */
-void Executor_Init(void);
+void Executor_Init(ReflexTest_Context* context);
 
 /**
  * Executor Run should be called in a while(1) loop. This in turn drives
  * the execution of the state machine.
+ * @param  context The game to work on.
  * @return  Always returns TRUE.
  */
-bool Executor_Run(void);
+bool Executor_Run(ReflexTest_Context* context);
+
+/**
+ * Returns how often Executor_Run should be called while in the given state.
+ * The caller should reprogram its tick timer whenever the state changes.
+ * @param  state The state to look up.
+ * @return       The tick period in microseconds.
+ */
+uint32_t Executor_GetTickPeriod(ReflexTest_st state);
 
 #endif // _EXECUTOR_H
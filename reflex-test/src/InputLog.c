@@ -0,0 +1,445 @@
+#include "InputLog.h"
+#include <stdio.h>
+#include <string.h>
+
+#define INPUTLOG_SMALL_BUTTONS_MAX  0x0F
+#define INPUTLOG_BUTTONS            0x10
+#define INPUTLOG_TIMESTAMP          0x20
+#define INPUTLOG_RESPONSE_TIME      0x21
+#define INPUTLOG_STATE              0x22
+#define INPUTLOG_REPEAT             0x23
+#define INPUTLOG_CALIBRATION        0x24
+#define INPUTLOG_SHORT_TIMESTAMP    0x80  // low 7 bits hold the delta
+#define INPUTLOG_VARINT_CONTINUE    0x80
+#define INPUTLOG_MAX_VARINT_SIZE    10
+
+// Largest record: a tag and a 10 byte varint.
+#define INPUTLOG_MAX_RECORD_SIZE 11
+// Longest pattern of records that a repeat can copy. The history holds two
+// periods so that a pattern can be recognized once it has happened twice.
+#define INPUTLOG_MAX_PERIOD 4
+#define INPUTLOG_HISTORY_SIZE (2 * INPUTLOG_MAX_PERIOD)
+#define INPUTLOG_BYTES_PER_LINE 32
+
+// One encoded record, before any repeats are applied.
+typedef struct {
+  uint8_t bytes[INPUTLOG_MAX_RECORD_SIZE];
+  uint32_t size;
+} InputLog_Record;
+
+static InputLog_Mode mode = INPUTLOG_OFF;
+static uint8_t* recordBuffer;
+static const uint8_t* replayLog;
+static uint32_t capacity;
+static uint32_t position;
+static uint64_t lastTimestamp;
+static bool full;
+static bool diverged;
+
+// The last records read or written, whether or not they were repeats.
+static InputLog_Record history[INPUTLOG_HISTORY_SIZE];
+static uint32_t historyCount;
+// The repeat being counted while recording, or being copied while
+// replaying. repeatPeriod is 0 when there is none.
+static uint32_t repeatPeriod;
+static uint64_t repeatRecords;
+
+void InputLog_Init() {
+  mode = INPUTLOG_OFF;
+  recordBuffer = NULL;
+  replayLog = NULL;
+  capacity = 0;
+  position = 0;
+  lastTimestamp = 0;
+  full = false;
+  diverged = false;
+  historyCount = 0;
+  repeatPeriod = 0;
+  repeatRecords = 0;
+}
+
+void InputLog_StartRecording(uint8_t* buffer, uint32_t size) {
+  InputLog_Init();
+  if (size < INPUTLOG_HEADER_SIZE) {
+    full = true;
+    return;
+  }
+  recordBuffer = buffer;
+  capacity = size;
+  memcpy(recordBuffer, INPUTLOG_MAGIC, 4);
+  recordBuffer[4] = INPUTLOG_VERSION;
+  position = INPUTLOG_HEADER_SIZE;
+  mode = INPUTLOG_RECORDING;
+}
+
+bool InputLog_StartReplay(const uint8_t* log, uint32_t size) {
+  InputLog_Init();
+  if (size < INPUTLOG_HEADER_SIZE || memcmp(log, INPUTLOG_MAGIC, 4) != 0 ||
+      log[4] != INPUTLOG_VERSION) {
+    return false;
+  }
+  replayLog = log;
+  capacity = size;
+  position = INPUTLOG_HEADER_SIZE;
+  mode = INPUTLOG_REPLAYING;
+  return true;
+}
+
+InputLog_Mode InputLog_GetMode() {
+  return mode;
+}
+
+uint32_t InputLog_GetSize() {
+  return position;
+}
+
+bool InputLog_IsFull() {
+  return full;
+}
+
+bool InputLog_IsReplayDone() {
+  return replayLog != NULL && !diverged && position >= capacity && repeatRecords == 0;
+}
+
+bool InputLog_HasDiverged() {
+  return diverged;
+}
+
+//********************************* History **********************************
+
+/**
+ * Returns the record that was read or written n records ago (n >= 1).
+ */
+static const InputLog_Record* InputLog_Back(uint32_t n) {
+  return &history[(historyCount - n) % INPUTLOG_HISTORY_SIZE];
+}
+
+static void InputLog_Remember(const InputLog_Record* record) {
+  history[historyCount % INPUTLOG_HISTORY_SIZE] = *record;
+  historyCount++;
+}
+
+static bool InputLog_SameRecord(const InputLog_Record* a, const InputLog_Record* b) {
+  return a->size == b->size && memcmp(a->bytes, b->bytes, a->size) == 0;
+}
+
+//******************************** Recording *********************************
+
+/**
+ * Writes bytes to the log, or stops recording if they do not fit.
+ */
+static void InputLog_Emit(const uint8_t* bytes, uint32_t size) {
+  if (position + size > capacity) {
+    full = true;
+    mode = INPUTLOG_OFF;
+    return;
+  }
+  memcpy(&recordBuffer[position], bytes, size);
+  position += size;
+}
+
+/**
+ * Writes value as a varint and returns the number of bytes used.
+ */
+static uint32_t InputLog_PutVarint(uint8_t* out, uint64_t value) {
+  uint32_t size = 0;
+  while (value >= INPUTLOG_VARINT_CONTINUE) {
+    out[size++] = (uint8_t) (value | INPUTLOG_VARINT_CONTINUE);
+    value >>= 7;
+  }
+  out[size++] = (uint8_t) value;
+  return size;
+}
+
+static void InputLog_PutLittleEndian(uint8_t* out, uint64_t value, uint32_t bytes) {
+  uint32_t i;
+  for (i = 0; i < bytes; i++) {
+    out[i] = (uint8_t) (value >> (8 * i));
+  }
+}
+
+/**
+ * Writes out the repeat being counted, if there is one.
+ */
+static void InputLog_FlushRepeat(void) {
+  uint8_t bytes[2 + INPUTLOG_MAX_VARINT_SIZE];
+  uint32_t size;
+  if (repeatPeriod != 0 && repeatRecords != 0) {
+    bytes[0] = INPUTLOG_REPEAT;
+    size = 1 + InputLog_PutVarint(&bytes[1], repeatRecords);
+    bytes[size++] = (uint8_t) repeatPeriod;
+    InputLog_Emit(bytes, size);
+  }
+  repeatPeriod = 0;
+  repeatRecords = 0;
+}
+
+/**
+ * Adds a record to the log. Records that continue the current pattern are
+ * only counted; anything else ends the repeat and is written out, and then
+ * starts a new repeat if the last records form a pattern.
+ */
+static void InputLog_Write(const InputLog_Record* record) {
+  uint32_t period, i;
+
+  if (repeatPeriod != 0 && InputLog_SameRecord(record, InputLog_Back(repeatPeriod))) {
+    repeatRecords++;
+    InputLog_Remember(record);
+    return;
+  }
+  InputLog_FlushRepeat();
+  InputLog_Emit(record->bytes, record->size);
+  InputLog_Remember(record);
+
+  for (period = 1; period <= INPUTLOG_MAX_PERIOD && historyCount >= 2 * period; period++) {
+    for (i = 1; i <= period; i++) {
+      if (!InputLog_SameRecord(InputLog_Back(i), InputLog_Back(i + period))) {
+        break;
+      }
+    }
+    if (i > period) {
+      repeatPeriod = period;
+      return;
+    }
+  }
+}
+
+void InputLog_Stop() {
+  if (mode == INPUTLOG_RECORDING) {
+    InputLog_FlushRepeat();
+  }
+  mode = INPUTLOG_OFF;
+}
+
+//******************************** Replaying *********************************
+
+/**
+ * Stops replaying because the game read something the log does not hold.
+ */
+static void InputLog_Diverge(void) {
+  diverged = true;
+  mode = INPUTLOG_OFF;
+}
+
+/**
+ * Reads a varint, diverging if it runs past the end of the log.
+ */
+static bool InputLog_TakeVarint(uint64_t* value) {
+  uint32_t shift = 0;
+  *value = 0;
+  while (position < capacity && shift < 64) {
+    uint8_t byte = replayLog[position++];
+    *value |= (uint64_t) (byte & ~INPUTLOG_VARINT_CONTINUE) << shift;
+    if ((byte & INPUTLOG_VARINT_CONTINUE) == 0) {
+      return true;
+    }
+    shift += 7;
+  }
+  InputLog_Diverge();
+  return false;
+}
+
+/**
+ * Returns the size of the record that starts with the given tag, or 0 if
+ * the tag is not valid.
+ */
+static uint32_t InputLog_RecordSize(uint32_t start) {
+  uint8_t tag = replayLog[start];
+  uint32_t size = 1;
+  if (tag <= INPUTLOG_SMALL_BUTTONS_MAX || tag >= INPUTLOG_SHORT_TIMESTAMP) {
+    return 1;
+  }
+  switch (tag) {
+    case INPUTLOG_BUTTONS:
+      return 5;
+    case INPUTLOG_STATE:
+      return 2;
+    case INPUTLOG_RESPONSE_TIME:
+    case INPUTLOG_CALIBRATION:
+    case INPUTLOG_TIMESTAMP:
+      while (start + size < capacity && size < INPUTLOG_MAX_RECORD_SIZE) {
+        if ((replayLog[start + size++] & INPUTLOG_VARINT_CONTINUE) == 0) {
+          return size;
+        }
+      }
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * Reads the next record, copying it from the history while a repeat lasts.
+ * @return FALSE at the end of the log or if the log is damaged.
+ */
+static bool InputLog_Read(InputLog_Record* record) {
+  while (repeatRecords == 0) {
+    uint64_t count;
+    if (position >= capacity) {
+      // Replay is over; the game carries on with live values.
+      mode = INPUTLOG_OFF;
+      return false;
+    }
+    if (replayLog[position] != INPUTLOG_REPEAT) {
+      record->size = InputLog_RecordSize(position);
+      if (record->size == 0 || position + record->size > capacity) {
+        InputLog_Diverge();
+        return false;
+      }
+      memcpy(record->bytes, &replayLog[position], record->size);
+      position += record->size;
+      InputLog_Remember(record);
+      return true;
+    }
+    position++;
+    if (!InputLog_TakeVarint(&count)) {
+      return false;
+    }
+    if (position >= capacity || replayLog[position] == 0 ||
+        replayLog[position] > INPUTLOG_MAX_PERIOD || replayLog[position] > historyCount) {
+      InputLog_Diverge();
+      return false;
+    }
+    repeatPeriod = replayLog[position++];
+    repeatRecords = count;
+  }
+  *record = *InputLog_Back(repeatPeriod);
+  InputLog_Remember(record);
+  repeatRecords--;
+  return true;
+}
+
+static uint64_t InputLog_GetLittleEndian(const uint8_t* bytes, uint32_t size) {
+  uint64_t value = 0;
+  uint32_t i;
+  for (i = 0; i < size; i++) {
+    value |= (uint64_t) bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+static uint64_t InputLog_GetVarint(const uint8_t* bytes) {
+  uint64_t value = 0;
+  uint32_t i = 0;
+  do {
+    value |= (uint64_t) (bytes[i] & ~INPUTLOG_VARINT_CONTINUE) << (7 * i);
+  } while ((bytes[i++] & INPUTLOG_VARINT_CONTINUE) != 0);
+  return value;
+}
+
+//********************************** Inputs **********************************
+
+int32_t InputLog_Buttons(int32_t live) {
+  InputLog_Record record;
+
+  if (mode == INPUTLOG_RECORDING) {
+    if (live >= 0 && live <= INPUTLOG_SMALL_BUTTONS_MAX) {
+      record.bytes[0] = (uint8_t) live;
+      record.size = 1;
+    }
+    else {
+      record.bytes[0] = INPUTLOG_BUTTONS;
+      InputLog_PutLittleEndian(&record.bytes[1], (uint32_t) live, 4);
+      record.size = 5;
+    }
+    InputLog_Write(&record);
+  }
+  else if (mode == INPUTLOG_REPLAYING && InputLog_Read(&record)) {
+    if (record.bytes[0] <= INPUTLOG_SMALL_BUTTONS_MAX) {
+      return record.bytes[0];
+    }
+    if (record.bytes[0] == INPUTLOG_BUTTONS) {
+      return (int32_t) (uint32_t) InputLog_GetLittleEndian(&record.bytes[1], 4);
+    }
+    InputLog_Diverge();
+  }
+  return live;
+}
+
+uint64_t InputLog_Timestamp(uint64_t live) {
+  InputLog_Record record;
+  uint64_t delta;
+
+  if (mode == INPUTLOG_RECORDING) {
+    delta = live - lastTimestamp;
+    if (delta < INPUTLOG_SHORT_TIMESTAMP) {
+      record.bytes[0] = (uint8_t) (INPUTLOG_SHORT_TIMESTAMP | delta);
+      record.size = 1;
+    }
+    else {
+      record.bytes[0] = INPUTLOG_TIMESTAMP;
+      record.size = 1 + InputLog_PutVarint(&record.bytes[1], delta);
+    }
+    lastTimestamp = live;
+    InputLog_Write(&record);
+  }
+  else if (mode == INPUTLOG_REPLAYING && InputLog_Read(&record)) {
+    if (record.bytes[0] >= INPUTLOG_SHORT_TIMESTAMP) {
+      lastTimestamp += record.bytes[0] & ~INPUTLOG_SHORT_TIMESTAMP;
+      return lastTimestamp;
+    }
+    if (record.bytes[0] == INPUTLOG_TIMESTAMP) {
+      lastTimestamp += InputLog_GetVarint(&record.bytes[1]);
+      return lastTimestamp;
+    }
+    InputLog_Diverge();
+  }
+  return live;
+}
+
+/**
+ * Records or replays a value that is stored as the given tag and a varint.
+ */
+static uint32_t InputLog_VarintValue(uint8_t tag, uint32_t live) {
+  InputLog_Record record;
+
+  if (mode == INPUTLOG_RECORDING) {
+    record.bytes[0] = tag;
+    record.size = 1 + InputLog_PutVarint(&record.bytes[1], live);
+    InputLog_Write(&record);
+  }
+  else if (mode == INPUTLOG_REPLAYING && InputLog_Read(&record)) {
+    if (record.bytes[0] == tag) {
+      return (uint32_t) InputLog_GetVarint(&record.bytes[1]);
+    }
+    InputLog_Diverge();
+  }
+  return live;
+}
+
+uint32_t InputLog_ResponseTime(uint32_t live) {
+  return InputLog_VarintValue(INPUTLOG_RESPONSE_TIME, live);
+}
+
+uint32_t InputLog_Calibration(uint32_t live) {
+  return InputLog_VarintValue(INPUTLOG_CALIBRATION, live);
+}
+
+bool InputLog_State(ReflexTest_st state) {
+  InputLog_Record record;
+
+  if (mode == INPUTLOG_RECORDING) {
+    record.bytes[0] = INPUTLOG_STATE;
+    record.bytes[1] = (uint8_t) state;
+    record.size = 2;
+    InputLog_Write(&record);
+  }
+  else if (mode == INPUTLOG_REPLAYING && InputLog_Read(&record) &&
+           (record.bytes[0] != INPUTLOG_STATE || record.bytes[1] != (uint8_t) state)) {
+    InputLog_Diverge();
+  }
+  return !diverged;
+}
+
+void InputLog_Print() {
+  const uint8_t* log = (recordBuffer != NULL) ? recordBuffer : replayLog;
+  uint32_t i;
+  printf("inputlog begin %lu\n\r", (unsigned long) position);
+  for (i = 0; i < position; i++) {
+    printf("%02x", log[i]);
+    if ((i + 1) % INPUTLOG_BYTES_PER_LINE == 0 || i + 1 == position) {
+      printf("\n\r");
+    }
+  }
+  printf("inputlog end\n\r");
+}
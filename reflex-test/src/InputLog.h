@@ -0,0 +1,143 @@
+#ifndef INPUTLOG_H_
+#define INPUTLOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ReflexTestData.h"
+
+// Everything the game reads from the outside world (button samples, tick
+// timestamps and response times) passes through the InputLog functions
+// below, in the order the game reads it. While recording, each value is
+// appended to a compact binary log. While replaying, each function ignores
+// the live value and returns the next one from the log instead, so a
+// recorded session runs through Executor_Run bit for bit.
+//
+// Log format: the 4 byte magic "RTIL" and a version byte, then one record
+// per value read:
+//   0x00-0x0F  buttons, value in the low nibble
+//   0x10       buttons, followed by the 32 bit value (little-endian)
+//   0x20       timestamp, followed by the microseconds since the last
+//              timestamp as a varint (7 bits per byte, low bits first)
+//   0x21       response time, followed by the microseconds as a varint
+//   0x22       state change, followed by the new state
+//   0x23       repeat, followed by a record count as a varint and a period
+//              byte: each of the next count records is a copy of the record
+//              period records before it
+//   0x24       calibration constant, followed by the nanoseconds as a varint
+//   0x80-0xFF  timestamp, less than 128 us after the last one
+// Ticks where nothing changes produce the same few records over and over,
+// so long waits collapse into a single repeat record.
+#define INPUTLOG_MAGIC "RTIL"
+#define INPUTLOG_VERSION 4
+#define INPUTLOG_HEADER_SIZE 5
+
+typedef enum {
+  INPUTLOG_OFF,        // values pass straight through
+  INPUTLOG_RECORDING,
+  INPUTLOG_REPLAYING,
+} InputLog_Mode;
+
+/**
+ * Stops recording or replaying. Values pass straight through.
+ */
+void InputLog_Init(void);
+
+/**
+ * Starts recording everything the game reads into the given buffer. When
+ * the buffer fills up, recording stops and the log ends at the last
+ * complete record.
+ * @param buffer   Where to write the log.
+ * @param capacity The size of the buffer in bytes.
+ */
+void InputLog_StartRecording(uint8_t* buffer, uint32_t capacity);
+
+/**
+ * Starts replaying a recorded log.
+ * @param  log  The log, as written by InputLog_StartRecording.
+ * @param  size The size of the log in bytes.
+ * @return      FALSE if the log does not start with a valid header.
+ */
+bool InputLog_StartReplay(const uint8_t* log, uint32_t size);
+
+/**
+ * Stops recording, writing out any repeat that is still being counted, or
+ * stops replaying. Values pass straight through afterwards.
+ */
+void InputLog_Stop(void);
+
+/**
+ * Returns whether the log is off, recording or replaying.
+ * @return The current mode.
+ */
+InputLog_Mode InputLog_GetMode(void);
+
+/**
+ * Returns the number of bytes recorded or replayed so far. A repeat that is
+ * still being counted is not included until InputLog_Stop() is called.
+ * @return The size of the log in bytes.
+ */
+uint32_t InputLog_GetSize(void);
+
+/**
+ * Returns true if recording ran out of room, so the log ends early.
+ * @return TRUE if the log is truncated.
+ */
+bool InputLog_IsFull(void);
+
+/**
+ * Returns true once replay has used every record in the log.
+ * @return TRUE at the end of the log.
+ */
+bool InputLog_IsReplayDone(void);
+
+/**
+ * Returns true if the game read something different from what the log holds
+ * next, which means the replayed game no longer matches the recorded one.
+ * Replay stops at that point and values pass straight through.
+ * @return TRUE if replay diverged.
+ */
+bool InputLog_HasDiverged(void);
+
+/**
+ * Records or replays a sample of the buttons.
+ * @param  live The value read from the hardware.
+ * @return      The value the game should use.
+ */
+int32_t InputLog_Buttons(int32_t live);
+
+/**
+ * Records or replays a tick timestamp.
+ * @param  live The time read from the hardware in microseconds.
+ * @return      The time the game should use.
+ */
+uint64_t InputLog_Timestamp(uint64_t live);
+
+/**
+ * Records or replays a response time.
+ * @param  live The response time read from the hardware in microseconds.
+ * @return      The response time the game should use.
+ */
+uint32_t InputLog_ResponseTime(uint32_t live);
+
+/**
+ * Records or replays one of the measurement overheads from Calibration.
+ * @param  live The overhead measured on this hardware in nanoseconds.
+ * @return      The overhead the game should use.
+ */
+uint32_t InputLog_Calibration(uint32_t live);
+
+/**
+ * Records a change of state, or checks it against the log while replaying.
+ * These records are not inputs; they let replay prove that it matches.
+ * @param  state The state the game just moved to.
+ * @return       FALSE if replay diverged here.
+ */
+bool InputLog_State(ReflexTest_st state);
+
+/**
+ * Prints the log as hex between "inputlog begin" and "inputlog end" lines,
+ * so that it can be captured from the UART. Call InputLog_Stop() first.
+ */
+void InputLog_Print(void);
+
+#endif /* INPUTLOG_H_ */
@@ -1,51 +1,104 @@
 #include "LcdConductor.h"
-#include "LcdHardware.h"
+#include "LcdMailbox.h"
 #include "LcdModel.h"
+#include <stddef.h>
 
-void LcdConductor_Init() {
-  LcdModel_Init();
-  LcdHardware_Init();
-}
-
-void LcdConductor_Run() {
-  double average, min, max;
-  double* scores;
-  // state actions
-  switch (LcdModel_GetCurrentState()) {
-    case init_st:
-      break;
-    case show_info_st:
-      // Print out the instructions, as well as the most recent 10 high scores.
-      scores = LcdModel_GetHighScores();
-      average = LcdModel_GetAverageResponseTime();
-      LcdHardware_ShowInfo(scores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, average);
-      break;
-    case wait_info_st:
-      break;
-    case wait_five_seconds_st:
-      break;
-    case blank_screen_st:
-      LcdHardware_BlankScreen();  // Blank the LCD screen
-      break;
-    case wait_between_flash_st:
-      break;
-    case blink_led_st:
-      break;
-    case wait_for_button_st:
-      break;
-    case button_pressed_st:
-      break;
-    case show_stats_st:
-      // Print out the average, min, and max times for the round.
-      average = LcdModel_GetAverageResponseTime();
-      min = LcdModel_GetMinResponseTime();
-      max = LcdModel_GetMaxResponseTime();
-      LcdHardware_ShowStats(average, min, max);
-      break;
-    case wait_stats_st:
-      break;
-    case update_scores_st:
-      LcdHardware_BlankScreen();  // Blank the LCD screen
-      break;
+/**
+ * Draws as much of the current frame as fits in the budget.
+ */
+static void LcdConductor_Render(ReflexTest_Context* context, uint32_t budget) {
+  context->lcdFrameDone = LcdMailbox_Render(&context->lcdFrame, budget);
+}
+
+/**
+ * Print out the instructions, as well as the most recent 10 high scores.
+ */
+static void LcdConductor_ShowInfo(ReflexTest_Context* context) {
+  uint32_t* scores = LcdModel_GetHighScores(context);
+  uint32_t average = LcdModel_GetAverageResponseTime(context);
+  LcdMailbox_ShowInfo(&context->lcdFrame, scores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, average);
+  LcdConductor_Render(context, LCDCONDUCTOR_RENDER_BUDGET);
+}
+
+/**
+ * Blank the LCD screen.
+ */
+static void LcdConductor_BlankScreen(ReflexTest_Context* context) {
+  LcdMailbox_BlankScreen(&context->lcdFrame);
+  LcdConductor_Render(context, LCDCONDUCTOR_RENDER_BUDGET);
+}
+
+/**
+ * Print out the average, min, and max times for the round.
+ */
+static void LcdConductor_ShowStats(ReflexTest_Context* context) {
+  uint32_t average = LcdModel_GetAverageResponseTime(context);
+  uint32_t min = LcdModel_GetMinResponseTime(context);
+  uint32_t max = LcdModel_GetMaxResponseTime(context);
+  LcdMailbox_ShowStats(&context->lcdFrame, average, min, max);
+  LcdConductor_Render(context, LCDCONDUCTOR_RENDER_BUDGET);
+}
+
+/**
+ * Light the target for the LED that just went on. It is one square, so it
+ * is drawn in this tick along with the LED.
+ */
+static void LcdConductor_ShowTarget(ReflexTest_Context* context) {
+  LcdMailbox_ShowTargets(&context->lcdFrame, LcdModel_GetTarget(context));
+  LcdConductor_Render(context, LCDCONDUCTOR_RENDER_BUDGET);
+}
+
+/**
+ * Blank the target once the player has hit it.
+ */
+static void LcdConductor_HideTarget(ReflexTest_Context* context) {
+  LcdMailbox_ShowTargets(&context->lcdFrame, 0);
+  LcdConductor_Render(context, LCDCONDUCTOR_RENDER_BUDGET);
+}
+
+/**
+ * Keep drawing the frame that was started in an earlier state.
+ */
+static void LcdConductor_ContinueFrame(ReflexTest_Context* context) {
+  if (!context->lcdFrameDone) {
+    LcdConductor_Render(context, LCDCONDUCTOR_IDLE_RENDER_BUDGET);
+  }
+}
+
+// state actions. States that are not listed here do nothing. Frames are
+// finished in the slow idle states that follow the ones that start them,
+// and never while the player is being timed; a target fits in the tick that
+// lights it.
+static const ReflexTest_Action LcdConductor_Actions[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [show_info_st]          = LcdConductor_ShowInfo,
+  [wait_info_st]          = LcdConductor_ContinueFrame,
+  [wait_five_seconds_st]  = LcdConductor_ContinueFrame,
+  [blank_screen_st]       = LcdConductor_BlankScreen,
+  [blink_led_st]          = LcdConductor_ShowTarget,
+  [button_pressed_st]     = LcdConductor_HideTarget,
+  [wait_between_flash_st] = LcdConductor_ContinueFrame,
+  [show_stats_st]         = LcdConductor_ShowStats,
+  [wait_stats_st]         = LcdConductor_ContinueFrame,
+  [update_scores_st]      = LcdConductor_BlankScreen,
+};
+
+void LcdConductor_Init(ReflexTest_Context* context) {
+  LcdModel_Init(context);
+  LcdMailbox_Init(&context->lcdFrame);
+  context->lcdFrameDone = true;
+}
+
+bool LcdConductor_IsFrameDone(ReflexTest_Context* context) {
+  return context->lcdFrameDone;
+}
+
+ReflexTest_Action LcdConductor_GetAction(ReflexTest_st state) {
+  return LcdConductor_Actions[state];
+}
+
+void LcdConductor_Run(ReflexTest_Context* context) {
+  ReflexTest_Action action = LcdConductor_GetAction(LcdModel_GetCurrentState(context));
+  if (action != NULL) {
+    action(context);
   }
 }
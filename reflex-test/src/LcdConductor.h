@@ -1,14 +1,40 @@
 #ifndef LCDCONDUCTOR_H_
 #define LCDCONDUCTOR_H_
 
+#include "ReflexTestData.h"
+
+// Microseconds of drawing per tick in the states that start a frame, half
+// of their 1 ms tick.
+#define LCDCONDUCTOR_RENDER_BUDGET 500
+// Microseconds of drawing per tick in the idle states that finish it, half
+// of their 10 ms tick.
+#define LCDCONDUCTOR_IDLE_RENDER_BUDGET 5000
+
 /**
  * Initializes the triad for controlling the LCD.
+ * @param context The game to work on.
+ */
+void LcdConductor_Init(ReflexTest_Context* context);
+
+/**
+ * Returns whether the last frame asked for has been drawn completely. Until
+ * it has, ticks in the idle states keep drawing it.
+ * @param  context The game to work on.
+ * @return         FALSE while a frame is still being drawn.
+ */
+bool LcdConductor_IsFrameDone(ReflexTest_Context* context);
+
+/**
+ * Returns the LCD action for the given state.
+ * @param  state The state to look up.
+ * @return       The action to perform, or NULL if there is nothing to do.
  */
-void LcdConductor_Init(void);
+ReflexTest_Action LcdConductor_GetAction(ReflexTest_st state);
 
 /**
  * Performs LCD actions based on the current state.
+ * @param context The game to work on.
  */
-void LcdConductor_Run(void);
+void LcdConductor_Run(ReflexTest_Context* context);
 
 #endif /* LCDCONDUCTOR_H_ */
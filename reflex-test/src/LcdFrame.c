@@ -0,0 +1,24 @@
+#include "LcdFrame.h"
+#include <string.h>
+
+void LcdFrame_Init(LcdFrame* frame) {
+  memset(frame, 0, sizeof(*frame));
+  frame->type = LCDFRAME_NO_FRAME;
+}
+
+void LcdFrame_Start(LcdFrame* frame, uint32_t type) {
+  frame->type = type;
+  frame->step = 0;
+}
+
+bool LcdFrame_NextStepFits(const LcdFrame* frame, LcdFrame_StepKind kind,
+                           uint64_t elapsed, uint64_t limit) {
+  return elapsed + frame->longestStep[kind] <= limit;
+}
+
+void LcdFrame_FinishStep(LcdFrame* frame, LcdFrame_StepKind kind, uint64_t cost) {
+  frame->step++;
+  if (cost > frame->longestStep[kind]) {
+    frame->longestStep[kind] = cost;
+  }
+}
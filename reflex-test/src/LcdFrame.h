@@ -0,0 +1,81 @@
+#ifndef LCDFRAME_H_
+#define LCDFRAME_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// LcdHardware draws each frame in small steps, a few per tick. An LcdFrame
+// is one display's frame in progress: what it shows, the next step to draw,
+// what is already on the screen, and how long each kind of step has taken
+// so far, which is what the budget is spent against. Each game keeps its
+// own in its context, so games that run side by side never draw into each
+// other's frames.
+
+// The most high scores one frame shows.
+#define LCDFRAME_MAX_SCORES 10
+// The frame type before any frame has been started.
+#define LCDFRAME_NO_FRAME 0
+
+/**
+ * What a step costs depends mostly on whether it fills a band or prints.
+ */
+typedef enum {
+  LCDFRAME_FILL_STEP,
+  LCDFRAME_TEXT_STEP,
+  LCDFRAME_NUMBER_OF_STEP_KINDS,
+} LcdFrame_StepKind;
+
+/**
+ * One display's frame in progress, with copies of everything it shows. The
+ * members should only be touched by LcdFrame and LcdHardware functions.
+ */
+typedef struct LcdFrame {
+  uint32_t type;          // what is being drawn, as LcdHardware names it
+  uint32_t step;          // the next step to draw
+  uint32_t highScores[LCDFRAME_MAX_SCORES];
+  uint32_t newScore;
+  uint32_t average;
+  uint32_t min;
+  uint32_t max;
+  int32_t targets;        // the targets to light
+  int32_t changedTargets; // the targets that still have to be drawn
+  int32_t shownTargets;   // the targets lit on the screen
+  uint64_t longestStep[LCDFRAME_NUMBER_OF_STEP_KINDS];  // global timer ticks
+} LcdFrame;
+
+/**
+ * Leaves the frame with nothing to draw, no targets on the screen and no
+ * step costs known yet.
+ * @param frame The frame.
+ */
+void LcdFrame_Init(LcdFrame* frame);
+
+/**
+ * Starts drawing a new frame from its first step. A frame that is still
+ * being drawn is abandoned; the step costs seen so far are kept.
+ * @param frame The frame.
+ * @param type  What the new frame shows, as LcdHardware names it.
+ */
+void LcdFrame_Start(LcdFrame* frame, uint32_t type);
+
+/**
+ * Returns whether the next step should still fit in a budget, going by the
+ * longest step of its kind so far.
+ * @param  frame   The frame.
+ * @param  kind    The kind of the next step.
+ * @param  elapsed Global timer ticks already spent.
+ * @param  limit   Global timer ticks that may be spent.
+ * @return         TRUE if the step would end within the limit.
+ */
+bool LcdFrame_NextStepFits(const LcdFrame* frame, LcdFrame_StepKind kind,
+                           uint64_t elapsed, uint64_t limit);
+
+/**
+ * Moves on to the next step, remembering what the one just drawn cost.
+ * @param frame The frame.
+ * @param kind  The kind of the step just drawn.
+ * @param cost  Global timer ticks that it took.
+ */
+void LcdFrame_FinishStep(LcdFrame* frame, LcdFrame_StepKind kind, uint64_t cost);
+
+#endif /* LCDFRAME_H_ */
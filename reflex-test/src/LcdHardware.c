@@ -1,8 +1,11 @@
 #include "LcdHardware.h"
+#include "LcdFrame.h"
+#include "ReflexTestData.h"
 #include "display.h"
-#include "math.h"
+#include "../vendor/supportFiles/globalTimer.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #define LINE_HEIGHT   10
 #define CENTERED_Y    (display_height()/2)
@@ -10,90 +13,300 @@
 #define TEXTSIZE_H1   4
 #define TEXTSIZE_H2   2
 #define TEXTSIZE_H3   1
+#define TARGET_COLOR  DISPLAY_GREEN
 #define MAX_STR_LEN   255
 
-void LcdHardware_Init() {
-  display_init();
-  display_fillScreen(DISPLAY_BLACK);
-}
+#define GLOBAL_TIMER_TICKS_PER_US (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
 
-void LcdHardware_ShowInfo(double* highScores, int32_t length, double newScore) {
-  double epsilon = 0.0000001; // used for checking float equality
+// Prints a time in microseconds as seconds with six decimals.
+#define SECONDS_FORMAT "%lu.%06lu sec"
+#define SECONDS(microseconds) \
+  (unsigned long) ((microseconds) / REFLEXTESTDATA_MICROSECONDS_PER_SECOND), \
+  (unsigned long) ((microseconds) % REFLEXTESTDATA_MICROSECONDS_PER_SECOND)
 
-  // Blank the screen and set the cursor to the top left corner.
-  display_fillScreen(DISPLAY_BLACK);
-  display_setCursor(0,0);
+typedef enum {
+  LCDHARDWARE_NO_FRAME = LCDFRAME_NO_FRAME,
+  LCDHARDWARE_INFO_FRAME,
+  LCDHARDWARE_BLANK_FRAME,
+  LCDHARDWARE_STATS_FRAME,
+  LCDHARDWARE_TARGETS_FRAME,
+} LcdHardware_FrameType;
+
+/**
+ * One line of the instructions. A textSize of 0 keeps the current size.
+ */
+typedef struct {
+  uint8_t textSize;
+  const char* text;
+} LcdHardware_Line;
 
+static const LcdHardware_Line infoLines[] = {
+  { TEXTSIZE_H2, "How to play Reflex Test" },
+  { TEXTSIZE_H3, "" },
+  { 0, "When the game begins, one of the LEDs will flash on." },
+  { 0, "Press the corresponding button as fast as you can," },
+  { 0, "or touch the square that lights up on the screen." },
+  { 0, "" },
+  { 0, "Hold any button for 5 seconds to begin." },
+  { 0, "" },
+  { 0, "" },
+  { 0, "" },
+  { 0, "" },
+  { 0, "" },
+  { 0, "" },
+  { TEXTSIZE_H2, "High Scores" },
+};
+#define NUMBER_OF_INFO_LINES (sizeof(infoLines) / sizeof(infoLines[0]))
+#define NUMBER_OF_STATS_LINES 3
+
+/**
+ * Clears one horizontal band of the screen.
+ */
+static void LcdHardware_FillBand(uint32_t band) {
+  int16_t top = (int16_t) ((band * display_height()) / LCDHARDWARE_FILL_BANDS);
+  int16_t bottom = (int16_t) (((band + 1) * display_height()) / LCDHARDWARE_FILL_BANDS);
+  display_fillRect(0, top, display_width(), bottom - top, DISPLAY_BLACK);
+}
+
+/**
+ * Prints one of the high scores in one of two columns, highlighting the
+ * newest one.
+ * NOTE: if user plays but doesn't make high scores, no score is highlighted
+ */
+static void LcdHardware_PrintHighScore(const LcdFrame* frame, int i) {
   char str[MAX_STR_LEN];  // Create a buffer for printing.
 
-  display_setTextSize(TEXTSIZE_H2);
-  display_println("How to play Reflex Test");
-  display_setTextSize(TEXTSIZE_H3);
-  display_println("");
-  display_println("When the game begins, one of the LEDs will flash on.");
-  display_println("Press the corresponding button as fast as you can.");
+  if (i < 5) {
+    display_setCursor(0, CENTERED_Y + (LINE_HEIGHT*(i+1)));
+  }
+  else {
+    display_setCursor(CENTERED_X, CENTERED_Y + (LINE_HEIGHT*(i-4)));
+  }
+  sprintf(str, "%d. " SECONDS_FORMAT, (i+1), SECONDS(frame->highScores[i]));
+  if(frame->highScores[i] == frame->newScore) {
+    display_setTextColor(DISPLAY_GREEN);
+  }
+  else {
+    display_setTextColor(DISPLAY_WHITE);
+  }
+  display_println(str);
+}
 
-  display_println("");
+/**
+ * Draws one step of the instructions and high scores: the background, then
+ * the instructions, then the scores.
+ */
+static void LcdHardware_DrawInfoStep(const LcdFrame* frame, uint32_t step) {
+  if (step < LCDHARDWARE_FILL_BANDS) {
+    LcdHardware_FillBand(step);
+    return;
+  }
+  step -= LCDHARDWARE_FILL_BANDS;
+  if (step < NUMBER_OF_INFO_LINES) {
+    if (step == 0) {
+      display_setCursor(0,0);
+    }
+    if (infoLines[step].textSize != 0) {
+      display_setTextSize(infoLines[step].textSize);
+    }
+    display_println(infoLines[step].text);
+    return;
+  }
+  step -= NUMBER_OF_INFO_LINES;
+  if (step == 0) {
+    display_setTextSize(TEXTSIZE_H3);
+  }
+  LcdHardware_PrintHighScore(frame, step);
+}
 
-  display_println("Hold any button for 5 seconds to begin.");
+/**
+ * Draws one line of the stats.
+ */
+static void LcdHardware_DrawStatsStep(const LcdFrame* frame, uint32_t step) {
+  char str[MAX_STR_LEN];  // buffer for characters
 
-  display_println("");
-  display_println("");
-  display_println("");
-  display_println("");
-  display_println("");
-  display_println("");
-  display_setTextSize(TEXTSIZE_H2);
+  switch (step) {
+    case 0:
+      display_setCursor(0, 0);  // set cursor to origin
+      display_setTextSize(TEXTSIZE_H2); // Make Text Larger
+      sprintf(str, "Average Time: " SECONDS_FORMAT, SECONDS(frame->average));
+      break;
+    case 1:
+      sprintf(str, "Fastest Time: " SECONDS_FORMAT, SECONDS(frame->min));
+      break;
+    default:
+      sprintf(str, "Slowest Time: " SECONDS_FORMAT, SECONDS(frame->max));
+      break;
+  }
+  display_println(str);
+}
 
-  display_println("High Scores");
+/**
+ * Returns the number of targets in a set of them.
+ */
+static uint32_t LcdHardware_CountTargets(int32_t targets) {
+  uint32_t count = 0;
+  for (; targets != 0; targets &= targets - 1) {
+    count++;
+  }
+  return count;
+}
 
-  display_setTextSize(TEXTSIZE_H3);
+/**
+ * Lights or blanks the next target that changes. Only those are drawn, so
+ * lighting one target costs one square. Column 0 is on the left, and holds
+ * the target for the highest LED.
+ */
+static void LcdHardware_DrawTargetStep(LcdFrame* frame) {
+  int32_t target = frame->changedTargets & (~frame->changedTargets + 1);
+  int16_t led = 0;
+  while ((target >> led) > 1) {
+    led++;
+  }
+  int16_t column = LCDHARDWARE_NUMBER_OF_TARGETS - 1 - led;
+  int16_t columnWidth = display_width() / LCDHARDWARE_NUMBER_OF_TARGETS;
+  int16_t x = (int16_t) (column * columnWidth) + (columnWidth - LCDHARDWARE_TARGET_SIZE) / 2;
+  int16_t y = (display_height() - LCDHARDWARE_TARGET_SIZE) / 2;
+  uint16_t color = (frame->targets & target) ? TARGET_COLOR : DISPLAY_BLACK;
+  display_fillRect(x, y, LCDHARDWARE_TARGET_SIZE, LCDHARDWARE_TARGET_SIZE, color);
+  frame->changedTargets &= ~target;
+  frame->shownTargets ^= target;
+}
 
-  // Begin printing out the 10 high scores.
-  int i;
-  for (i = 0; i < 5; i++) {
-    display_setCursor(0, CENTERED_Y + (LINE_HEIGHT*(i+1)));
-    sprintf(str, "%d. %lf sec", (i+1), highScores[i]);
-    // highlight the newest high score.
-    // NOTE: if user plays but doesn't make high scores, no score is highlighted
-    if(fabs(highScores[i] - newScore) < epsilon) {
-      display_setTextColor(DISPLAY_GREEN);
-    }
-    else {
-      display_setTextColor(DISPLAY_WHITE);
-    }
-    display_println(str);
+/**
+ * Returns the number of steps in the current frame.
+ */
+static uint32_t LcdHardware_GetNumberOfSteps(const LcdFrame* frame) {
+  switch (frame->type) {
+    case LCDHARDWARE_INFO_FRAME:
+      return LCDHARDWARE_FILL_BANDS + NUMBER_OF_INFO_LINES + LCDFRAME_MAX_SCORES;
+    case LCDHARDWARE_BLANK_FRAME:
+      return LCDHARDWARE_FILL_BANDS;
+    case LCDHARDWARE_STATS_FRAME:
+      return NUMBER_OF_STATS_LINES;
+    case LCDHARDWARE_TARGETS_FRAME:
+      return frame->step + LcdHardware_CountTargets(frame->changedTargets);
+    default:
+      return 0;
   }
+}
 
-  for (i = 5; i < 10; i++) {
-    display_setCursor(CENTERED_X, CENTERED_Y + (LINE_HEIGHT*(i-4)));
-    sprintf(str, "%d. %lf sec", (i+1), highScores[i]);
-    // highlight the newest high score.
-    if(fabs(highScores[i] - newScore) < epsilon) {
-      display_setTextColor(DISPLAY_GREEN);
-    }
-    else {
-      display_setTextColor(DISPLAY_WHITE);
-    }
-    display_println(str);
+/**
+ * Returns whether the given step of the current frame fills a band.
+ */
+static LcdFrame_StepKind LcdHardware_GetStepKind(const LcdFrame* frame, uint32_t step) {
+  if (frame->type != LCDHARDWARE_STATS_FRAME && step < LCDHARDWARE_FILL_BANDS) {
+    return LCDFRAME_FILL_STEP;
   }
+  return LCDFRAME_TEXT_STEP;
 }
 
-void LcdHardware_BlankScreen(void) {
-  display_fillScreen(DISPLAY_BLACK);  // blank the screen.
+/**
+ * Draws the given step of the current frame.
+ */
+static void LcdHardware_DrawStep(LcdFrame* frame, uint32_t step) {
+  switch (frame->type) {
+    case LCDHARDWARE_INFO_FRAME:
+      LcdHardware_DrawInfoStep(frame, step);
+      break;
+    case LCDHARDWARE_BLANK_FRAME:
+      LcdHardware_FillBand(step);
+      break;
+    case LCDHARDWARE_STATS_FRAME:
+      LcdHardware_DrawStatsStep(frame, step);
+      break;
+    case LCDHARDWARE_TARGETS_FRAME:
+      LcdHardware_DrawTargetStep(frame);
+      break;
+    default:
+      break;
+  }
 }
 
-void LcdHardware_ShowStats(double average, double min, double max) {
-  display_setCursor(0, 0);  // set cursor to origin
-  display_setTextSize(TEXTSIZE_H2); // Make Text Larger
-  char str[MAX_STR_LEN];  // buffer for characters
+void LcdHardware_Init(LcdFrame* frame) {
+  display_init();
+  display_fillScreen(DISPLAY_BLACK);
+  LcdFrame_Init(frame);
+}
 
-  // Print all the stats
-  sprintf(str, "Average Time: %lf sec", average);
-  display_println(str);
-  sprintf(str, "Fastest Time: %lf sec", min);
-  display_println(str);
-  sprintf(str, "Slowest Time: %lf sec", max);
-  display_println(str);
+void LcdHardware_ShowInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore) {
+  LcdHardware_StartInfo(frame, highScores, length, newScore);
+  LcdHardware_Render(frame, LCDHARDWARE_NO_BUDGET);
+}
+
+void LcdHardware_StartInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore) {
+  if (length > LCDFRAME_MAX_SCORES) {
+    length = LCDFRAME_MAX_SCORES;
+  }
+  memset(frame->highScores, 0, sizeof(frame->highScores));
+  memcpy(frame->highScores, highScores, length * sizeof(uint32_t));
+  frame->newScore = newScore;
+  LcdFrame_Start(frame, LCDHARDWARE_INFO_FRAME);
+  frame->shownTargets = 0;  // the background covers them
+}
+
+void LcdHardware_BlankScreen(LcdFrame* frame) {
+  LcdHardware_StartBlankScreen(frame);
+  LcdHardware_Render(frame, LCDHARDWARE_NO_BUDGET);
+}
+
+void LcdHardware_StartBlankScreen(LcdFrame* frame) {
+  LcdFrame_Start(frame, LCDHARDWARE_BLANK_FRAME);
+  frame->shownTargets = 0;  // the background covers them
+}
+
+void LcdHardware_ShowStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max) {
+  LcdHardware_StartStats(frame, average, min, max);
+  LcdHardware_Render(frame, LCDHARDWARE_NO_BUDGET);
+}
+
+void LcdHardware_StartStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max) {
+  frame->average = average;
+  frame->min = min;
+  frame->max = max;
+  LcdFrame_Start(frame, LCDHARDWARE_STATS_FRAME);
+}
+
+void LcdHardware_ShowTargets(LcdFrame* frame, int32_t targets) {
+  LcdHardware_StartTargets(frame, targets);
+  LcdHardware_Render(frame, LCDHARDWARE_NO_BUDGET);
+}
+
+void LcdHardware_StartTargets(LcdFrame* frame, int32_t targets) {
+  targets &= (1 << LCDHARDWARE_NUMBER_OF_TARGETS) - 1;
+  frame->targets = targets;
+  frame->changedTargets = targets ^ frame->shownTargets;
+  LcdFrame_Start(frame, LCDHARDWARE_TARGETS_FRAME);
+}
+
+int32_t LcdHardware_GetTargetAt(int16_t x) {
+  if (x < 0 || x >= display_width()) {
+    return 0;
+  }
+  int32_t column = (x * LCDHARDWARE_NUMBER_OF_TARGETS) / display_width();
+  return 1 << (LCDHARDWARE_NUMBER_OF_TARGETS - 1 - column);
+}
+
+bool LcdHardware_Render(LcdFrame* frame, uint32_t budget) {
+  uint64_t start = globalTimer_getTimerValue();
+  uint64_t limit = (uint64_t) budget * GLOBAL_TIMER_TICKS_PER_US;
+  uint32_t steps = LcdHardware_GetNumberOfSteps(frame);
+  bool drewAStep = false;
+
+  while (frame->step < steps) {
+    LcdFrame_StepKind kind = LcdHardware_GetStepKind(frame, frame->step);
+    uint64_t before = globalTimer_getTimerValue();
+    if (drewAStep && budget != LCDHARDWARE_NO_BUDGET &&
+        !LcdFrame_NextStepFits(frame, kind, before - start, limit)) {
+      break;  // the next step might not fit, so leave it for the next call
+    }
+    LcdHardware_DrawStep(frame, frame->step);
+    drewAStep = true;
+    LcdFrame_FinishStep(frame, kind, globalTimer_getTimerValue() - before);
+  }
+  return LcdHardware_IsFrameDone(frame);
+}
 
+bool LcdHardware_IsFrameDone(const LcdFrame* frame) {
+  return frame->step >= LcdHardware_GetNumberOfSteps(frame);
 }
@@ -2,31 +2,128 @@
 #define LCDHARDWARE_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "LcdFrame.h"
+
+// Drawing a whole screen through the bit-banged LCD bus takes far longer
+// than a tick. Each frame is therefore split into small steps (a band of
+// the background, one line of text) that LcdHardware_Render() draws a few
+// at a time, within a budget, resuming where it stopped on the next call.
+// The Show functions draw a whole frame at once. Times are passed in
+// microseconds and printed as seconds. Every function draws into the
+// LcdFrame it is given, so each display or game keeps its own.
+
+// Budget for LcdHardware_Render() that draws the rest of the frame.
+#define LCDHARDWARE_NO_BUDGET UINT32_MAX
+// The background is cleared in this many horizontal bands.
+#define LCDHARDWARE_FILL_BANDS 16
+
+// One on-screen target per LED, side by side in columns across the screen in
+// the same order as the LEDs and buttons on the board: the target for LD3
+// and BTN3 on the left, LD0 and BTN0 on the right. A touch anywhere in a
+// column counts for its target.
+#define LCDHARDWARE_NUMBER_OF_TARGETS 4
+// The side of the square drawn for a target, in pixels.
+#define LCDHARDWARE_TARGET_SIZE 60
 
 /**
- * Initializes the LCD display.
+ * Initializes the LCD display, with no frame to draw.
+ * @param frame The display's frame.
  */
-void LcdHardware_Init(void);
+void LcdHardware_Init(LcdFrame* frame);
 
 /**
  * Displays instructions and the past high scores to the user.
- * @param highScores A pointer to the array of sorted high scores.
+ * @param frame      The display's frame.
+ * @param highScores A pointer to the array of sorted high scores in us.
+ * @param length     The number of high scores in the array.
+ * @param newScore   The score to highlight.
+ */
+void LcdHardware_ShowInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore);
+
+/**
+ * Starts a frame that shows instructions and the past high scores, to be
+ * drawn by LcdHardware_Render(). The scores are copied. A frame that is
+ * still being drawn is abandoned.
+ * @param frame      The display's frame.
+ * @param highScores A pointer to the array of sorted high scores in us.
  * @param length     The number of high scores in the array.
+ * @param newScore   The score to highlight.
  */
-void LcdHardware_ShowInfo(double* highScores, int32_t length, double newScore);
+void LcdHardware_StartInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore);
 
 /**
  * Blanks the screen entirely.
+ * @param frame The display's frame.
  */
-void LcdHardware_BlankScreen(void);
+void LcdHardware_BlankScreen(LcdFrame* frame);
+
+/**
+ * Starts a frame that blanks the screen, to be drawn by LcdHardware_Render().
+ * @param frame The display's frame.
+ */
+void LcdHardware_StartBlankScreen(LcdFrame* frame);
 
 /**
  * Displays the MIN, MAX, and AVERAGE response times
  * from the last round to the user.
- * @param average The average time the user took to respond that round.
+ * @param frame   The display's frame.
+ * @param average The average time the user took to respond that round in us.
+ * @param min     The fastest time the player recorded that round.
+ * @param max     The slowest time the player recorded that round.
+ */
+void LcdHardware_ShowStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max);
+
+/**
+ * Starts a frame that shows the round's response times, to be drawn by
+ * LcdHardware_Render().
+ * @param frame   The display's frame.
+ * @param average The average time the user took to respond that round in us.
  * @param min     The fastest time the player recorded that round.
  * @param max     The slowest time the player recorded that round.
  */
-void LcdHardware_ShowStats(double average, double min, double max);
+void LcdHardware_StartStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max);
+
+/**
+ * Lights the targets for the given LEDs and blanks the others.
+ * @param frame   The display's frame.
+ * @param targets One bit per target, as for the LEDs. 0 blanks them all.
+ */
+void LcdHardware_ShowTargets(LcdFrame* frame, int32_t targets);
+
+/**
+ * Starts a frame that lights the targets for the given LEDs and blanks the
+ * others, to be drawn by LcdHardware_Render(). Only the targets are drawn,
+ * so it can follow a blank screen cheaply.
+ * @param frame   The display's frame.
+ * @param targets One bit per target, as for the LEDs. 0 blanks them all.
+ */
+void LcdHardware_StartTargets(LcdFrame* frame, int32_t targets);
+
+/**
+ * Returns the target whose column contains a point on the screen. The
+ * columns are fixed, so this needs no frame and any game may call it.
+ * @param  x The point's distance from the left edge, in pixels.
+ * @return   One bit for the target, as for the LEDs, or 0 if the point is
+ *           off the screen.
+ */
+int32_t LcdHardware_GetTargetAt(int16_t x);
+
+/**
+ * Draws steps of the current frame until the next one might not fit in the
+ * budget. At least one step is drawn per call, so every frame finishes. The
+ * cost of a step is the longest seen so far for its kind.
+ * @param  frame  The display's frame.
+ * @param  budget Microseconds to spend, or LCDHARDWARE_NO_BUDGET.
+ * @return        TRUE once the frame is complete (or there is none).
+ */
+bool LcdHardware_Render(LcdFrame* frame, uint32_t budget);
+
+/**
+ * Returns whether the current frame has been drawn completely.
+ * @param  frame The display's frame.
+ * @return       FALSE while LcdHardware_Render() has steps left to draw.
+ */
+bool LcdHardware_IsFrameDone(const LcdFrame* frame);
 
 #endif /* LCDHARDWARE_H_ */
@@ -0,0 +1,180 @@
+#include "LcdMailbox.h"
+#include "LcdHardware.h"
+#include "ReflexTestData.h"
+#include "SpscQueue.h"
+#include "secondCore.h"
+#include <string.h>
+
+// Both cores reach the mailbox through the on-chip memory, which is set up
+// as uncached (see secondCore_start). The section is only in the board's
+// linker script.
+#if defined(__arm__) && !defined(TEST)
+#define LCDMAILBOX_SHARED __attribute__((section(".ocm_shared")))
+#else
+#define LCDMAILBOX_SHARED
+#endif
+
+typedef enum {
+  LCDMAILBOX_SHOW_INFO,
+  LCDMAILBOX_BLANK_SCREEN,
+  LCDMAILBOX_SHOW_STATS,
+  LCDMAILBOX_SHOW_TARGETS,
+} LcdMailbox_CommandType;
+
+/**
+ * One frame to draw, with copies of everything it shows.
+ */
+typedef struct {
+  uint32_t type;      // LcdMailbox_CommandType
+  int32_t length;     // number of highScores in use
+  uint32_t highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES];
+  uint32_t newScore;
+  uint32_t average;
+  uint32_t min;
+  uint32_t max;
+  int32_t targets;
+} LcdMailbox_Command;
+
+typedef struct {
+  SpscQueue queue;
+  LcdMailbox_Command commands[LCDMAILBOX_CAPACITY];
+  volatile uint32_t sent;    // commands queued, written by the first core
+  volatile uint32_t drawn;   // commands finished, written by the second core
+} LcdMailbox_Shared;
+
+static LcdMailbox_Shared mailbox LCDMAILBOX_SHARED;
+static bool remote = false;
+static LcdMailbox_DoneHandler doneHandler = NULL;
+
+/**
+ * Queues a command for the second core and wakes it up.
+ */
+static void LcdMailbox_Send(const LcdMailbox_Command* command) {
+  if (SpscQueue_Push(&mailbox.queue, command)) {
+    mailbox.sent++;
+    secondCore_notify();
+  }
+}
+
+void LcdMailbox_SetRemote(bool isRemote) {
+  remote = isRemote;
+}
+
+bool LcdMailbox_IsRemote() {
+  return remote;
+}
+
+void LcdMailbox_SetDoneHandler(LcdMailbox_DoneHandler handler) {
+  doneHandler = handler;
+}
+
+void LcdMailbox_Init(LcdFrame* frame) {
+  SpscQueue_Init(&mailbox.queue, mailbox.commands, sizeof(LcdMailbox_Command),
+                 LCDMAILBOX_CAPACITY);
+  mailbox.sent = 0;
+  mailbox.drawn = 0;
+  if (!remote) {
+    LcdHardware_Init(frame);
+  }
+}
+
+void LcdMailbox_ShowInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore) {
+  LcdMailbox_Command command;
+  if (!remote) {
+    LcdHardware_StartInfo(frame, highScores, length, newScore);
+    return;
+  }
+  if (length > REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES) {
+    length = REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES;
+  }
+  command.type = LCDMAILBOX_SHOW_INFO;
+  command.length = length;
+  memcpy(command.highScores, highScores, length * sizeof(uint32_t));
+  command.newScore = newScore;
+  LcdMailbox_Send(&command);
+}
+
+void LcdMailbox_BlankScreen(LcdFrame* frame) {
+  LcdMailbox_Command command;
+  if (!remote) {
+    LcdHardware_StartBlankScreen(frame);
+    return;
+  }
+  command.type = LCDMAILBOX_BLANK_SCREEN;
+  LcdMailbox_Send(&command);
+}
+
+void LcdMailbox_ShowStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max) {
+  LcdMailbox_Command command;
+  if (!remote) {
+    LcdHardware_StartStats(frame, average, min, max);
+    return;
+  }
+  command.type = LCDMAILBOX_SHOW_STATS;
+  command.average = average;
+  command.min = min;
+  command.max = max;
+  LcdMailbox_Send(&command);
+}
+
+void LcdMailbox_ShowTargets(LcdFrame* frame, int32_t targets) {
+  LcdMailbox_Command command;
+  if (!remote) {
+    LcdHardware_StartTargets(frame, targets);
+    return;
+  }
+  command.type = LCDMAILBOX_SHOW_TARGETS;
+  command.targets = targets;
+  LcdMailbox_Send(&command);
+}
+
+bool LcdMailbox_Render(LcdFrame* frame, uint32_t budget) {
+  if (remote) {
+    return LcdMailbox_GetPending() == 0;
+  }
+  return LcdHardware_Render(frame, budget);
+}
+
+bool LcdMailbox_Service(LcdFrame* frame) {
+  LcdMailbox_Command command;
+  if (!SpscQueue_Pop(&mailbox.queue, &command)) {
+    return false;
+  }
+  switch (command.type) {
+    case LCDMAILBOX_SHOW_INFO:
+      LcdHardware_ShowInfo(frame, command.highScores, command.length, command.newScore);
+      break;
+    case LCDMAILBOX_BLANK_SCREEN:
+      LcdHardware_BlankScreen(frame);
+      break;
+    case LCDMAILBOX_SHOW_STATS:
+      LcdHardware_ShowStats(frame, command.average, command.min, command.max);
+      break;
+    case LCDMAILBOX_SHOW_TARGETS:
+      LcdHardware_ShowTargets(frame, command.targets);
+      break;
+  }
+  mailbox.drawn++;
+  if (doneHandler != NULL && LcdMailbox_GetPending() == 0) {
+    doneHandler();
+  }
+  return true;
+}
+
+void LcdMailbox_RunRemote() {
+  LcdFrame frame;  // the second core owns the display, and so its frame
+  LcdHardware_Init(&frame);
+  for (;;) {
+    if (!LcdMailbox_Service(&frame)) {
+      secondCore_wait();
+    }
+  }
+}
+
+uint32_t LcdMailbox_GetPending() {
+  return remote ? mailbox.sent - mailbox.drawn : 0;
+}
+
+uint32_t LcdMailbox_GetDropped() {
+  return SpscQueue_GetDropped(&mailbox.queue);
+}
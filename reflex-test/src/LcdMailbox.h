@@ -0,0 +1,124 @@
+#ifndef LCDMAILBOX_H_
+#define LCDMAILBOX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "LcdFrame.h"
+
+// The LCD triad draws through the functions below instead of calling
+// LcdHardware directly. By default they start a frame in the caller's
+// LcdFrame, which LcdMailbox_Render() then draws a few steps at a time. In
+// remote mode the caller's frame is not used, and each
+// one only copies its arguments into a command and pushes it onto a
+// lock-free queue in on-chip memory; the second core, which owns the
+// display, pops the commands and draws them (LcdMailbox_RunRemote). The
+// tick then never waits on the panel.
+
+// Number of commands that can wait for the second core. A frame is one
+// command, and the game asks for at most a couple of frames a second.
+#define LCDMAILBOX_CAPACITY 8
+
+/**
+ * Called on the second core whenever it has drawn every command sent so far.
+ */
+typedef void (*LcdMailbox_DoneHandler)(void);
+
+/**
+ * Chooses whether commands are drawn by the caller or sent to the second
+ * core. Call before LcdMailbox_Init(); the mode survives it.
+ * @param remote TRUE to send commands to the second core.
+ */
+void LcdMailbox_SetRemote(bool remote);
+
+/**
+ * Returns whether commands are sent to the second core.
+ * @return TRUE in remote mode.
+ */
+bool LcdMailbox_IsRemote(void);
+
+/**
+ * Sets the function that the second core calls when it has caught up, so
+ * that the first core can be woken up rather than find out on its next
+ * tick. Call before the second core is started.
+ * @param handler The function to call, or NULL for none.
+ */
+void LcdMailbox_SetDoneHandler(LcdMailbox_DoneHandler handler);
+
+/**
+ * Empties the mailbox. When drawing locally, this also initializes the LCD;
+ * in remote mode the second core does that itself. Call before the second
+ * core is started.
+ * @param frame The caller's frame.
+ */
+void LcdMailbox_Init(LcdFrame* frame);
+
+/**
+ * Displays instructions and the past high scores, see LcdHardware_ShowInfo.
+ * In remote mode the scores are copied, so the caller may change them
+ * straight away.
+ * @param frame      The caller's frame.
+ * @param highScores A pointer to the array of sorted high scores in us.
+ * @param length     The number of high scores in the array.
+ * @param newScore   The score to highlight.
+ */
+void LcdMailbox_ShowInfo(LcdFrame* frame, uint32_t* highScores, int32_t length, uint32_t newScore);
+
+/**
+ * Blanks the screen entirely, see LcdHardware_BlankScreen.
+ * @param frame The caller's frame.
+ */
+void LcdMailbox_BlankScreen(LcdFrame* frame);
+
+/**
+ * Displays the round's response times, see LcdHardware_ShowStats.
+ * @param frame   The caller's frame.
+ * @param average The average time the user took to respond that round in us.
+ * @param min     The fastest time the player recorded that round.
+ * @param max     The slowest time the player recorded that round.
+ */
+void LcdMailbox_ShowStats(LcdFrame* frame, uint32_t average, uint32_t min, uint32_t max);
+
+/**
+ * Lights the targets for the given LEDs, see LcdHardware_ShowTargets.
+ * @param frame   The caller's frame.
+ * @param targets One bit per target, as for the LEDs. 0 blanks them all.
+ */
+void LcdMailbox_ShowTargets(LcdFrame* frame, int32_t targets);
+
+/**
+ * Draws as much of the current frame as fits in the budget, see
+ * LcdHardware_Render. In remote mode the second core draws instead, and
+ * this only reports whether it has caught up.
+ * @param  frame  The caller's frame.
+ * @param  budget Microseconds to spend, or LCDHARDWARE_NO_BUDGET.
+ * @return        TRUE once every frame asked for has been drawn.
+ */
+bool LcdMailbox_Render(LcdFrame* frame, uint32_t budget);
+
+/**
+ * Pops one command and draws it, then calls the done handler if that was
+ * the last one. Second core only.
+ * @param  frame The second core's frame.
+ * @return       FALSE if there was nothing to draw.
+ */
+bool LcdMailbox_Service(LcdFrame* frame);
+
+/**
+ * The second core's main loop: initializes the LCD, then draws commands as
+ * they arrive and sleeps in between. Never returns.
+ */
+void LcdMailbox_RunRemote(void);
+
+/**
+ * Returns the number of commands sent but not yet drawn.
+ * @return The number of frames the second core is behind.
+ */
+uint32_t LcdMailbox_GetPending(void);
+
+/**
+ * Returns how many commands were lost because the mailbox was full.
+ * @return The number of dropped commands.
+ */
+uint32_t LcdMailbox_GetDropped(void);
+
+#endif /* LCDMAILBOX_H_ */
@@ -1,25 +1,29 @@
 #include "LcdModel.h"
 
-void LcdModel_Init() {
+void LcdModel_Init(ReflexTest_Context* context) {
 
 }
 
-ReflexTest_st LcdModel_GetCurrentState() {
-  return ReflexTestData_GetCurrentState();
+ReflexTest_st LcdModel_GetCurrentState(ReflexTest_Context* context) {
+  return ReflexTestData_GetCurrentState(context);
 }
 
-double LcdModel_GetAverageResponseTime() {
-  return ReflexTestData_GetAverageResponseTime();
+uint32_t LcdModel_GetAverageResponseTime(ReflexTest_Context* context) {
+  return ReflexTestData_GetAverageResponseTime(context);
 }
 
-double LcdModel_GetMinResponseTime() {
-  return ReflexTestData_GetMinResponseTime();
+uint32_t LcdModel_GetMinResponseTime(ReflexTest_Context* context) {
+  return ReflexTestData_GetMinResponseTime(context);
 }
 
-double LcdModel_GetMaxResponseTime() {
-  return ReflexTestData_GetMaxResponseTime();
+uint32_t LcdModel_GetMaxResponseTime(ReflexTest_Context* context) {
+  return ReflexTestData_GetMaxResponseTime(context);
 }
 
-double* LcdModel_GetHighScores() {
-  return ReflexTestData_GetHighScores();
+uint32_t* LcdModel_GetHighScores(ReflexTest_Context* context) {
+  return ReflexTestData_GetHighScores(context);
+}
+
+int32_t LcdModel_GetTarget(ReflexTest_Context* context) {
+  return ReflexTestData_GetLed(context);
 }
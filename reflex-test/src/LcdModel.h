@@ -5,37 +5,50 @@
 
 /**
  * Initialization function for the LCD Model.
+ * @param context The game to work on.
  */
-void LcdModel_Init(void);
+void LcdModel_Init(ReflexTest_Context* context);
 
 /**
  * Called by the Conductor to get the current state from ReflexTestData
+ * @param  context The game to work on.
  * @return  returns the current state
  */
-ReflexTest_st LcdModel_GetCurrentState(void);
+ReflexTest_st LcdModel_GetCurrentState(ReflexTest_Context* context);
 
 /**
  * Gets the average response time for the player's last round.
- * @return The average response time for the player's last round.
+ * @param context The game to work on.
+ * @return The average response time for the player's last round in us.
  */
-double LcdModel_GetAverageResponseTime();
+uint32_t LcdModel_GetAverageResponseTime(ReflexTest_Context* context);
 
 /**
  * Gets the minimum response time for the player's last round.
- * @return The minimum response time for the player's last round.
+ * @param context The game to work on.
+ * @return The minimum response time for the player's last round in us.
  */
-double LcdModel_GetMinResponseTime();
+uint32_t LcdModel_GetMinResponseTime(ReflexTest_Context* context);
 
 /**
  * Gets the maximum response time for the player's last round.
- * @return The maximum response time for the player's last round.
+ * @param context The game to work on.
+ * @return The maximum response time for the player's last round in us.
  */
-double LcdModel_GetMaxResponseTime();
+uint32_t LcdModel_GetMaxResponseTime(ReflexTest_Context* context);
 
 /**
  * The 10 highest scores since the board has been turned on.
+ * @param context The game to work on.
  * @return A pointer to the array containing 10 highest scores.
  */
-double* LcdModel_GetHighScores();
+uint32_t* LcdModel_GetHighScores(ReflexTest_Context* context);
+
+/**
+ * Gets the target to light on the screen, which is the LED in play.
+ * @param context The game to work on.
+ * @return The LED's value, one bit per target.
+ */
+int32_t LcdModel_GetTarget(ReflexTest_Context* context);
 
 #endif /* LCDMODEL_H_ */
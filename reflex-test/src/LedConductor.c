@@ -1,52 +1,53 @@
 #include "LedConductor.h"
 #include "LedModel.h"
 #include "LedHardware.h"
-#include "intervalTimer.h"
 #include <stdint.h>
+#include <stddef.h>
 
-void LedConductor_Init() {
-  LedModel_Init();
-  LedHardware_Init();
+/**
+ * Turn off all of the LEDs at the beginning of each round.
+ */
+static void LedConductor_BlankLeds(ReflexTest_Context* context) {
+  LedHardware_BlankAllLeds(&context->leds);
 }
 
-void LedConductor_Run() {
+/**
+ * Get the current LED in the sequence and turn it on, remembering when.
+ */
+static void LedConductor_FlashLed(ReflexTest_Context* context) {
+  int32_t flashedLed = LedModel_GetLed(context);
+  uint64_t onset = LedHardware_Stimulus(&context->leds, flashedLed);
+  LedModel_SetStimulusTime(context, onset);
+}
+
+/**
+ * Increment the index, then turn off the LEDs.
+ */
+static void LedConductor_NextLed(ReflexTest_Context* context) {
+  LedModel_IncrementIndex(context);
+  LedHardware_BlankAllLeds(&context->leds);
+}
+
+// state actions. States that are not listed here do nothing.
+static const ReflexTest_Action LedConductor_Actions[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [show_info_st]      = LedConductor_BlankLeds,
+  [wait_info_st]      = LedConductor_BlankLeds,
+  [blink_led_st]      = LedConductor_FlashLed,
+  [button_pressed_st] = LedConductor_NextLed,
+};
+
+void LedConductor_Init(ReflexTest_Context* context) {
+  LedModel_Init(context);
+  LedHardware_Init(&context->leds);
+}
+
+ReflexTest_Action LedConductor_GetAction(ReflexTest_st state) {
+  return LedConductor_Actions[state];
+}
 
-  int32_t flashedLed = 0;
-  // state actions
-  switch (LedModel_GetCurrentState()) {
-    case init_st:
-      break;
-    case show_info_st:
-      // Turn off all of the LEDs at the begninning of each round.
-      LedHardware_BlankAllLeds();
-      break;
-    case wait_info_st:
-      // Turn off all of the LEDs at the begninning of each round.
-      LedHardware_BlankAllLeds();
-      break;
-    case wait_five_seconds_st:
-      break;
-    case blank_screen_st:
-      break;
-    case wait_between_flash_st:
-      break;
-    case blink_led_st:
-      // Get the current LED in the sequence and turn it on.
-      flashedLed = LedModel_GetLed();
-      LedHardware_Enable(flashedLed);
-      break;
-    case wait_for_button_st:
-      break;
-    case button_pressed_st:
-      // Increment the index, then turn off the LEDs.
-      LedModel_IncrementIndex();
-      LedHardware_BlankAllLeds();
-      break;
-    case show_stats_st:
-      break;
-    case wait_stats_st:
-      break;
-    case update_scores_st:
-      break;
+void LedConductor_Run(ReflexTest_Context* context) {
+  ReflexTest_Action action = LedConductor_GetAction(LedModel_GetCurrentState(context));
+  if (action != NULL) {
+    action(context);
   }
 }
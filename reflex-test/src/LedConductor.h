@@ -1,14 +1,25 @@
 #ifndef LEDCONDUCTOR_H_
 #define LEDCONDUCTOR_H_
 
+#include "ReflexTestData.h"
+
 /**
  * Initialization function for the LED triad.
+ * @param context The game to work on.
+ */
+void LedConductor_Init(ReflexTest_Context* context);
+
+/**
+ * Returns the LED action for the given state.
+ * @param  state The state to look up.
+ * @return       The action to perform, or NULL if there is nothing to do.
  */
-void LedConductor_Init(void);
+ReflexTest_Action LedConductor_GetAction(ReflexTest_st state);
 
 /**
  * Perform actions with the LEDs based on the current state.
+ * @param context The game to work on.
  */
-void LedConductor_Run(void);
+void LedConductor_Run(ReflexTest_Context* context);
 
 #endif /* LEDCONDUCTOR_H_ */
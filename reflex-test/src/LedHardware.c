@@ -1,17 +1,26 @@
 #include "LedHardware.h"
 #include "leds.h"
+#include "InputLog.h"
+#include "../vendor/supportFiles/globalTimer.h"
 #include <stdbool.h>
 #include <time.h>
 #include <stdlib.h>
 #include <stdio.h>
 
-void LedHardware_Init() {
+// Number of global timer ticks in one microsecond.
+#define LEDHARDWARE_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+
+void LedHardware_Init(LedShadow* shadow) {
   int32_t ledValue;
   ledValue = leds_init(false);  // call init on the hardware
-  printf("%ld\n", ledValue);
+  printf("%ld\n", (long) ledValue);
+  LedShadow_Init(shadow);
 }
 
-void LedHardware_Enable(int32_t ledNumber) {
+/**
+ * Returns the GPIO value that turns on the given LED.
+ */
+static int LedHardware_GetValue(int32_t ledNumber) {
   int value = 0;
   // Map kedNumber #s to corresponding LED #s
   switch (ledNumber) {
@@ -28,10 +37,32 @@ void LedHardware_Enable(int32_t ledNumber) {
       value = 0x8;
       break;
   }
+  return value;
+}
+
+/**
+ * Writes LD0-LD3 unless they already show the value.
+ */
+static void LedHardware_Write(LedShadow* shadow, int32_t value) {
+  if (LedShadow_Update(shadow, value)) {
+    leds_write(value);
+  }
+}
+
+void LedHardware_Enable(LedShadow* shadow, int32_t ledNumber) {
+  LedHardware_Write(shadow, LedHardware_GetValue(ledNumber));
+}
+
+uint64_t LedHardware_Stimulus(LedShadow* shadow, int32_t ledNumber) {
+  int value = LedHardware_GetValue(ledNumber);
+  uint64_t onset = globalTimer_getTimerValue();
   leds_write(value);
+  LedShadow_Force(shadow, value);
+  // The input log is only written once the LED is on.
+  return InputLog_Timestamp(onset / LEDHARDWARE_TICKS_PER_MICROSECOND);
 }
 
-void LedHardware_BlankAllLeds() {
+void LedHardware_BlankAllLeds(LedShadow* shadow) {
   // Turn off all of the LEDs
-  leds_write(0x0);
+  LedHardware_Write(shadow, 0x0);
 }
@@ -2,21 +2,40 @@
 #define LEDHARDWARE_H
 
 #include <stdint.h>
+#include "LedShadow.h"
+
+// LedHardware skips writes that would not change what the LEDs show. It
+// keeps track of them in the game's LedShadow.
 
 /**
- * Initialization function for the LED Hardware.
+ * Initialization function for the LED Hardware. Nothing is known to be on
+ * the LEDs yet, and no writes have been counted.
+ * @param shadow The game's LED shadow.
  */
-void LedHardware_Init(void);
+void LedHardware_Init(LedShadow* shadow);
 
 /**
  * Turns ON the specified LED.
+ * @param shadow    The game's LED shadow.
  * @param ledNumber The number of the LED to turn on.
  */
-void LedHardware_Enable(int32_t ledNumber);
+void LedHardware_Enable(LedShadow* shadow, int32_t ledNumber);
+
+/**
+ * Turns ON the specified LED and returns when it did, read from the global
+ * timer right before the GPIO write so that nothing else runs in between.
+ * This is the stimulus that response times are measured from, so the write
+ * always goes out.
+ * @param  shadow    The game's LED shadow.
+ * @param  ledNumber The number of the LED to turn on.
+ * @return           The time of the write in microseconds.
+ */
+uint64_t LedHardware_Stimulus(LedShadow* shadow, int32_t ledNumber);
 
 /**
  * Turns off ALL of the LEDs.
+ * @param shadow The game's LED shadow.
  */
-void LedHardware_BlankAllLeds(void);
+void LedHardware_BlankAllLeds(LedShadow* shadow);
 
 #endif /* LEDHARDWARE_H */
@@ -2,22 +2,26 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-void LedModel_Init() {
+void LedModel_Init(ReflexTest_Context* context) {
 
 }
 
-int32_t LedModel_GetLed() {
-  return ReflexTestData_GetLed();
+int32_t LedModel_GetLed(ReflexTest_Context* context) {
+  return ReflexTestData_GetLed(context);
 }
 
-void LedModel_IncrementIndex() {
-  ReflexTestData_IncrementIndex();
+void LedModel_SetStimulusTime(ReflexTest_Context* context, uint64_t timestamp) {
+  ReflexTestData_SetStimulusTime(context, timestamp);
 }
 
-bool LedModel_IsSequenceDone() {
-  return ReflexTestData_IsSequenceDone();
+void LedModel_IncrementIndex(ReflexTest_Context* context) {
+  ReflexTestData_IncrementIndex(context);
 }
 
-ReflexTest_st LedModel_GetCurrentState() {
-  return ReflexTestData_GetCurrentState();
+bool LedModel_IsSequenceDone(ReflexTest_Context* context) {
+  return ReflexTestData_IsSequenceDone(context);
+}
+
+ReflexTest_st LedModel_GetCurrentState(ReflexTest_Context* context) {
+  return ReflexTestData_GetCurrentState(context);
 }
@@ -6,24 +6,35 @@
 
 /**
  * Initialization function for the LED Model.
+ * @param context The game to work on.
  */
-void LedModel_Init();
+void LedModel_Init(ReflexTest_Context* context);
 
 /**
  * Returns the LED to flash in the sequence.
+ * @param context The game to work on.
  * @return The number of the LED to flash next.
  */
-int32_t LedModel_GetLed();
+int32_t LedModel_GetLed(ReflexTest_Context* context);
+
+/**
+ * Stores when the LED was turned on, for the timer model.
+ * @param context   The game to work on.
+ * @param timestamp The time of the stimulus in microseconds.
+ */
+void LedModel_SetStimulusTime(ReflexTest_Context* context, uint64_t timestamp);
 
 /**
  * Increments the Index of the ReflexTestData.
+ * @param context The game to work on.
  */
-void LedModel_IncrementIndex();
+void LedModel_IncrementIndex(ReflexTest_Context* context);
 
 /**
  * Called by the Conductor to get the current state from ReflexTestData
+ * @param  context The game to work on.
  * @return  returns the current state
  */
-ReflexTest_st LedModel_GetCurrentState(void);
+ReflexTest_st LedModel_GetCurrentState(ReflexTest_Context* context);
 
 #endif /* LEDMODEL_H_ */
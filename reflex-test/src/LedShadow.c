@@ -0,0 +1,29 @@
+#include "LedShadow.h"
+
+void LedShadow_Init(LedShadow* shadow) {
+  shadow->leds = LEDSHADOW_UNKNOWN;
+  shadow->issued = 0;
+  shadow->elided = 0;
+}
+
+bool LedShadow_Update(LedShadow* shadow, int32_t value) {
+  if (shadow->leds == value) {
+    shadow->elided++;
+    return false;
+  }
+  LedShadow_Force(shadow, value);
+  return true;
+}
+
+void LedShadow_Force(LedShadow* shadow, int32_t value) {
+  shadow->leds = value;
+  shadow->issued++;
+}
+
+uint32_t LedShadow_GetIssuedWrites(const LedShadow* shadow) {
+  return shadow->issued;
+}
+
+uint32_t LedShadow_GetElidedWrites(const LedShadow* shadow) {
+  return shadow->elided;
+}
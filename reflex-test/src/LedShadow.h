@@ -0,0 +1,64 @@
+#ifndef LEDSHADOW_H_
+#define LEDSHADOW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Each write to the LEDs is a GPIO write over the bus, and some states blank
+// the LEDs on every tick. A shadow remembers the last value written to them,
+// so that LedHardware can skip writes that would not change anything, and
+// counts the writes that went out and the ones that were skipped. Each game
+// keeps its own in its context.
+
+// What the shadow holds before the first write, so that it always goes out.
+#define LEDSHADOW_UNKNOWN -1
+
+/**
+ * The last value written to the LEDs, and how many writes went out or were
+ * skipped. The members should only be touched by LedShadow functions.
+ */
+typedef struct LedShadow {
+  int32_t leds;       // LD0-LD3 as given to leds_write(), or LEDSHADOW_UNKNOWN
+  uint32_t issued;    // writes that went out to the hardware
+  uint32_t elided;    // writes skipped because the LEDs already showed the value
+} LedShadow;
+
+/**
+ * Forgets what the LEDs show, and clears the counts.
+ * @param shadow The shadow.
+ */
+void LedShadow_Init(LedShadow* shadow);
+
+/**
+ * Returns whether a value has to be written for the LEDs to show it, and
+ * counts the write as issued or skipped. A value that has to be written is
+ * taken to be on the LEDs from then on.
+ * @param  shadow The shadow.
+ * @param  value  The value about to be written.
+ * @return        FALSE if the LEDs already show the value.
+ */
+bool LedShadow_Update(LedShadow* shadow, int32_t value);
+
+/**
+ * Records a value that was written whatever the LEDs showed.
+ * @param shadow The shadow.
+ * @param value  The value that was written.
+ */
+void LedShadow_Force(LedShadow* shadow, int32_t value);
+
+/**
+ * Returns how many writes went out to the LEDs since LedShadow_Init().
+ * @param  shadow The shadow.
+ * @return        The number of GPIO writes.
+ */
+uint32_t LedShadow_GetIssuedWrites(const LedShadow* shadow);
+
+/**
+ * Returns how many writes were skipped since LedShadow_Init() because the
+ * LEDs already showed the value.
+ * @param  shadow The shadow.
+ * @return        The number of writes skipped.
+ */
+uint32_t LedShadow_GetElidedWrites(const LedShadow* shadow);
+
+#endif /* LEDSHADOW_H_ */
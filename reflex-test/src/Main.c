@@ -1,4 +1,15 @@
 #include "Executor.h"
+#include "ReflexTestData.h"
+#include "Profiler.h"
+#include "InputLog.h"
+#include "Trace.h"
+#include "LcdMailbox.h"
+#include "Calibration.h"
+#include "TimerModel.h"
+#include "ButtonHardware.h"
+#include "LedShadow.h"
+#include "secondCore.h"
+#include "events.h"
 #include <stdio.h>
 #include <stdbool.h>
 #include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_types.h"
@@ -6,13 +17,118 @@
 #include "../vendor/supportFiles/utils.h"
 #include "../vendor/supportFiles/globalTimer.h"
 #include "../vendor/supportFiles/interrupts.h"
+#ifdef SPI_BENCHMARK
+#include "../vendor/supportFiles/spi.h"
+#endif
 
 
+#ifndef TOTAL_SECONDS
 #define TOTAL_SECONDS 604800  // 1 week of play time
+#endif
+
+// Room for the recorded input log. Build with DUMP_INPUT_LOG to print it
+// over the UART when the game ends, for replay on a PC; only that build
+// needs room for a long session. Define INPUT_LOG_BYTES to override either.
+#ifndef INPUT_LOG_BYTES
+#ifdef DUMP_INPUT_LOG
+#define INPUT_LOG_BYTES 0x1000000  // 16 MB
+#else
+#define INPUT_LOG_BYTES 0x10000    // 64 KB
+#endif
+#endif
+
+// Build with TRACE_DRAIN to print the state transition trace while the game
+// runs, a few entries at a time when the CPU would otherwise sleep.
+#ifndef TRACE_DRAIN_PER_IDLE
+#define TRACE_DRAIN_PER_IDLE 1
+#endif
 
-#define TIMER_PERIOD .001  // 1ms period
 #define TIMER_CLOCK_FREQUENCY ((XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ) / 2)
-#define TIMER_LOAD_VALUE (((TIMER_PERIOD) * (TIMER_CLOCK_FREQUENCY)) - 1.0)
+// Private timer load value for a tick period in microseconds.
+#define TIMER_LOAD_VALUE(us) ((u32) ((((uint64_t) (us) * (TIMER_CLOCK_FREQUENCY)) / 1000000) - 1))
+// Global timer cycles in a tick period in microseconds.
+#define TIMER_PERIOD_CYCLES(us) (((uint64_t) (us) * GLOBAL_TIMER_TICKS_PER_SECOND) / 1000000)
+
+// Build with SPI_BENCHMARK to time the touch controller's SPI bus at startup,
+// one byte per transaction against spi_transferBuffer() bursts.
+
+// Build with LCD_AMP to draw the LCD on the second core. The tick then only
+// posts a command to LcdMailbox and never waits on the panel.
+
+// The one game that this board runs.
+static ReflexTest_Context game;
+
+// Everything the game reads while it runs, see InputLog.h.
+static uint8_t inputLog[INPUT_LOG_BYTES];
+
+/**
+ * Sets the private timer to tick at the rate that the given state asks for.
+ * Loading the timer restarts its count, so the first tick in the new state
+ * is one new period away.
+ */
+static void setTickPeriod(ReflexTest_st state) {
+  interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE(Executor_GetTickPeriod(state)));
+}
+
+/**
+ * Measures what the timing itself costs and has the game take it out of
+ * every response. The costs are the board's, so this runs once at startup,
+ * after Executor_Init has started the LEDs and the timers.
+ */
+static void calibrate(void) {
+  Calibration_Run();
+  TimerModel_SetOverhead(&game, Calibration_GetStimulusOverhead());
+}
+
+/**
+ * Gives every state the tick budget of its own period: each tick of the
+ * control loop has one timer period to finish.
+ */
+static void setTickBudgets(void) {
+  int32_t state;
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    Profiler_SetTickBudget(state, TIMER_PERIOD_CYCLES(Executor_GetTickPeriod(state)));
+  }
+}
+
+/**
+ * Runs the executor once, counting the LED writes it makes.
+ * @param  state The state the game was in before the run.
+ * @return       The state the game moved to.
+ */
+static ReflexTest_st runExecutor(ReflexTest_st state) {
+  uint32_t issuedLedWrites = LedShadow_GetIssuedWrites(&game.leds);
+  uint32_t elidedLedWrites = LedShadow_GetElidedWrites(&game.leds);
+  Executor_Run(&game);
+  Profiler_RecordLedWrites(state, LedShadow_GetIssuedWrites(&game.leds) - issuedLedWrites,
+                           LedShadow_GetElidedWrites(&game.leds) - elidedLedWrites);
+  return ReflexTestData_GetCurrentState(&game);
+}
+
+/**
+ * Follows the game into the state that it moved to: the input log marks
+ * the change and the tick rate follows it. Call once the tick has been
+ * recorded, because a new tick rate also resets the profiler's budget.
+ * @param state     The state the game was in before the run.
+ * @param nextState The state the game moved to.
+ */
+static void followState(ReflexTest_st state, ReflexTest_st nextState) {
+  if (nextState != state) {
+    InputLog_State(nextState);
+    if (Executor_GetTickPeriod(nextState) != Executor_GetTickPeriod(state)) {
+      setTickPeriod(nextState);
+    }
+  }
+}
+
+#ifdef LCD_AMP
+/**
+ * Runs on the second core once it has drawn every frame sent to it.
+ */
+static void postRenderDone(void) {
+  events_post(EVENTS_RENDER_DONE);
+}
+#endif
 
 int runReflexTest() {
   // Initialize the GPIO LED driver and print out an error message if it fails (argument = true).
@@ -20,14 +136,44 @@ int runReflexTest() {
   // Init all interrupts (but does not enable the interrupts at the devices).
   // Prints an error message if an internal failure occurs because the argument = true.
   interrupts_initAll(true);
-  interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE);
+  interrupts_setPrivateTimerLoadValue(TIMER_LOAD_VALUE(EXECUTOR_DEFAULT_TICK_PERIOD));
   u32 privateTimerTicksPerSecond = interrupts_getPrivateTimerTicksPerSecond();
   printf("private timer ticks per second: %ld\n\r", privateTimerTicksPerSecond);
   // Allow the timer to generate interrupts.
   interrupts_enableTimerGlobalInts();
-  Executor_Init();
+  events_init();
+  Profiler_Init();
+  setTickBudgets();
+  // Record from the very first input so that replay starts in step.
+  InputLog_StartRecording(inputLog, sizeof(inputLog));
+  Trace_Init();
+#ifdef LCD_AMP
+  LcdMailbox_SetRemote(true);
+  LcdMailbox_SetDoneHandler(postRenderDone);
+#endif
+  // Also starts the global timer, which the profiler uses to measure how
+  // long the CPU is busy.
+  Executor_Init(&game);
+  calibrate();
+  Calibration_Print();
+#ifdef SPI_BENCHMARK
+  // The touch controller has started the SPI controller by now.
+  spi_runBenchmark();
+#endif
+#ifdef LCD_AMP
+  // The mailbox is empty now, so the second core can start taking commands.
+  secondCore_start(LcdMailbox_RunRemote);
+#endif
+  // The tick rate changes with the state, so play time is measured on the
+  // global timer rather than by counting ticks.
+  u64 endTime = globalTimer_getTimerValue() + ((u64) TOTAL_SECONDS * GLOBAL_TIMER_TICKS_PER_SECOND);
   // Keep track of your personal interrupt count. Want to make sure that you don't miss any interrupts.
   int32_t personalInterruptCount = 0;
+  // Interrupts that fired while a tick was still running and were never
+  // handled, because interrupts_isrFlagGlobal only remembers one.
+  int32_t lostInterruptCount = 0;
+  ReflexTest_st lastTickState = ReflexTestData_GetCurrentState(&game);
+  setTickPeriod(lastTickState);
   // Start the private ARM timer running.
   interrupts_startArmPrivateTimer();
   // Enable interrupts at the ARM.
@@ -35,25 +181,77 @@ int runReflexTest() {
   // interrupts_isrInvocationCount() returns the number of times that the timer ISR was invoked.
   // This value is maintained by the timer ISR. Compare this number with your own local
   // interrupt count to determine if you have missed any interrupts.
-  while (interrupts_isrInvocationCount() < (TOTAL_SECONDS * privateTimerTicksPerSecond)) {
-    if (interrupts_isrFlagGlobal) {  // This is a global flag that is set by the timer interrupt handler.
+  u64 idleStart = globalTimer_getTimerValue();
+  while (globalTimer_getTimerValue() < endTime) {
+    // Sleep until an interrupt posts an event, rather than spinning on
+    // interrupts_isrFlagGlobal.
+    uint32_t events = events_wait();
+    u64 busyStart = globalTimer_getTimerValue();
+    ReflexTest_st state = ReflexTestData_GetCurrentState(&game);
+    Profiler_RecordIdle(state, busyStart - idleStart);
+
+    if (events & EVENTS_TIMER_TICK) {  // Posted by the timer interrupt handler.
       // Count ticks.
       personalInterruptCount++;
-      Executor_Run();
+      int32_t lost = (int32_t) interrupts_isrInvocationCount() - personalInterruptCount;
+      if (lost > lostInterruptCount) {
+        // The previous tick ran long enough to swallow them.
+        Profiler_RecordMissedTicks(lastTickState, lost - lostInterruptCount);
+        lostInterruptCount = lost;
+      }
+      ReflexTest_st nextState = runExecutor(state);
+      Profiler_RecordTick(state, busyStart, globalTimer_getTimerValue());
+      followState(state, nextState);
+      lastTickState = state;
       interrupts_isrFlagGlobal = 0;
     }
+    else if (events & (EVENTS_BUTTON_EDGE | EVENTS_RENDER_DONE)) {
+      // Posted by the button and touch interrupt handlers and by the second
+      // core. A press or a finished frame is work for the game now rather
+      // than a tick from now. Waits are absolute deadlines, so running
+      // between ticks never changes how long one lasts. These runs are not
+      // ticks, so they stay out of the tick statistics.
+      followState(state, runExecutor(state));
+    }
+
+#ifdef TRACE_DRAIN
+    Trace_Drain(TRACE_DRAIN_PER_IDLE);
+#endif
+
+    idleStart = globalTimer_getTimerValue();
+    Profiler_RecordBusy(state, idleStart - busyStart);
   }
   interrupts_disableArmInts();
   printf("isr invocation count: %ld\n\r", interrupts_isrInvocationCount());
-  printf("internal interrupt count: %ld\n\r", personalInterruptCount);
+  printf("internal interrupt count: %ld\n\r", (long) personalInterruptCount);
+  Profiler_Print();
+  Profiler_PrintTicks();
+  Profiler_PrintLedWrites();
+  ButtonHardware_PrintBounceStats(&game.debounce);
+  InputLog_Stop();
+  printf("input log: %lu bytes%s\n\r", (unsigned long) InputLog_GetSize(),
+         InputLog_IsFull() ? " (full, recording stopped early)" : "");
+#ifdef DUMP_INPUT_LOG
+  InputLog_Print();
+#endif
+#ifdef TRACE_DRAIN
+  Trace_Drain(UINT32_MAX);
+#endif
+  printf("trace: %lu entries not drained, %lu dropped\n\r", (unsigned long) Trace_GetCount(),
+         (unsigned long) Trace_GetDropped());
+  if (LcdMailbox_IsRemote()) {
+    printf("lcd mailbox: %lu frames not drawn yet, %lu dropped\n\r",
+           (unsigned long) LcdMailbox_GetPending(), (unsigned long) LcdMailbox_GetDropped());
+  }
   return 0;
 }
 
 
 int AppMain(void) {
-  Executor_Init();
+  Executor_Init(&game);
+  calibrate();
 
-  while(Executor_Run());
+  while(Executor_Run(&game));
 
   return 0;
 }
@@ -0,0 +1,210 @@
+#include "Profiler.h"
+#include <stdio.h>
+
+// Time spent busy and asleep in each state, in timer cycles.
+static uint64_t busyCycles[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint64_t idleCycles[REFLEXTESTDATA_NUMBER_OF_STATES];
+
+// Executor_Run timing, see Profiler_RecordTick().
+static uint64_t tickBudget[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint32_t ticks[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint32_t overruns[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint32_t missedTicks[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint64_t longestTick[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint32_t tickHistogram[REFLEXTESTDATA_NUMBER_OF_STATES][PROFILER_NUMBER_OF_TICK_BUCKETS];
+static uint64_t previousTickStart;
+static uint64_t previousTickBudget;
+static bool tickStarted;
+static uint64_t maxJitter;
+
+// LED writes, see Profiler_RecordLedWrites().
+static uint32_t issuedLedWrites[REFLEXTESTDATA_NUMBER_OF_STATES];
+static uint32_t elidedLedWrites[REFLEXTESTDATA_NUMBER_OF_STATES];
+
+void Profiler_Init() {
+  int i, j;
+  for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_STATES; i++) {
+    busyCycles[i] = 0;
+    idleCycles[i] = 0;
+    ticks[i] = 0;
+    overruns[i] = 0;
+    missedTicks[i] = 0;
+    longestTick[i] = 0;
+    tickBudget[i] = 0;
+    issuedLedWrites[i] = 0;
+    elidedLedWrites[i] = 0;
+    for (j = 0; j < PROFILER_NUMBER_OF_TICK_BUCKETS; j++) {
+      tickHistogram[i][j] = 0;
+    }
+  }
+  tickStarted = false;
+  maxJitter = 0;
+}
+
+void Profiler_RecordBusy(ReflexTest_st state, uint64_t cycles) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    busyCycles[state] += cycles;
+  }
+}
+
+void Profiler_RecordIdle(ReflexTest_st state, uint64_t cycles) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    idleCycles[state] += cycles;
+  }
+}
+
+uint64_t Profiler_GetBusyCycles(ReflexTest_st state) {
+  return busyCycles[state];
+}
+
+uint64_t Profiler_GetIdleCycles(ReflexTest_st state) {
+  return idleCycles[state];
+}
+
+uint32_t Profiler_GetBusyPercent(ReflexTest_st state) {
+  uint64_t total = busyCycles[state] + idleCycles[state];
+  if (total == 0) {
+    return 0;
+  }
+  return (uint32_t)((busyCycles[state] * 100) / total);
+}
+
+void Profiler_Print() {
+  int i;
+  printf("CPU busy per state:\n\r");
+  for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_STATES; i++) {
+    if (busyCycles[i] + idleCycles[i] != 0) {
+      printf("  %-22s %3lu%%\n\r", ReflexTestData_GetStateName(i),
+             (unsigned long)Profiler_GetBusyPercent(i));
+    }
+  }
+}
+
+void Profiler_SetTickBudget(ReflexTest_st state, uint64_t cycles) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    tickBudget[state] = cycles;
+  }
+}
+
+uint64_t Profiler_GetTickBudget(ReflexTest_st state) {
+  return tickBudget[state];
+}
+
+// Finds the histogram bucket for a tick that took the given time.
+static uint32_t Profiler_GetBucket(uint64_t budget, uint64_t cycles) {
+  uint32_t bucket = 0;
+  uint64_t limit = budget >> PROFILER_BUDGET_BUCKET;
+  while (bucket < PROFILER_NUMBER_OF_TICK_BUCKETS - 1 && cycles >= limit) {
+    bucket++;
+    limit <<= 1;
+  }
+  return bucket;
+}
+
+void Profiler_RecordTick(ReflexTest_st state, uint64_t start, uint64_t end) {
+  uint64_t cycles = end - start;
+  uint64_t budget;
+  if (state >= REFLEXTESTDATA_NUMBER_OF_STATES) {
+    return;
+  }
+  budget = tickBudget[state];
+  ticks[state]++;
+  if (cycles > longestTick[state]) {
+    longestTick[state] = cycles;
+  }
+  if (budget != 0) {
+    tickHistogram[state][Profiler_GetBucket(budget, cycles)]++;
+    if (cycles > budget) {
+      overruns[state]++;
+    }
+    // After a change of budget the timer was restarted at the new rate, so
+    // the time since the last tick is not jitter.
+    if (tickStarted && budget == previousTickBudget) {
+      uint64_t period = start - previousTickStart;
+      uint64_t jitter = (period > budget) ? period - budget : budget - period;
+      if (jitter > maxJitter) {
+        maxJitter = jitter;
+      }
+    }
+  }
+  previousTickStart = start;
+  previousTickBudget = budget;
+  tickStarted = true;
+}
+
+void Profiler_RecordMissedTicks(ReflexTest_st state, uint32_t count) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    missedTicks[state] += count;
+  }
+}
+
+void Profiler_RecordLedWrites(ReflexTest_st state, uint32_t issued, uint32_t elided) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    issuedLedWrites[state] += issued;
+    elidedLedWrites[state] += elided;
+  }
+}
+
+uint32_t Profiler_GetIssuedLedWrites(ReflexTest_st state) {
+  return issuedLedWrites[state];
+}
+
+uint32_t Profiler_GetElidedLedWrites(ReflexTest_st state) {
+  return elidedLedWrites[state];
+}
+
+void Profiler_PrintLedWrites() {
+  int i;
+  printf("LED writes per state:\n\r");
+  printf("  %-22s %10s %10s\n\r", "state", "issued", "elided");
+  for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_STATES; i++) {
+    if (issuedLedWrites[i] + elidedLedWrites[i] != 0) {
+      printf("  %-22s %10lu %10lu\n\r", ReflexTestData_GetStateName(i),
+             (unsigned long)issuedLedWrites[i], (unsigned long)elidedLedWrites[i]);
+    }
+  }
+}
+
+uint32_t Profiler_GetTicks(ReflexTest_st state) {
+  return ticks[state];
+}
+
+uint32_t Profiler_GetOverruns(ReflexTest_st state) {
+  return overruns[state];
+}
+
+uint32_t Profiler_GetMissedTicks(ReflexTest_st state) {
+  return missedTicks[state];
+}
+
+uint64_t Profiler_GetLongestTick(ReflexTest_st state) {
+  return longestTick[state];
+}
+
+uint32_t Profiler_GetTickHistogram(ReflexTest_st state, uint32_t bucket) {
+  return tickHistogram[state][bucket];
+}
+
+uint64_t Profiler_GetMaxJitter() {
+  return maxJitter;
+}
+
+void Profiler_PrintTicks() {
+  int i, j;
+  printf("Executor ticks per state (budget and longest in cycles):\n\r");
+  printf("  %-22s %10s %10s %8s %8s %10s  histogram (<1/64 budget ... >2x budget)\n\r",
+         "state", "budget", "ticks", "overrun", "missed", "longest");
+  for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_STATES; i++) {
+    if (ticks[i] == 0 && missedTicks[i] == 0) {
+      continue;
+    }
+    printf("  %-22s %10lu %10lu %8lu %8lu %10lu ", ReflexTestData_GetStateName(i),
+           (unsigned long)tickBudget[i], (unsigned long)ticks[i], (unsigned long)overruns[i],
+           (unsigned long)missedTicks[i], (unsigned long)longestTick[i]);
+    for (j = 0; j < PROFILER_NUMBER_OF_TICK_BUCKETS; j++) {
+      printf(" %lu", (unsigned long)tickHistogram[i][j]);
+    }
+    printf("\n\r");
+  }
+  printf("  worst jitter: %lu cycles\n\r", (unsigned long)maxJitter);
+}
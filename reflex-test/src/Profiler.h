@@ -0,0 +1,171 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "ReflexTestData.h"
+#include <stdint.h>
+
+// Executor_Run times are kept in a histogram per state. Each state has its
+// own tick budget, since the tick period depends on the state. Bucket b
+// holds ticks that took less than budget * 2^(b - 6) cycles, so buckets 0-6 are
+// within the budget (bucket 6 is the top half of it), bucket 7 is up to
+// twice the budget and bucket 8 is everything slower.
+#define PROFILER_NUMBER_OF_TICK_BUCKETS 9
+#define PROFILER_BUDGET_BUCKET 6
+
+/**
+ * Clears all of the profiling data.
+ */
+void Profiler_Init(void);
+
+/**
+ * Adds time that the CPU spent doing work while in the given state.
+ * @param state  The state the executor was in.
+ * @param cycles How long the CPU was busy, in timer cycles.
+ */
+void Profiler_RecordBusy(ReflexTest_st state, uint64_t cycles);
+
+/**
+ * Adds time that the CPU spent asleep while in the given state.
+ * @param state  The state the executor was in.
+ * @param cycles How long the CPU was asleep, in timer cycles.
+ */
+void Profiler_RecordIdle(ReflexTest_st state, uint64_t cycles);
+
+/**
+ * Returns the total busy time recorded for the given state.
+ * @param  state The state to look up.
+ * @return       The busy time in timer cycles.
+ */
+uint64_t Profiler_GetBusyCycles(ReflexTest_st state);
+
+/**
+ * Returns the total idle time recorded for the given state.
+ * @param  state The state to look up.
+ * @return       The idle time in timer cycles.
+ */
+uint64_t Profiler_GetIdleCycles(ReflexTest_st state);
+
+/**
+ * Returns how busy the CPU was while in the given state.
+ * @param  state The state to look up.
+ * @return       The busy percentage (0-100), or 0 if no time was recorded.
+ */
+uint32_t Profiler_GetBusyPercent(ReflexTest_st state);
+
+/**
+ * Prints the busy percentage of every state that recorded any time.
+ */
+void Profiler_Print(void);
+
+/**
+ * Sets how long one tick of the control loop may take in the given state.
+ * Ticks recorded with Profiler_RecordTick() that take longer are counted as
+ * overruns. Until a state has a budget, its ticks are counted but not
+ * checked. Jitter is only measured between consecutive ticks under the same
+ * budget, because a new tick rate restarts the timer.
+ * @param state  The state.
+ * @param cycles The state's tick period in timer cycles.
+ */
+void Profiler_SetTickBudget(ReflexTest_st state, uint64_t cycles);
+
+/**
+ * Returns the tick budget of the given state.
+ * @param  state The state to look up.
+ * @return       The budget in timer cycles, or 0 if none was set.
+ */
+uint64_t Profiler_GetTickBudget(ReflexTest_st state);
+
+/**
+ * Records one run of the executor.
+ * @param state The state the executor was in when the tick started.
+ * @param start When the tick started, in timer cycles.
+ * @param end   When the tick finished, in timer cycles.
+ */
+void Profiler_RecordTick(ReflexTest_st state, uint64_t start, uint64_t end);
+
+/**
+ * Records timer interrupts that were never handled because an earlier tick
+ * was still running when they fired.
+ * @param state The state the executor was in during the late tick.
+ * @param ticks How many interrupts were lost.
+ */
+void Profiler_RecordMissedTicks(ReflexTest_st state, uint32_t ticks);
+
+/**
+ * Returns how many ticks were recorded in the given state.
+ * @param  state The state to look up.
+ * @return       The number of ticks.
+ */
+uint32_t Profiler_GetTicks(ReflexTest_st state);
+
+/**
+ * Returns how many ticks in the given state took longer than the budget.
+ * @param  state The state to look up.
+ * @return       The number of overruns.
+ */
+uint32_t Profiler_GetOverruns(ReflexTest_st state);
+
+/**
+ * Returns how many timer interrupts were lost in the given state.
+ * @param  state The state to look up.
+ * @return       The number of lost interrupts.
+ */
+uint32_t Profiler_GetMissedTicks(ReflexTest_st state);
+
+/**
+ * Returns the longest tick recorded in the given state.
+ * @param  state The state to look up.
+ * @return       The longest tick in timer cycles.
+ */
+uint64_t Profiler_GetLongestTick(ReflexTest_st state);
+
+/**
+ * Returns how many ticks in the given state fell in a histogram bucket.
+ * @param  state  The state to look up.
+ * @param  bucket The bucket, 0 to PROFILER_NUMBER_OF_TICK_BUCKETS - 1.
+ * @return        The number of ticks in the bucket.
+ */
+uint32_t Profiler_GetTickHistogram(ReflexTest_st state, uint32_t bucket);
+
+/**
+ * Returns the largest difference between the time between two consecutive
+ * ticks under the same budget and that budget, early or late.
+ * @return The jitter in timer cycles.
+ */
+uint64_t Profiler_GetMaxJitter(void);
+
+/**
+ * Adds writes to the LEDs made while in the given state, see LedShadow.h.
+ * @param state  The state the executor was in.
+ * @param issued How many writes went out to the hardware.
+ * @param elided How many writes were skipped because they changed nothing.
+ */
+void Profiler_RecordLedWrites(ReflexTest_st state, uint32_t issued, uint32_t elided);
+
+/**
+ * Returns how many LED writes went out to the hardware in the given state.
+ * @param  state The state to look up.
+ * @return       The number of writes issued.
+ */
+uint32_t Profiler_GetIssuedLedWrites(ReflexTest_st state);
+
+/**
+ * Returns how many LED writes were skipped in the given state.
+ * @param  state The state to look up.
+ * @return       The number of writes elided.
+ */
+uint32_t Profiler_GetElidedLedWrites(ReflexTest_st state);
+
+/**
+ * Prints the LED writes issued and elided in every state that made any.
+ */
+void Profiler_PrintLedWrites(void);
+
+/**
+ * Prints the budget, tick count, overruns, lost interrupts, longest tick and
+ * histogram of every state that ran, and the worst jitter. Can be called
+ * at any time.
+ */
+void Profiler_PrintTicks(void);
+
+#endif /* PROFILER_H_ */
@@ -10,152 +10,228 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-static uint32_t sequence[REFLEXTESTDATA_SEQUENCE_LENGTH];
-static int32_t index = 0;
-static int32_t pressedButton = 0;
-static double responseTime;
-static ReflexTest_st currentState = init_st;
-static double min = 5.0;
-static double max = 0.0;
-static double average = 0.0;
-static double highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES];
-
-void ReflexTestData_Init() {
-  // Initialize all of the global variables.
-  index = 0;
-  pressedButton = 0;
-  responseTime = 0.0;
-  min = 5.0;
-  max = 0.0;
-  average = 0.0;
-  currentState = init_st;
+// Printable names for each of the states.
+static const char* stateNames[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  "init_st",
+  "show_info_st",
+  "wait_info_st",
+  "wait_five_seconds_st",
+  "blank_screen_st",
+  "blink_led_st",
+  "wait_for_button_st",
+  "button_pressed_st",
+  "wait_between_flash_st",
+  "show_stats_st",
+  "wait_stats_st",
+  "update_scores_st",
+};
+
+void ReflexTestData_Init(ReflexTest_Context* context) {
+  // Initialize all of the game's variables.
+  context->index = 0;
+  context->pressedButton = 0;
+  context->stimulusTime = 0;
+  context->pressTime = 0;
+  context->anticipated = false;
+  context->falseStarts = 0;
+  context->wrongPresses = 0;
+  context->wrongResponses = 0;
+  context->wrongLatency = 0;
+  context->responseTime = 0;
+  context->min = REFLEXTESTDATA_SLOWEST_RESPONSE_TIME;
+  context->max = 0;
+  context->average = 0;
+  context->currentState = init_st;
+  context->randomSeed = 1;
 
   int i;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
-    sequence[i] = 0;
-    highScores[i] = 5.0;  // initialize high scores to slow values
+    context->sequence[i] = 0;
+    context->highScores[i] = REFLEXTESTDATA_SLOWEST_RESPONSE_TIME;  // initialize high scores to slow values
   }
 }
 
-bool ReflexTestData_IsSequenceDone() {
-  return (index == (REFLEXTESTDATA_SEQUENCE_LENGTH));
+bool ReflexTestData_IsSequenceDone(ReflexTest_Context* context) {
+  return (context->index == (REFLEXTESTDATA_SEQUENCE_LENGTH));
 }
 
-int32_t ReflexTestData_GetLed() {
+int32_t ReflexTestData_GetLed(ReflexTest_Context* context) {
   // Return the value of the current LED
-  if (index < REFLEXTESTDATA_SEQUENCE_LENGTH) {
-   return sequence[index];
+  if (context->index < REFLEXTESTDATA_SEQUENCE_LENGTH) {
+   return context->sequence[context->index];
   }
   else {
     return REFLEXTESTDATA_ERROR;
   }
 }
 
-void ReflexTestData_IncrementIndex() {
-  if (index < REFLEXTESTDATA_SEQUENCE_LENGTH) {
-    index++;
+void ReflexTestData_IncrementIndex(ReflexTest_Context* context) {
+  if (context->index < REFLEXTESTDATA_SEQUENCE_LENGTH) {
+    context->index++;
   }
 }
 
-int32_t ReflexTestData_GetCurrentIndex() {
-  return index;
+int32_t ReflexTestData_GetCurrentIndex(ReflexTest_Context* context) {
+  return context->index;
 }
 
 /**
  * Helper function that prints our the contents of the generated sequence.
  */
-void ReflexTestData_PrintSequence() {
+void ReflexTestData_PrintSequence(ReflexTest_Context* context) {
   int i;
   printf("{");
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH-1; i++) {
-    printf("%lu, ", sequence[i]);
+    printf("%lu, ", (unsigned long) context->sequence[i]);
   }
-  printf("%lu};\n", sequence[REFLEXTESTDATA_SEQUENCE_LENGTH-1]);
+  printf("%lu};\n", (unsigned long) context->sequence[REFLEXTESTDATA_SEQUENCE_LENGTH-1]);
 }
 
-uint32_t* ReflexTestData_GenerateSequence(int32_t seed) {
+uint32_t* ReflexTestData_GenerateSequence(ReflexTest_Context* context, int32_t seed) {
 
-  index = 0; //reset the global index whenever a new sequence is generated
+  context->index = 0; //reset the index whenever a new sequence is generated
+  context->wrongPresses = 0;
+  context->wrongResponses = 0;
+  context->wrongLatency = 0;
 
-  srand(seed); //initialize random number generator
+  // Each game has its own random number generator so games don't interfere.
+  context->randomSeed = seed;
   int i;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
     // Generate values between 1-4
-    sequence[i] = (rand() % REFLEXTESTDATA_NUMBER_OF_LEDS) + 1;
+    context->sequence[i] = (rand_r(&context->randomSeed) % REFLEXTESTDATA_NUMBER_OF_LEDS) + 1;
   }
 
 #ifdef REFLEXTESTDATA_DEBUG
-  ReflexTestData_PrintSequence();
+  ReflexTestData_PrintSequence(context);
 #endif
 
-  return sequence;
+  return context->sequence;
 }
 
-int32_t ReflexTestData_GetPressedButton() {
-  return pressedButton;
+int32_t ReflexTestData_GetPressedButton(ReflexTest_Context* context) {
+  return context->pressedButton;
 }
 
-void ReflexTestData_SetPressedButton(int32_t value) {
-  pressedButton = value;
+void ReflexTestData_SetPressedButton(ReflexTest_Context* context, int32_t value) {
+  context->pressedButton = value;
 }
 
-void ReflexTestData_SetCurrentState(ReflexTest_st newState) {
-  currentState = newState;
+void ReflexTestData_SetStimulusTime(ReflexTest_Context* context, uint64_t timestamp) {
+  context->stimulusTime = timestamp;
 }
 
-ReflexTest_st ReflexTestData_GetCurrentState() {
-  return currentState;
+uint64_t ReflexTestData_GetStimulusTime(ReflexTest_Context* context) {
+  return context->stimulusTime;
 }
 
-bool ReflexTestData_IsCorrectButtonPressed() {
-  return (pressedButton == sequence[index]);
+void ReflexTestData_SetPressTime(ReflexTest_Context* context, uint64_t timestamp) {
+  context->pressTime = timestamp;
 }
 
-void ReflexTestData_SetResponseTime(double inputTime) {
-  responseTime = inputTime;
+uint64_t ReflexTestData_GetPressTime(ReflexTest_Context* context) {
+  return context->pressTime;
 }
 
-double ReflexTestData_GetResponseTime() {
-  return responseTime;
+void ReflexTestData_SetAnticipated(ReflexTest_Context* context, bool anticipated) {
+  context->anticipated = anticipated;
 }
 
-void ReflexTestData_SetMinResponseTime(double responseTime) {
-  min = responseTime;
+bool ReflexTestData_IsAnticipated(ReflexTest_Context* context) {
+  return context->anticipated;
 }
 
-double ReflexTestData_GetMinResponseTime() {
-  return min;
+void ReflexTestData_SetFalseStarts(ReflexTest_Context* context, uint32_t falseStarts) {
+  context->falseStarts = falseStarts;
 }
 
-void ReflexTestData_SetMaxResponseTime(double responseTime) {
-  max = responseTime;
+uint32_t ReflexTestData_GetFalseStarts(ReflexTest_Context* context) {
+  return context->falseStarts;
 }
 
-double ReflexTestData_GetMaxResponseTime() {
-  return max;
+void ReflexTestData_RecordWrongPresses(ReflexTest_Context* context, uint32_t presses, uint32_t latency) {
+  context->wrongPresses += presses;
+  context->wrongResponses++;
+  context->wrongLatency += latency;
 }
 
-void ReflexTestData_SetAverageResponseTime(double responseTime) {
-  average = responseTime;
+uint32_t ReflexTestData_GetWrongPresses(ReflexTest_Context* context) {
+  return context->wrongPresses;
 }
 
-double ReflexTestData_GetAverageResponseTime() {
-  return average;
+uint32_t ReflexTestData_GetWrongPressLatency(ReflexTest_Context* context) {
+  if (context->wrongResponses == 0) {
+    return 0;
+  }
+  return (uint32_t) (context->wrongLatency / context->wrongResponses);
+}
+
+void ReflexTestData_SetCurrentState(ReflexTest_Context* context, ReflexTest_st newState) {
+  context->currentState = newState;
+}
+
+ReflexTest_st ReflexTestData_GetCurrentState(ReflexTest_Context* context) {
+  return context->currentState;
 }
 
-double* ReflexTestData_GetHighScores() {
-  return highScores;
+const char* ReflexTestData_GetStateName(ReflexTest_st state) {
+  if (state < REFLEXTESTDATA_NUMBER_OF_STATES) {
+    return stateNames[state];
+  }
+  else {
+    return "unknown_st";
+  }
+}
+
+bool ReflexTestData_IsCorrectButtonPressed(ReflexTest_Context* context) {
+  return (context->pressedButton == context->sequence[context->index]);
+}
+
+void ReflexTestData_SetResponseTime(ReflexTest_Context* context, uint32_t inputTime) {
+  context->responseTime = inputTime;
+}
+
+uint32_t ReflexTestData_GetResponseTime(ReflexTest_Context* context) {
+  return context->responseTime;
+}
+
+void ReflexTestData_SetMinResponseTime(ReflexTest_Context* context, uint32_t responseTime) {
+  context->min = responseTime;
+}
+
+uint32_t ReflexTestData_GetMinResponseTime(ReflexTest_Context* context) {
+  return context->min;
+}
+
+void ReflexTestData_SetMaxResponseTime(ReflexTest_Context* context, uint32_t responseTime) {
+  context->max = responseTime;
+}
+
+uint32_t ReflexTestData_GetMaxResponseTime(ReflexTest_Context* context) {
+  return context->max;
+}
+
+void ReflexTestData_SetAverageResponseTime(ReflexTest_Context* context, uint32_t responseTime) {
+  context->average = responseTime;
+}
+
+uint32_t ReflexTestData_GetAverageResponseTime(ReflexTest_Context* context) {
+  return context->average;
+}
+
+uint32_t* ReflexTestData_GetHighScores(ReflexTest_Context* context) {
+  return context->highScores;
 }
 
 /**
- * Helper function that performs a comparison of two double values.
- * @param  a The 1st double to compare.
- * @param  b The 2nd double to compare
+ * Helper function that performs a comparison of two scores.
+ * @param  a The 1st score to compare.
+ * @param  b The 2nd score to compare
  * @return   -1 if A is less than b, 1 if A is greater than b, or 0 otherwise.
  */
 int compare_function(const void *a,const void *b) {
-  double *x = (double *) a;
-  double *y = (double *) b;
+  uint32_t *x = (uint32_t *) a;
+  uint32_t *y = (uint32_t *) b;
 
   if (*x < *y) {
     return -1;
@@ -167,21 +243,27 @@ int compare_function(const void *a,const void *b) {
   return 0;
 }
 
-void ReflexTestData_UpdateScores() {
+void ReflexTestData_UpdateScores(ReflexTest_Context* context) {
+  uint32_t* highScores = context->highScores;
+  // A round made of guesses does not get a place, however fast it was.
+  if (context->falseStarts > REFLEXTESTDATA_MAX_FALSE_STARTS) {
+    return;
+  }
   // If the slowest score in the high scores list is slower than the most recent
   // score, replace the slowest score with the new average, and then sort.
-  if (highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES-1] > average) {
-    highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES-1] = average;
-    qsort(highScores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, sizeof(double), compare_function);
+  if (highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES-1] > context->average) {
+    highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES-1] = context->average;
+    qsort(highScores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, sizeof(uint32_t), compare_function);
   }
 }
 
 /**
  * Helper function used in Unit testing to give access to the scores array.
  */
-ReflexTestData_TestOnly_SetScores(double testScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES]) {
+void ReflexTestData_TestOnly_SetScores(ReflexTest_Context* context,
+                                       uint32_t testScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES]) {
   int i;
   for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES; i++) {
-    highScores[i] = testScores[i];
+    context->highScores[i] = testScores[i];
   }
 }
@@ -10,6 +10,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "SoftTimer.h"
+#include "Debounce.h"
+#include "Stopwatch.h"
+#include "LedShadow.h"
+#include "LcdFrame.h"
 
 // Uncomment the line below to enable debug output.
 // #define REFLEXTESTDATA_DEBUG
@@ -19,6 +24,17 @@
 #define REFLEXTESTDATA_SEQUENCE_LENGTH 10
 #define REFLEXTESTDATA_NUMBER_OF_LEDS 4
 
+// Response times, their stats and the high scores are whole microseconds.
+// They are only turned into seconds where they are printed.
+#define REFLEXTESTDATA_MICROSECONDS_PER_SECOND 1000000
+// The slowest response time that counts, and the initial high score.
+#define REFLEXTESTDATA_SLOWEST_RESPONSE_TIME (5 * REFLEXTESTDATA_MICROSECONDS_PER_SECOND)
+// Nobody responds faster than this, in us. Faster responses, and presses
+// made before the LED went on, are false starts and do not count.
+#define REFLEXTESTDATA_FALSE_START_FLOOR (REFLEXTESTDATA_MICROSECONDS_PER_SECOND / 10)
+// A round with more false starts than this does not go on the high scores.
+#define REFLEXTESTDATA_MAX_FALSE_STARTS 2
+
 //state machine
 typedef enum reflexTest_st {
   init_st,                // init state
@@ -35,131 +51,305 @@ typedef enum reflexTest_st {
   update_scores_st,       // compute average and rank score
 } ReflexTest_st;
 
+// Number of states in the state machine. Used to size per-state tables.
+#define REFLEXTESTDATA_NUMBER_OF_STATES (update_scores_st + 1)
+
+/**
+ * Everything one game of Reflex Test remembers. Every Executor, Conductor and
+ * Model function takes the context of the game it works on, so any number of
+ * games can run side by side. Models should use the ReflexTestData functions
+ * rather than touch the members directly.
+ */
+typedef struct ReflexTest_Context {
+  // Shared game data (ReflexTestData)
+  ReflexTest_st currentState;
+  uint32_t sequence[REFLEXTESTDATA_SEQUENCE_LENGTH];
+  int32_t index;
+  int32_t pressedButton;
+  uint64_t stimulusTime;    // when the last LED was turned on, in us
+  uint64_t pressTime;       // when the last button press happened, in us
+  bool anticipated;         // a button went down before the LED in play went on
+  uint32_t falseStarts;     // responses of the last round that did not count
+  uint32_t wrongPresses;    // presses of the wrong button this round
+  uint32_t wrongResponses;  // LEDs whose first press was the wrong button
+  uint64_t wrongLatency;    // from those LEDs to the wrong press, summed, in us
+  uint32_t responseTime;
+  uint32_t min;
+  uint32_t max;
+  uint32_t average;
+  uint32_t highScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES];
+  unsigned int randomSeed;  // state for rand_r()
+
+  // Response times for the round in progress (TimerModel)
+  uint32_t stimulusOverhead;  // from the LED timestamp to the LED being on, in ns
+  uint32_t falseStartFloor;   // faster responses are false starts, in us
+  uint32_t roundMin;
+  uint32_t roundMax;
+  uint32_t roundAverage;
+  uint32_t roundTimes[REFLEXTESTDATA_SEQUENCE_LENGTH];
+  bool roundFalseStarts[REFLEXTESTDATA_SEQUENCE_LENGTH];
+
+  // TimerConductor
+  Stopwatch infoStopwatch;      // how long show_info_st lasted, to seed the sequence
+
+  // Executor
+  SoftTimer_Group timers;       // deadlines armed by the state machine
+  ReflexTest_st previousState;  // state of the last tick that was not skipped
+
+  // ButtonConductor
+  Debounce debounce;            // the buttons as the game sees them, and how they bounce
+  uint64_t lastTouchPoll;       // when the touch FIFO was last polled, in global timer ticks
+
+  // LedConductor
+  LedShadow leds;               // what the LEDs show, so that rewriting it can be skipped
+
+  // LcdConductor
+  LcdFrame lcdFrame;            // the frame being drawn, and how far it got
+  bool lcdFrameDone;            // the last frame asked for has been drawn
+} ReflexTest_Context;
+
+/**
+ * A Moore action performed by a conductor while in a particular state.
+ * Conductors publish one action per state, or NULL if they do nothing there.
+ */
+typedef void (*ReflexTest_Action)(ReflexTest_Context* context);
+
 /**
  * Initialization function. Should initialize the index, high scores, etc.
+ * @param context The game to work on.
  */
-void ReflexTestData_Init(void);
+void ReflexTestData_Init(ReflexTest_Context* context);
 
 /**
  * Sets the current state to the parameter passed in.
+ * @param context The game to work on.
  * @param newState The Reflex Data state to set the currentState to.
  */
-void ReflexTestData_SetCurrentState(ReflexTest_st newState);
+void ReflexTestData_SetCurrentState(ReflexTest_Context* context, ReflexTest_st newState);
 
 /**
  * Returns the current state.
+ * @param  context The game to work on.
  * @return  The current ReflexTest state.
  */
-ReflexTest_st ReflexTestData_GetCurrentState(void);
+ReflexTest_st ReflexTestData_GetCurrentState(ReflexTest_Context* context);
+
+/**
+ * Returns a printable name for the given state.
+ * @param  state The state to name.
+ * @return       The name of the state, e.g. "wait_info_st".
+ */
+const char* ReflexTestData_GetStateName(ReflexTest_st state);
 
 /**
  * Generates a random sequence of REFLEXTESTDATA_SEQUENCE_LENGTH and Returns
  * a pointer to the preallocated array. This array memory does NOT need to below
  * deallocated.
- * @param  seed The seed to seed srand() with for generating random numbers.
- * @return      A pointer to the array containing the sequences.
+ * @param  context The game to work on.
+ * @param  seed    The seed for the game's random number generator.
+ * @return         A pointer to the array containing the sequences.
  */
-uint32_t* ReflexTestData_GenerateSequence(int32_t seed);
+uint32_t* ReflexTestData_GenerateSequence(ReflexTest_Context* context, int32_t seed);
 
 /**
  * Returns the LED # to flash in the sequence. Used by LED Model.
+ * @param  context The game to work on.
  * @return  The value of the LED to flash.
  */
-int32_t ReflexTestData_GetLed(void);
+int32_t ReflexTestData_GetLed(ReflexTest_Context* context);
 
 /**
  * Increments the internal index.
+ * @param context The game to work on.
  */
-void ReflexTestData_IncrementIndex();
+void ReflexTestData_IncrementIndex(ReflexTest_Context* context);
 
 /**
  * Returns the current index of the sequence.
+ * @param context The game to work on.
  * @return The current index of the sequence.
  */
-int32_t ReflexTestData_GetCurrentIndex();
+int32_t ReflexTestData_GetCurrentIndex(ReflexTest_Context* context);
 
 /**
  * Checks to see if entire sequence has already been shown. Used by LED Model.
+ * @param  context The game to work on.
  * @return  TRUE if the sequence is over.
  */
-bool ReflexTestData_IsSequenceDone(void);
+bool ReflexTestData_IsSequenceDone(ReflexTest_Context* context);
 
 /**
  * Gets the value of the pressed button. Used by the button model.
+ * @param  context The game to work on.
  * @return  Return the value of the pressed button.
  */
-int32_t ReflexTestData_GetPressedButton(void);
+int32_t ReflexTestData_GetPressedButton(ReflexTest_Context* context);
 
 /**
  * Returns true if a button is currently pressed.
+ * @param  context The game to work on.
  * @return  TRUE if a button is currently being pressed.
  */
-bool ReflexTestData_IsCorrectButtonPressed(void);
+bool ReflexTestData_IsCorrectButtonPressed(ReflexTest_Context* context);
 
 /**
  * Sets the value of the pressed button. Used by the button model.
+ * @param context The game to work on.
  * @param value The value to set the pressed button to.
  */
-void ReflexTestData_SetPressedButton(int32_t value);
+void ReflexTestData_SetPressedButton(ReflexTest_Context* context, int32_t value);
+
+/**
+ * Sets when the last LED was turned on. Used by the LED model.
+ * @param context   The game to work on.
+ * @param timestamp The time of the stimulus in microseconds.
+ */
+void ReflexTestData_SetStimulusTime(ReflexTest_Context* context, uint64_t timestamp);
+
+/**
+ * Returns when the last LED was turned on. Used by the timer model.
+ * @param  context The game to work on.
+ * @return         The time of the stimulus in microseconds.
+ */
+uint64_t ReflexTestData_GetStimulusTime(ReflexTest_Context* context);
+
+/**
+ * Sets when the last button press happened. Used by the button model.
+ * @param context   The game to work on.
+ * @param timestamp The time of the press in microseconds, or 0 if unknown.
+ */
+void ReflexTestData_SetPressTime(ReflexTest_Context* context, uint64_t timestamp);
+
+/**
+ * Returns when the last button press happened. Used by the timer model.
+ * @param  context The game to work on.
+ * @return         The time of the press in microseconds, or 0 if unknown.
+ */
+uint64_t ReflexTestData_GetPressTime(ReflexTest_Context* context);
+
+/**
+ * Notes whether a button went down before the LED in play went on. Used by
+ * the button model to flag a press, and by the timer model to clear the flag
+ * once the response has been recorded.
+ * @param context     The game to work on.
+ * @param anticipated TRUE if the player pressed too early.
+ */
+void ReflexTestData_SetAnticipated(ReflexTest_Context* context, bool anticipated);
+
+/**
+ * Returns whether a button went down before the LED in play went on.
+ * @param  context The game to work on.
+ * @return         TRUE if the response to this LED is a false start.
+ */
+bool ReflexTestData_IsAnticipated(ReflexTest_Context* context);
+
+/**
+ * Sets how many responses of the round were false starts.
+ * @param context     The game to work on.
+ * @param falseStarts The number of responses that did not count.
+ */
+void ReflexTestData_SetFalseStarts(ReflexTest_Context* context, uint32_t falseStarts);
+
+/**
+ * Returns how many responses of the last round were false starts.
+ * @param  context The game to work on.
+ * @return         The number of responses that did not count.
+ */
+uint32_t ReflexTestData_GetFalseStarts(ReflexTest_Context* context);
+
+/**
+ * Counts presses of the wrong button in response to the LED in play. Used by
+ * the button model. The counts start over with every new sequence.
+ * @param context The game to work on.
+ * @param presses The number of wrong presses, counting repeats.
+ * @param latency From the LED going on to the first of them, in us.
+ */
+void ReflexTestData_RecordWrongPresses(ReflexTest_Context* context, uint32_t presses, uint32_t latency);
+
+/**
+ * Returns how many times the wrong button was pressed this round.
+ * @param  context The game to work on.
+ * @return         The number of wrong presses, counting repeats.
+ */
+uint32_t ReflexTestData_GetWrongPresses(ReflexTest_Context* context);
+
+/**
+ * Returns how fast the wrong button was pressed on average this round.
+ * @param  context The game to work on.
+ * @return         The average latency of the wrong presses in us, or 0 if
+ *                 there were none.
+ */
+uint32_t ReflexTestData_GetWrongPressLatency(ReflexTest_Context* context);
 
 /**
  * Returns the response time between a flashed LED and a pushed button.
  * Used by the timer model.
- * @return  The time between a flashed LED and a pushed button.
+ * @param  context The game to work on.
+ * @return  The time between a flashed LED and a pushed button in us.
  */
-double ReflexTestData_GetResponseTime(void);
+uint32_t ReflexTestData_GetResponseTime(ReflexTest_Context* context);
 
 /**
  * Saves the passed-in reponse time as the most recent response.
- * @param responseTime The value to store as the most recent response.
+ * @param context The game to work on.
+ * @param responseTime The value to store as the most recent response in us.
  */
-void ReflexTestData_SetResponseTime(double inputTime);
+void ReflexTestData_SetResponseTime(ReflexTest_Context* context, uint32_t inputTime);
 
 /**
- * Updates the high scores list.
+ * Updates the high scores list with the round's average, unless the round
+ * had more than REFLEXTESTDATA_MAX_FALSE_STARTS false starts.
+ * @param context The game to work on.
  */
-void ReflexTestData_UpdateScores();
+void ReflexTestData_UpdateScores(ReflexTest_Context* context);
 
 /**
  * Sets the minimum response time.
+ * @param context The game to work on.
  * @param responseTime the minimum response time from the player's round.
  */
-void ReflexTestData_SetMinResponseTime(double responseTime);
+void ReflexTestData_SetMinResponseTime(ReflexTest_Context* context, uint32_t responseTime);
 
 /**
  * The minimum response time from a player's round.
+ * @param context The game to work on.
  * @return The minimum response time from a player's round.
  */
-double ReflexTestData_GetMinResponseTime();
+uint32_t ReflexTestData_GetMinResponseTime(ReflexTest_Context* context);
 
 /**
  * Sets the maximum response time.
+ * @param context The game to work on.
  * @param responseTime the maximum response time from the player's round.
  */
-void ReflexTestData_SetMaxResponseTime(double responseTime);
+void ReflexTestData_SetMaxResponseTime(ReflexTest_Context* context, uint32_t responseTime);
 
 /**
  * The maximum response time from a player's round.
+ * @param context The game to work on.
  * @return The maximum response time from a player's round.
  */
-double ReflexTestData_GetMaxResponseTime();
+uint32_t ReflexTestData_GetMaxResponseTime(ReflexTest_Context* context);
 
 /**
  * Sets the average response time.
+ * @param context The game to work on.
  * @param responseTime the average response time from the player's round.
  */
-void ReflexTestData_SetAverageResponseTime(double responseTime);
+void ReflexTestData_SetAverageResponseTime(ReflexTest_Context* context, uint32_t responseTime);
 
 /**
  * The average response time from a player's round.
+ * @param context The game to work on.
  * @return The average response time from a player's round.
  */
-double ReflexTestData_GetAverageResponseTime();
+uint32_t ReflexTestData_GetAverageResponseTime(ReflexTest_Context* context);
 
 /**
  * The 10 highest scores since the board has been turned on.
+ * @param context The game to work on.
  * @return A pointer to the array containing 10 highest scores.
  */
-double* ReflexTestData_GetHighScores();
+uint32_t* ReflexTestData_GetHighScores(ReflexTest_Context* context);
 
 #endif /* REFLEXTESTDATA_H_ */
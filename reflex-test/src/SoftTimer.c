@@ -0,0 +1,139 @@
+#include "SoftTimer.h"
+
+// Sentinel heap position for timers that are not in the heap.
+#define NOT_IN_HEAP -1
+
+/**
+ * Helper function that swaps two entries in the heap.
+ */
+static void SoftTimer_Swap(SoftTimer_Group* timers, int32_t a, int32_t b) {
+  uint32_t timer = timers->heap[a];
+  timers->heap[a] = timers->heap[b];
+  timers->heap[b] = timer;
+  timers->heapPosition[timers->heap[a]] = a;
+  timers->heapPosition[timers->heap[b]] = b;
+}
+
+/**
+ * Helper function that returns the deadline of the entry at a heap position.
+ */
+static uint64_t SoftTimer_DeadlineAt(SoftTimer_Group* timers, int32_t position) {
+  return timers->deadlines[timers->heap[position]];
+}
+
+/**
+ * Helper function that moves an entry up until its parent is earlier.
+ */
+static void SoftTimer_SiftUp(SoftTimer_Group* timers, int32_t position) {
+  while (position > 0) {
+    int32_t parent = (position - 1) / 2;
+    if (SoftTimer_DeadlineAt(timers, parent) <= SoftTimer_DeadlineAt(timers, position)) {
+      break;
+    }
+    SoftTimer_Swap(timers, parent, position);
+    position = parent;
+  }
+}
+
+/**
+ * Helper function that moves an entry down until its children are later.
+ */
+static void SoftTimer_SiftDown(SoftTimer_Group* timers, int32_t position) {
+  while (true) {
+    int32_t left = (2 * position) + 1;
+    int32_t right = left + 1;
+    int32_t earliest = position;
+    if (left < timers->heapSize &&
+        SoftTimer_DeadlineAt(timers, left) < SoftTimer_DeadlineAt(timers, earliest)) {
+      earliest = left;
+    }
+    if (right < timers->heapSize &&
+        SoftTimer_DeadlineAt(timers, right) < SoftTimer_DeadlineAt(timers, earliest)) {
+      earliest = right;
+    }
+    if (earliest == position) {
+      break;
+    }
+    SoftTimer_Swap(timers, position, earliest);
+    position = earliest;
+  }
+}
+
+/**
+ * Helper function that takes a timer out of the heap if it is in it.
+ */
+static void SoftTimer_Remove(SoftTimer_Group* timers, uint32_t timer) {
+  int32_t position = timers->heapPosition[timer];
+  if (position == NOT_IN_HEAP) {
+    return;
+  }
+  timers->heapSize--;
+  if (position != timers->heapSize) {
+    SoftTimer_Swap(timers, position, timers->heapSize);
+    SoftTimer_SiftDown(timers, position);
+    SoftTimer_SiftUp(timers, position);
+  }
+  timers->heapPosition[timer] = NOT_IN_HEAP;
+}
+
+void SoftTimer_Init(SoftTimer_Group* timers) {
+  int i;
+  timers->heapSize = 0;
+  for (i = 0; i < SOFTTIMER_MAX_TIMERS; i++) {
+    timers->deadlines[i] = SOFTTIMER_NEVER;
+    timers->expired[i] = false;
+    timers->heap[i] = 0;
+    timers->heapPosition[i] = NOT_IN_HEAP;
+  }
+}
+
+void SoftTimer_Arm(SoftTimer_Group* timers, uint32_t timer, uint64_t deadline) {
+  if (timer >= SOFTTIMER_MAX_TIMERS) {
+    return;
+  }
+  SoftTimer_Remove(timers, timer);
+  timers->deadlines[timer] = deadline;
+  timers->expired[timer] = false;
+
+  timers->heap[timers->heapSize] = timer;
+  timers->heapPosition[timer] = timers->heapSize;
+  timers->heapSize++;
+  SoftTimer_SiftUp(timers, timers->heapPosition[timer]);
+}
+
+void SoftTimer_Cancel(SoftTimer_Group* timers, uint32_t timer) {
+  if (timer >= SOFTTIMER_MAX_TIMERS) {
+    return;
+  }
+  SoftTimer_Remove(timers, timer);
+  timers->deadlines[timer] = SOFTTIMER_NEVER;
+  timers->expired[timer] = false;
+}
+
+uint32_t SoftTimer_Poll(SoftTimer_Group* timers, uint64_t now) {
+  uint32_t expiredMask = 0;
+  // The earliest deadline is always at the top of the heap.
+  while (timers->heapSize > 0 && SoftTimer_DeadlineAt(timers, 0) <= now) {
+    uint32_t timer = timers->heap[0];
+    SoftTimer_Remove(timers, timer);
+    timers->expired[timer] = true;
+    expiredMask |= (1 << timer);
+  }
+  return expiredMask;
+}
+
+bool SoftTimer_HasExpired(SoftTimer_Group* timers, uint32_t timer) {
+  return (timer < SOFTTIMER_MAX_TIMERS) && timers->expired[timer];
+}
+
+bool SoftTimer_IsPending(SoftTimer_Group* timers, uint32_t timer) {
+  return (timer < SOFTTIMER_MAX_TIMERS) &&
+         (timers->heapPosition[timer] != NOT_IN_HEAP);
+}
+
+uint64_t SoftTimer_GetNextDeadline(SoftTimer_Group* timers) {
+  if (timers->heapSize == 0) {
+    return SOFTTIMER_NEVER;
+  }
+  return SoftTimer_DeadlineAt(timers, 0);
+}
@@ -0,0 +1,82 @@
+#ifndef SOFTTIMER_H_
+#define SOFTTIMER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Maximum number of software timers that can be armed at once.
+#define SOFTTIMER_MAX_TIMERS 8
+
+// Returned by SoftTimer_GetNextDeadline when no timers are armed.
+#define SOFTTIMER_NEVER UINT64_MAX
+
+/**
+ * A group of up to SOFTTIMER_MAX_TIMERS one-shot timers. Each game keeps its
+ * own group, so the members should only be touched by SoftTimer functions.
+ */
+typedef struct SoftTimer_Group {
+  // Deadline and state of each timer.
+  uint64_t deadlines[SOFTTIMER_MAX_TIMERS];
+  bool expired[SOFTTIMER_MAX_TIMERS];
+  // Min-heap of pending timer IDs ordered by deadline, and the position of
+  // each timer in the heap so that it can be re-armed or canceled.
+  uint32_t heap[SOFTTIMER_MAX_TIMERS];
+  int32_t heapPosition[SOFTTIMER_MAX_TIMERS];
+  int32_t heapSize;
+} SoftTimer_Group;
+
+/**
+ * Disarms all of the timers in the group.
+ * @param timers The group of timers.
+ */
+void SoftTimer_Init(SoftTimer_Group* timers);
+
+/**
+ * Arms a one-shot timer to expire at an absolute time. Re-arming a timer
+ * replaces its previous deadline and clears its expired flag.
+ * @param timers   The group of timers.
+ * @param timer    The ID of the timer, 0 to SOFTTIMER_MAX_TIMERS-1.
+ * @param deadline The absolute time at which the timer expires.
+ */
+void SoftTimer_Arm(SoftTimer_Group* timers, uint32_t timer, uint64_t deadline);
+
+/**
+ * Disarms a timer and clears its expired flag.
+ * @param timers The group of timers.
+ * @param timer  The ID of the timer to cancel.
+ */
+void SoftTimer_Cancel(SoftTimer_Group* timers, uint32_t timer);
+
+/**
+ * Expires every armed timer whose deadline is at or before now. Only the
+ * earliest deadline is looked at when nothing is due.
+ * @param  timers The group of timers.
+ * @param  now    The current time.
+ * @return        A mask with bit N set if timer N expired during this call.
+ */
+uint32_t SoftTimer_Poll(SoftTimer_Group* timers, uint64_t now);
+
+/**
+ * Returns true if the timer has expired since it was last armed.
+ * @param  timers The group of timers.
+ * @param  timer  The ID of the timer.
+ * @return        TRUE if the timer's deadline has passed.
+ */
+bool SoftTimer_HasExpired(SoftTimer_Group* timers, uint32_t timer);
+
+/**
+ * Returns true if the timer is armed and has not expired yet.
+ * @param  timers The group of timers.
+ * @param  timer  The ID of the timer.
+ * @return        TRUE if the timer is pending.
+ */
+bool SoftTimer_IsPending(SoftTimer_Group* timers, uint32_t timer);
+
+/**
+ * Returns the earliest deadline of all pending timers in the group.
+ * @param  timers The group of timers.
+ * @return        The earliest deadline, or SOFTTIMER_NEVER if none are pending.
+ */
+uint64_t SoftTimer_GetNextDeadline(SoftTimer_Group* timers);
+
+#endif /* SOFTTIMER_H_ */
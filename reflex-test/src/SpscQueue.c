@@ -0,0 +1,58 @@
+#include "SpscQueue.h"
+#include <string.h>
+
+// Orders the element copy against the counter update, on both the compiler
+// and the CPU (a DMB on the Cortex-A9).
+#define SPSCQUEUE_BARRIER() __sync_synchronize()
+
+bool SpscQueue_Init(SpscQueue* queue, void* buffer, uint32_t elementSize, uint32_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    return false;
+  }
+  queue->buffer = buffer;
+  queue->elementSize = elementSize;
+  queue->mask = capacity - 1;
+  queue->head = 0;
+  queue->tail = 0;
+  queue->dropped = 0;
+  return true;
+}
+
+bool SpscQueue_Push(SpscQueue* queue, const void* element) {
+  uint32_t head = queue->head;
+  if (head - queue->tail > queue->mask) {
+    queue->dropped++;
+    return false;
+  }
+  memcpy(&queue->buffer[(head & queue->mask) * queue->elementSize], element, queue->elementSize);
+  // The element must be complete before the consumer can see it.
+  SPSCQUEUE_BARRIER();
+  queue->head = head + 1;
+  return true;
+}
+
+bool SpscQueue_Pop(SpscQueue* queue, void* element) {
+  uint32_t tail = queue->tail;
+  if (queue->head == tail) {
+    return false;
+  }
+  // Read the element only after seeing the head that published it.
+  SPSCQUEUE_BARRIER();
+  memcpy(element, &queue->buffer[(tail & queue->mask) * queue->elementSize], queue->elementSize);
+  // The copy must be finished before the producer can reuse the slot.
+  SPSCQUEUE_BARRIER();
+  queue->tail = tail + 1;
+  return true;
+}
+
+uint32_t SpscQueue_GetCount(SpscQueue* queue) {
+  return queue->head - queue->tail;
+}
+
+uint32_t SpscQueue_GetCapacity(SpscQueue* queue) {
+  return queue->mask + 1;
+}
+
+uint32_t SpscQueue_GetDropped(SpscQueue* queue) {
+  return queue->dropped;
+}
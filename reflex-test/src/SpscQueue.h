@@ -0,0 +1,72 @@
+#ifndef SPSCQUEUE_H_
+#define SPSCQUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * A lock-free queue of fixed-size elements between exactly one producer and
+ * one consumer, for example an interrupt handler and the main loop, or two
+ * cores. The producer only writes head and the consumer only writes tail,
+ * so neither side ever waits for the other. Both counters run freely and
+ * wrap; the slot is the counter masked by the capacity, which must be a
+ * power of two. The members should only be touched by SpscQueue functions.
+ */
+typedef struct SpscQueue {
+  uint8_t* buffer;
+  uint32_t elementSize;
+  uint32_t mask;            // capacity - 1
+  volatile uint32_t head;   // elements ever pushed, written by the producer
+  volatile uint32_t tail;   // elements ever popped, written by the consumer
+  uint32_t dropped;         // pushes refused because the queue was full
+} SpscQueue;
+
+/**
+ * Sets up an empty queue on the given storage.
+ * @param queue       The queue.
+ * @param buffer      Storage for capacity elements.
+ * @param elementSize The size of one element in bytes.
+ * @param capacity    The number of elements; must be a power of two.
+ * @return            FALSE if the capacity is not a power of two.
+ */
+bool SpscQueue_Init(SpscQueue* queue, void* buffer, uint32_t elementSize, uint32_t capacity);
+
+/**
+ * Adds a copy of the element at the head of the queue. Producer only.
+ * @param queue   The queue.
+ * @param element The element to copy in.
+ * @return        FALSE, and counts a drop, if the queue is full.
+ */
+bool SpscQueue_Push(SpscQueue* queue, const void* element);
+
+/**
+ * Removes the element at the tail of the queue. Consumer only.
+ * @param queue   The queue.
+ * @param element Where to copy the element.
+ * @return        FALSE if the queue is empty.
+ */
+bool SpscQueue_Pop(SpscQueue* queue, void* element);
+
+/**
+ * Returns the number of elements waiting. Exact from the consumer's side; a
+ * lower bound of the free space from the producer's side.
+ * @param  queue The queue.
+ * @return       The number of elements in the queue.
+ */
+uint32_t SpscQueue_GetCount(SpscQueue* queue);
+
+/**
+ * Returns the number of elements the queue can hold.
+ * @param  queue The queue.
+ * @return       The capacity.
+ */
+uint32_t SpscQueue_GetCapacity(SpscQueue* queue);
+
+/**
+ * Returns how many pushes were refused because the queue was full.
+ * @param  queue The queue.
+ * @return       The number of dropped elements.
+ */
+uint32_t SpscQueue_GetDropped(SpscQueue* queue);
+
+#endif /* SPSCQUEUE_H_ */
@@ -0,0 +1,51 @@
+#include "Stopwatch.h"
+#include "../vendor/supportFiles/globalTimer.h"
+
+// Number of global timer ticks in one microsecond.
+#define STOPWATCH_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+
+void Stopwatch_Init(Stopwatch* stopwatch) {
+  stopwatch->start = 0;
+  stopwatch->total = 0;
+  stopwatch->running = false;
+}
+
+void Stopwatch_Reset(Stopwatch* stopwatch) {
+  stopwatch->total = 0;
+  if (stopwatch->running) {
+    stopwatch->start = globalTimer_getTimerValue();
+  }
+}
+
+void Stopwatch_Start(Stopwatch* stopwatch) {
+  if (!stopwatch->running) {
+    stopwatch->start = globalTimer_getTimerValue();
+    stopwatch->running = true;
+  }
+}
+
+void Stopwatch_Stop(Stopwatch* stopwatch) {
+  if (stopwatch->running) {
+    stopwatch->total += globalTimer_getTimerValue() - stopwatch->start;
+    stopwatch->running = false;
+  }
+}
+
+bool Stopwatch_IsRunning(const Stopwatch* stopwatch) {
+  return stopwatch->running;
+}
+
+uint64_t Stopwatch_GetTicks(const Stopwatch* stopwatch) {
+  if (stopwatch->running) {
+    return stopwatch->total + (globalTimer_getTimerValue() - stopwatch->start);
+  }
+  return stopwatch->total;
+}
+
+uint32_t Stopwatch_GetMicroseconds(const Stopwatch* stopwatch) {
+  uint64_t microseconds = Stopwatch_GetTicks(stopwatch) / STOPWATCH_TICKS_PER_MICROSECOND;
+  if (microseconds > UINT32_MAX) {
+    return UINT32_MAX;
+  }
+  return (uint32_t) microseconds;
+}
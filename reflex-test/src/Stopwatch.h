@@ -0,0 +1,69 @@
+#ifndef STOPWATCH_H_
+#define STOPWATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A stopwatch is a snapshot of the global timer, which runs freely from
+// startup and is never written again. Starting one reads the counter once
+// and reading one subtracts, so there can be as many as needed and none of
+// them touch an AXI timer; those stay free for profiling.
+
+/**
+ * One logical stopwatch. The members should only be touched by Stopwatch
+ * functions.
+ */
+typedef struct Stopwatch {
+  uint64_t start;    // the global timer when the stopwatch last started
+  uint64_t total;    // ticks counted before it last stopped
+  bool running;
+} Stopwatch;
+
+/**
+ * Stops the stopwatch at 0.
+ * @param stopwatch The stopwatch.
+ */
+void Stopwatch_Init(Stopwatch* stopwatch);
+
+/**
+ * Clears the time counted so far. A running stopwatch keeps running from 0.
+ * @param stopwatch The stopwatch.
+ */
+void Stopwatch_Reset(Stopwatch* stopwatch);
+
+/**
+ * Starts counting, adding to any time already counted. Does nothing if the
+ * stopwatch is already running.
+ * @param stopwatch The stopwatch.
+ */
+void Stopwatch_Start(Stopwatch* stopwatch);
+
+/**
+ * Stops counting and keeps the time counted so far. Does nothing if the
+ * stopwatch is not running.
+ * @param stopwatch The stopwatch.
+ */
+void Stopwatch_Stop(Stopwatch* stopwatch);
+
+/**
+ * Returns whether the stopwatch is counting.
+ * @param  stopwatch The stopwatch.
+ * @return           TRUE between Stopwatch_Start() and Stopwatch_Stop().
+ */
+bool Stopwatch_IsRunning(const Stopwatch* stopwatch);
+
+/**
+ * Returns the time counted so far, including the current run.
+ * @param  stopwatch The stopwatch.
+ * @return           The elapsed time in global timer ticks.
+ */
+uint64_t Stopwatch_GetTicks(const Stopwatch* stopwatch);
+
+/**
+ * Returns the time counted so far, including the current run.
+ * @param  stopwatch The stopwatch.
+ * @return           The elapsed time in us, UINT32_MAX if it does not fit.
+ */
+uint32_t Stopwatch_GetMicroseconds(const Stopwatch* stopwatch);
+
+#endif /* STOPWATCH_H_ */
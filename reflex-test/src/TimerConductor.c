@@ -1,60 +1,73 @@
 #include "TimerConductor.h"
 #include "TimerHardware.h"
 #include "TimerModel.h"
+#include <stddef.h>
 
-void TimerConductor_Init() {
-  TimerHardware_Init();
-  TimerModel_Init();
-}
-
-void TimerConductor_Run() {
-  double responseTime;
-  // state actions
-  switch (TimerModel_GetCurrentState()) {
-    case init_st:
-      break;
-    case show_info_st:
-      // Start the timer when the info is printed. This is then stopped when
-      // The user pushes a button and the value is used to seed our random
-      // generator.
-      TimerHardware_ResetTimer();
-      TimerHardware_StartTimer();
-      break;
-    case wait_info_st:
-      break;
-    case wait_five_seconds_st:
-      break;
-    case blank_screen_st:
-      // Stop the timer, and set the most recent response time.
-      TimerHardware_StopTimer();
-      responseTime = TimerHardware_GetResponseTime();
-      TimerModel_SetMostRecentResponseTime(responseTime);
-
-      // Clear the old stats in preparation for a new round.
-      TimerModel_ClearOldStats();
-      break;
-    case wait_between_flash_st:
-      break;
-    case blink_led_st:
-      // Start the timer when an LED is enabled. This is stopped once the user
-      // pushes the correct button.
-      TimerHardware_ResetTimer();
-      TimerHardware_StartTimer();
-      break;
-    case wait_for_button_st:
-      break;
-    case button_pressed_st:
-      TimerHardware_StopTimer();
-      responseTime = TimerHardware_GetResponseTime();
-      TimerModel_SetMostRecentResponseTime(responseTime);
-      TimerModel_RecordResponseTime(responseTime);
-      break;
-    case show_stats_st:
-      TimerModel_CalculateStats();
-      break;
-    case wait_stats_st:
-      break;
-    case update_scores_st:
-      break;
+/**
+ * Reset and start the interval timer. In show_info_st the timer is stopped
+ * when the user pushes a button and the value is used to seed our random
+ * generator.
+ */
+static void TimerConductor_StartTiming(ReflexTest_Context* context) {
+  TimerHardware_ResetTimer(&context->infoStopwatch);
+  TimerHardware_StartTimer(&context->infoStopwatch);
+}
+
+/**
+ * Stop the timer, and set the most recent response time.
+ * Then clear the old stats in preparation for a new round.
+ */
+static void TimerConductor_StartRound(ReflexTest_Context* context) {
+  uint32_t responseTime;
+  TimerHardware_StopTimer(&context->infoStopwatch);
+  responseTime = TimerHardware_GetResponseTime(&context->infoStopwatch);
+  TimerModel_SetMostRecentResponseTime(context, responseTime);
+
+  TimerModel_ClearOldStats(context);
+}
+
+/**
+ * Record the response time for this LED, from the timestamps of the LED and
+ * of the press. No timer has to be started or stopped for it.
+ */
+static void TimerConductor_RecordResponse(ReflexTest_Context* context) {
+  uint32_t responseTime;
+  responseTime = TimerModel_GetResponseTime(context, TimerHardware_GetTimestamp());
+  TimerModel_SetMostRecentResponseTime(context, responseTime);
+  TimerModel_RecordResponseTime(context, responseTime);
+}
+
+/**
+ * Calculate the stats for the round that just finished.
+ */
+static void TimerConductor_CalculateStats(ReflexTest_Context* context) {
+  TimerModel_CalculateStats(context);
+}
+
+// state actions. States that are not listed here do nothing.
+static const ReflexTest_Action TimerConductor_Actions[REFLEXTESTDATA_NUMBER_OF_STATES] = {
+  [show_info_st]      = TimerConductor_StartTiming,
+  [blank_screen_st]   = TimerConductor_StartRound,
+  [button_pressed_st] = TimerConductor_RecordResponse,
+  [show_stats_st]     = TimerConductor_CalculateStats,
+};
+
+void TimerConductor_Init(ReflexTest_Context* context) {
+  TimerHardware_Init(&context->infoStopwatch);
+  TimerModel_Init(context);
+}
+
+ReflexTest_Action TimerConductor_GetAction(ReflexTest_st state) {
+  return TimerConductor_Actions[state];
+}
+
+void TimerConductor_Run(ReflexTest_Context* context) {
+  ReflexTest_Action action = TimerConductor_GetAction(TimerModel_GetCurrentState(context));
+  if (action != NULL) {
+    action(context);
   }
 }
+
+uint64_t TimerConductor_GetCurrentTime() {
+  return TimerHardware_GetTimestamp();
+}
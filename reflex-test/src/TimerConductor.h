@@ -1,14 +1,31 @@
 #ifndef TIMERCONDUCTOR_H_
 #define TIMERCONDUCTOR_H_
 
+#include "ReflexTestData.h"
+
 /**
  * Initialization function for the Timer triad.
+ * @param context The game to work on.
+ */
+void TimerConductor_Init(ReflexTest_Context* context);
+
+/**
+ * Returns the timer action for the given state.
+ * @param  state The state to look up.
+ * @return       The action to perform, or NULL if there is nothing to do.
+ */
+ReflexTest_Action TimerConductor_GetAction(ReflexTest_st state);
+
+/**
+ * Returns the current time, used by the executor for its deadlines.
+ * @return  The time since the timers were initialized in microseconds.
  */
-void TimerConductor_Init(void);
+uint64_t TimerConductor_GetCurrentTime(void);
 
 /**
  * Perform timer actions based on the current state.
+ * @param context The game to work on.
  */
-void TimerConductor_Run(void);
+void TimerConductor_Run(ReflexTest_Context* context);
 
 #endif /* TIMERCONDUCTOR_H_ */
@@ -1,26 +1,38 @@
 #include "TimerHardware.h"
 #include "ReflexTestData.h"
 #include "intervalTimer.h"
+#include "Stopwatch.h"
+#include "InputLog.h"
+#include "../vendor/supportFiles/globalTimer.h"
 
-void TimerHardware_Init() {
+// Number of global timer ticks in one microsecond.
+#define TIMERHARDWARE_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+
+// The game's stopwatch runs off the global timer, so the AXI timers are
+// only initialized here and are otherwise left free for profiling.
+void TimerHardware_Init(Stopwatch* stopwatch) {
   intervalTimer_initAll();
-  TimerHardware_StartTimer();
+  globalTimer_startTimer(false);
+  Stopwatch_Init(stopwatch);
+  Stopwatch_Start(stopwatch);
+}
+
+uint32_t TimerHardware_GetResponseTime(const Stopwatch* stopwatch) {
+  return InputLog_ResponseTime(Stopwatch_GetMicroseconds(stopwatch));
 }
 
-double TimerHardware_GetResponseTime() {
-    double responseTime = 0;
-    intervalTimer_getTotalDurationInSeconds(INTERVALTIMER_TIMER0, &responseTime);
-    return responseTime;
+void TimerHardware_StopTimer(Stopwatch* stopwatch) {
+  Stopwatch_Stop(stopwatch);
 }
 
-void TimerHardware_StopTimer() {
-  intervalTimer_stop(INTERVALTIMER_TIMER0);
+void TimerHardware_StartTimer(Stopwatch* stopwatch) {
+  Stopwatch_Start(stopwatch);
 }
 
-void TimerHardware_StartTimer() {
-  intervalTimer_start(INTERVALTIMER_TIMER0);
+void TimerHardware_ResetTimer(Stopwatch* stopwatch) {
+  Stopwatch_Reset(stopwatch);
 }
 
-void TimerHardware_ResetTimer(void) {
-  intervalTimer_reset(INTERVALTIMER_TIMER0);
+uint64_t TimerHardware_GetTimestamp(void) {
+  return InputLog_Timestamp(globalTimer_getTimerValue() / TIMERHARDWARE_TICKS_PER_MICROSECOND);
 }
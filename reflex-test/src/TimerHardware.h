@@ -1,30 +1,46 @@
 #ifndef TIMERHARDWARE_H_
 #define TIMERHARDWARE_H_
 
+#include <stdint.h>
+#include "Stopwatch.h"
+
+/**
+ * Initializes the interval timers, starts the global timer and starts the
+ * stopwatch.
+ * @param stopwatch The game's stopwatch.
+ */
+void TimerHardware_Init(Stopwatch* stopwatch);
+
 /**
- * Initializes the interval timer hardware.
+ * Returns the duration in microseconds between the last start/stop of the
+ * stopwatch.
+ * @param  stopwatch The game's stopwatch.
+ * @return  The elapsed time in us between start/stop.
  */
-void TimerHardware_Init(void);
+uint32_t TimerHardware_GetResponseTime(const Stopwatch* stopwatch);
 
 /**
- * Returns the duration in seconds between the last start/stop of the timer.
- * @return  The elapsed time in sec between start/stop.
+ * Stops the stopwatch.
+ * @param stopwatch The game's stopwatch.
  */
-double TimerHardware_GetResponseTime(void);
+void TimerHardware_StopTimer(Stopwatch* stopwatch);
 
 /**
- * Stops the interval timer.
+ * Starts the stopwatch.
+ * @param stopwatch The game's stopwatch.
  */
-void TimerHardware_StopTimer(void);
+void TimerHardware_StartTimer(Stopwatch* stopwatch);
 
 /**
- * Starts the interval timer.
+ * Resets the stopwatch to set it's start time to 0.0 sec.
+ * @param stopwatch The game's stopwatch.
  */
-void TimerHardware_StartTimer(void);
+void TimerHardware_ResetTimer(Stopwatch* stopwatch);
 
 /**
- * Resets the interval timer to set it's start time to 0.0 sec.
+ * Returns the time since the global timer was started.
+ * @return  The current time in microseconds.
  */
-void TimerHardware_ResetTimer(void);
+uint64_t TimerHardware_GetTimestamp(void);
 
 #endif /* TIMERHARDWARE_H_ */
@@ -1,93 +1,145 @@
 #include "TimerModel.h"
 #include <stdio.h>
 
-#define MAX_INITIAL_VALUE 5.000 //initialized to slowest possible time
-#define MIN_INITIAL_VALUE 0.000 //initialized to fastest possible time
-
-// Global variables used to store information about the current round.
-static double min = MAX_INITIAL_VALUE;
-static double max = MIN_INITIAL_VALUE;
-static double average = MAX_INITIAL_VALUE;
-static double times[REFLEXTESTDATA_SEQUENCE_LENGTH];
-
-void TimerModel_Init() {
-  // Initialize all of the global variables.
-  min = MAX_INITIAL_VALUE;
-  max = MIN_INITIAL_VALUE;
-  average = MAX_INITIAL_VALUE;
+#define MAX_INITIAL_VALUE REFLEXTESTDATA_SLOWEST_RESPONSE_TIME //initialized to slowest possible time
+#define MIN_INITIAL_VALUE 0 //initialized to fastest possible time
+#define NANOSECONDS_PER_MICROSECOND 1000
+
+void TimerModel_Init(ReflexTest_Context* context) {
+  // Initialize the round's response times.
+  context->roundMin = MAX_INITIAL_VALUE;
+  context->roundMax = MIN_INITIAL_VALUE;
+  context->roundAverage = MAX_INITIAL_VALUE;
+  context->stimulusOverhead = 0;
+  context->falseStartFloor = REFLEXTESTDATA_FALSE_START_FLOOR;
   int i;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
-    times[i] = 0.0;
+    context->roundTimes[i] = 0;
+    context->roundFalseStarts[i] = false;
   }
 }
 
-ReflexTest_st TimerModel_GetCurrentState() {
-  return ReflexTestData_GetCurrentState();
+ReflexTest_st TimerModel_GetCurrentState(ReflexTest_Context* context) {
+  return ReflexTestData_GetCurrentState(context);
 }
 
 /**
  * Helper function to show the contents of the response time array
  */
-void TimerModel_printStatsArray() {
+void TimerModel_printStatsArray(ReflexTest_Context* context) {
   int i;
   printf("{");
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH-1; i++) {
-    printf("%lf, ", times[i]);
+    printf("%lu, ", (unsigned long) context->roundTimes[i]);
   }
-  printf("%lf}\n", times[REFLEXTESTDATA_SEQUENCE_LENGTH-1]);
+  printf("%lu}\n", (unsigned long) context->roundTimes[REFLEXTESTDATA_SEQUENCE_LENGTH-1]);
 }
 
-void TimerModel_ClearOldStats() {
-  min = MAX_INITIAL_VALUE;
-  max = MIN_INITIAL_VALUE;
-  average = MAX_INITIAL_VALUE;
+void TimerModel_ClearOldStats(ReflexTest_Context* context) {
+  context->roundMin = MAX_INITIAL_VALUE;
+  context->roundMax = MIN_INITIAL_VALUE;
+  context->roundAverage = MAX_INITIAL_VALUE;
   int i;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
-    times[i] = MAX_INITIAL_VALUE;
+    context->roundTimes[i] = MAX_INITIAL_VALUE;
+    context->roundFalseStarts[i] = false;
   }
+  ReflexTestData_SetAnticipated(context, false);
 }
 
-void TimerModel_CalculateStats() {
+void TimerModel_CalculateStats(ReflexTest_Context* context) {
+  uint32_t* times = context->roundTimes;
   int i;
-  double runningTotal = 0;
+  uint64_t runningTotal = 0;
+  uint32_t counted = 0;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
-    if (times[i] > max) {
-      max = times[i];
+    // False starts are left out, so guessing cannot lower the average.
+    if (context->roundFalseStarts[i]) {
+      continue;
+    }
+    counted++;
+    if (times[i] > context->roundMax) {
+      context->roundMax = times[i];
     }
-    if (times[i] < min) {
-      min = times[i];
+    if (times[i] < context->roundMin) {
+      context->roundMin = times[i];
     }
     runningTotal += times[i];
   }
-  average = runningTotal/REFLEXTESTDATA_SEQUENCE_LENGTH;
+  // Rounded to the nearest microsecond. A round of nothing but false starts
+  // keeps the slowest average.
+  if (counted > 0) {
+    context->roundAverage = (runningTotal + counted/2)/counted;
+  }
+
+  ReflexTestData_SetFalseStarts(context, REFLEXTESTDATA_SEQUENCE_LENGTH - counted);
+  ReflexTestData_SetMinResponseTime(context, context->roundMin);
+  ReflexTestData_SetMaxResponseTime(context, context->roundMax);
+  ReflexTestData_SetAverageResponseTime(context, context->roundAverage);
+}
+
+uint32_t TimerModel_GetMin(ReflexTest_Context* context) {
+  return context->roundMin;
+}
+
+uint32_t TimerModel_GetMax(ReflexTest_Context* context) {
+  return context->roundMax;
+}
+
+uint32_t TimerModel_GetAverage(ReflexTest_Context* context) {
+  return context->roundAverage;
+}
+
+/**
+ * Takes an overhead in nanoseconds out of a time in microseconds, rounding
+ * to the nearest microsecond and stopping at 0.
+ */
+static uint32_t TimerModel_Compensate(uint64_t microseconds, uint32_t overhead) {
+  uint64_t nanoseconds = microseconds * NANOSECONDS_PER_MICROSECOND;
+  if (nanoseconds <= overhead) {
+    return 0;
+  }
+  microseconds = (nanoseconds - overhead + NANOSECONDS_PER_MICROSECOND/2) / NANOSECONDS_PER_MICROSECOND;
+  return (microseconds < UINT32_MAX) ? (uint32_t) microseconds : UINT32_MAX;
+}
 
-  ReflexTestData_SetMinResponseTime(min);
-  ReflexTestData_SetMaxResponseTime(max);
-  ReflexTestData_SetAverageResponseTime(average);
+void TimerModel_SetOverhead(ReflexTest_Context* context, uint32_t stimulus) {
+  context->stimulusOverhead = stimulus;
 }
 
-double TimerModel_GetMin() {
-  return min;
+uint32_t TimerModel_GetResponseTime(ReflexTest_Context* context, uint64_t now) {
+  uint64_t stimulusTime = ReflexTestData_GetStimulusTime(context);
+  uint64_t pressTime = ReflexTestData_GetPressTime(context);
+  if (pressTime <= stimulusTime) {
+    pressTime = now;  // no stamped press, so the tick that saw it will do
+  }
+  if (pressTime <= stimulusTime) {
+    return 0;
+  }
+  return TimerModel_Compensate(pressTime - stimulusTime, context->stimulusOverhead);
 }
 
-double TimerModel_GetMax() {
-  return max;
+void TimerModel_SetFalseStartFloor(ReflexTest_Context* context, uint32_t floor) {
+  context->falseStartFloor = floor;
 }
 
-double TimerModel_GetAverage() {
-  return average;
+bool TimerModel_IsFalseStart(ReflexTest_Context* context, uint32_t responseTime) {
+  return ReflexTestData_IsAnticipated(context) || responseTime < context->falseStartFloor;
 }
 
-void TimerModel_RecordResponseTime(double responseTime) {
-  int32_t index = ReflexTestData_GetCurrentIndex();
+void TimerModel_RecordResponseTime(ReflexTest_Context* context, uint32_t responseTime) {
+  int32_t index = ReflexTestData_GetCurrentIndex(context);
 
   if (index < REFLEXTESTDATA_SEQUENCE_LENGTH) {
-    times[index] = responseTime;
+    context->roundTimes[index] = responseTime;
+    context->roundFalseStarts[index] = TimerModel_IsFalseStart(context, responseTime);
   }
+  // The next LED starts with a clean slate.
+  ReflexTestData_SetAnticipated(context, false);
   //save it to the shared, global model
-  TimerModel_SetMostRecentResponseTime(responseTime);
+  TimerModel_SetMostRecentResponseTime(context, responseTime);
 }
 
-void TimerModel_SetMostRecentResponseTime(double responseTime) {
-  ReflexTestData_SetResponseTime(responseTime);
+void TimerModel_SetMostRecentResponseTime(ReflexTest_Context* context, uint32_t responseTime) {
+  ReflexTestData_SetResponseTime(context, responseTime);
 }
@@ -5,55 +5,104 @@
 
 /**
  * Initialization function that sets all of the global variable values.
+ * @param context The game to work on.
  */
-void TimerModel_Init(void);
+void TimerModel_Init(ReflexTest_Context* context);
 
 /**
  * Called by the Conductor to get the current state from ReflexTestData
+ * @param  context The game to work on.
  * @return  returns the current state
  */
-ReflexTest_st TimerModel_GetCurrentState(void);
+ReflexTest_st TimerModel_GetCurrentState(ReflexTest_Context* context);
+
+/**
+ * Sets the measurement overhead to take out of every response time, see
+ * Calibration_GetStimulusOverhead.
+ * @param context  The game to work on.
+ * @param stimulus From the LED timestamp to the LED being on, in ns.
+ */
+void TimerModel_SetOverhead(ReflexTest_Context* context, uint32_t stimulus);
+
+/**
+ * Sets how fast a response can be before it is taken for a false start.
+ * Starts at REFLEXTESTDATA_FALSE_START_FLOOR.
+ * @param context The game to work on.
+ * @param floor   The fastest response that counts, in us.
+ */
+void TimerModel_SetFalseStartFloor(ReflexTest_Context* context, uint32_t floor);
+
+/**
+ * Returns whether a response is a false start: a button went down before
+ * the LED went on, or the response was faster than the floor.
+ * @param  context      The game to work on.
+ * @param  responseTime The response time in microseconds.
+ * @return              TRUE if the response should not count.
+ */
+bool TimerModel_IsFalseStart(ReflexTest_Context* context, uint32_t responseTime);
+
+/**
+ * Returns the response time to the LED that went on last: from the stimulus
+ * timestamp to the timestamp of the press, both on the free-running global
+ * timer. If the button interrupt did not stamp a press after the stimulus,
+ * the press is taken to be now. The overhead is taken out, to the nearest
+ * microsecond.
+ * @param  context The game to work on.
+ * @param  now     The current time in microseconds.
+ * @return         The response time in microseconds.
+ */
+uint32_t TimerModel_GetResponseTime(ReflexTest_Context* context, uint64_t now);
 
 /**
  * Sets the most recent response time in ReflexTestData to the parameter.
- * @param responseTime The response time value to save.
+ * @param context The game to work on.
+ * @param responseTime The response time value to save in microseconds.
  */
-void TimerModel_SetMostRecentResponseTime(double responseTime);
+void TimerModel_SetMostRecentResponseTime(ReflexTest_Context* context, uint32_t responseTime);
 
 /**
  * This triggers an actual save of the passed-in response time to the internal
  * array storing this rounds response times. Stores the responseTime at the
- * index of the current sequence. These stats are then used in calculation.
- * @param responseTime The response time to save for the round.
+ * index of the current sequence. These stats are then used in calculation,
+ * unless the response was a false start, see TimerModel_IsFalseStart.
+ * @param context The game to work on.
+ * @param responseTime The response time to save for the round in microseconds.
  */
-void TimerModel_RecordResponseTime(double responseTime);
+void TimerModel_RecordResponseTime(ReflexTest_Context* context, uint32_t responseTime);
 
 /**
- * Deletes all the stats from the previous run to be ready for the new round.
+ * Deletes all the stats from the previous run to be ready for the new round,
+ * and forgets any early press.
+ * @param context The game to work on.
  */
-void TimerModel_ClearOldStats();
+void TimerModel_ClearOldStats(ReflexTest_Context* context);
 
 /**
- * Calculates the MIN, MAX, and AVERAGE for this run of the reflex test.
+ * Calculates the MIN, MAX, and AVERAGE for this run of the reflex test,
+ * leaving out the false starts, and counts the false starts.
+ * @param context The game to work on.
  */
-void TimerModel_CalculateStats();
+void TimerModel_CalculateStats(ReflexTest_Context* context);
 
 /**
  * Returns the minimum response time of the round.
- * @return The minimum response time of the round.
+ * @param context The game to work on.
+ * @return The minimum response time of the round in microseconds.
  */
-double TimerModel_GetMin();
+uint32_t TimerModel_GetMin(ReflexTest_Context* context);
 
 /**
  * Returns the maximum response time of the round.
- * @return The maximum response time of the round.
+ * @param context The game to work on.
+ * @return The maximum response time of the round in microseconds.
  */
-double TimerModel_GetMax();
+uint32_t TimerModel_GetMax(ReflexTest_Context* context);
 
 /**
  * Returns the average response time of the round.
- * @return The average response time of the round.
+ * @param context The game to work on.
+ * @return The average response time of the round in microseconds.
  */
-double TimerModel_GetAverage();
+uint32_t TimerModel_GetAverage(ReflexTest_Context* context);
 
 #endif /* TIMERMODEL_H_ */
@@ -0,0 +1,76 @@
+#include "TouchHardware.h"
+#include "LcdHardware.h"
+#include "SpscQueue.h"
+#include "displayTouch.h"
+#include "../vendor/supportFiles/globalTimer.h"
+
+#define TOUCHHARDWARE_TICKS_PER_MICROSECOND (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000)
+
+// Times at which the touch controller's interrupt fired, waiting for
+// TouchHardware_Read().
+static uint64_t interruptBuffer[TOUCHHARDWARE_INTERRUPT_CAPACITY];
+static SpscQueue interrupts;
+static bool interruptsEnabled;
+
+/**
+ * Runs in the touch controller's interrupt: only stamps it. The FIFO is
+ * read over SPI by the tick, not here.
+ */
+static void TouchHardware_CaptureInterrupt(void) {
+  uint64_t timestamp = globalTimer_getTimerValue();
+  SpscQueue_Push(&interrupts, &timestamp);
+}
+
+void TouchHardware_Init(void) {
+  display_initTouch();
+  display_clearOldTouchData();
+
+  SpscQueue_Init(&interrupts, interruptBuffer, sizeof(uint64_t), TOUCHHARDWARE_INTERRUPT_CAPACITY);
+  // Without the interrupt, the FIFO is simply polled.
+  interruptsEnabled = (display_enableTouchInterrupts(TouchHardware_CaptureInterrupt) ==
+                       DISPLAY_TOUCH_STATUS_OK);
+}
+
+uint32_t TouchHardware_Read(uint64_t* lastPoll, int32_t touched, TouchHardware_Event events[]) {
+  display_touchPoint_t points[TOUCHHARDWARE_POINTS_PER_READ];
+  uint64_t now = globalTimer_getTimerValue();
+  uint64_t interrupt = now;
+  uint64_t later;
+  uint32_t count = 0;
+  uint8_t i;
+
+  // The earliest interrupt dates the samples; later ones only repeat it.
+  if (interruptsEnabled) {
+    if (!SpscQueue_Pop(&interrupts, &interrupt)) {
+      return 0;
+    }
+    while (SpscQueue_Pop(&interrupts, &later)) {
+    }
+  } else {
+    // Every poll is an SPI transfer, too slow to make on a 50 us tick.
+    if (now - *lastPoll < (uint64_t) TOUCHHARDWARE_POLL_PERIOD * TOUCHHARDWARE_TICKS_PER_MICROSECOND) {
+      return 0;
+    }
+    *lastPoll = now;
+  }
+
+  uint8_t samples = display_readTouchedPoints(points, TOUCHHARDWARE_POINTS_PER_READ);
+  if (samples != 0) {
+    int32_t targets = 0;
+    for (i = 0; i < samples; i++) {
+      targets |= LcdHardware_GetTargetAt(points[i].x);
+    }
+    events[count].timestamp = interrupt;
+    events[count].targets = targets;
+    count++;
+    touched = targets;
+  }
+
+  // Lifting a finger leaves nothing in the FIFO, so ask the panel.
+  if (touched != 0 && !display_isTouched()) {
+    events[count].timestamp = now;
+    events[count].targets = 0;
+    count++;
+  }
+  return count;
+}
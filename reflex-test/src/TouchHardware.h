@@ -0,0 +1,59 @@
+#ifndef _TouchHardware_H
+#define _TouchHardware_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The touch controller collects samples in its FIFO while the panel is
+// touched. Its interrupt is only timestamped; the tick then drains the FIFO
+// in SPI bursts and turns the samples into the on-screen targets they hit.
+// Without the interrupt the FIFO is polled, but no more often than once per
+// TOUCHHARDWARE_POLL_PERIOD, however fast the tick runs.
+
+// Samples drained from the FIFO per read. The rest wait for the next read.
+#define TOUCHHARDWARE_POINTS_PER_READ 16
+
+// Number of touch interrupts that can be queued between two reads.
+#define TOUCHHARDWARE_INTERRUPT_CAPACITY 16
+
+// At most this many events come out of one TouchHardware_Read().
+#define TOUCHHARDWARE_MAX_EVENTS 2
+
+// Without the interrupt, the FIFO is polled at most once in this many
+// microseconds: the default tick, slow enough for the SPI bus.
+#define TOUCHHARDWARE_POLL_PERIOD 1000
+
+
+/**
+ * One change of the targets being touched.
+ */
+typedef struct {
+  uint64_t timestamp;   // global timer ticks, see TouchHardware_Read
+  int32_t targets;      // one bit per target touched, as for the LEDs
+  uint32_t reserved;
+} TouchHardware_Event;
+
+/**
+ * Starts the touch controller with an empty FIFO and connects its
+ * interrupt, which timestamps every touch and every sample.
+ */
+void TouchHardware_Init(void);
+
+/**
+ * Drains the touch controller's FIFO into events, oldest first. Samples are
+ * dated to the earliest interrupt since the last read, or to now if the
+ * interrupt is not available. When the targets were touched and the panel
+ * has been let go, a last event with no targets is dated to now. With the
+ * interrupt, nothing is read over SPI unless it has fired; without it,
+ * nothing is read until TOUCHHARDWARE_POLL_PERIOD has passed since the last
+ * poll.
+ * @param  lastPoll When the FIFO was last polled, in global timer ticks.
+ *                  Kept by the caller, and moved on by every poll.
+ * @param  touched  The targets touched as of the last event.
+ * @param  events   Where to store up to TOUCHHARDWARE_MAX_EVENTS events.
+ * @return          The number of events stored.
+ */
+uint32_t TouchHardware_Read(uint64_t* lastPoll, int32_t touched, TouchHardware_Event events[]);
+
+
+#endif //_TouchHardware_H
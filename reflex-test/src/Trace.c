@@ -0,0 +1,57 @@
+#include "Trace.h"
+#include "SpscQueue.h"
+#include <stdio.h>
+
+static Trace_Entry entries[TRACE_CAPACITY];
+static SpscQueue queue;
+static bool enabled = false;
+static uint32_t sequence;
+
+void Trace_Init() {
+  SpscQueue_Init(&queue, entries, sizeof(Trace_Entry), TRACE_CAPACITY);
+  sequence = 0;
+  enabled = true;
+}
+
+void Trace_RecordTransition(uint64_t timestamp, ReflexTest_st from, ReflexTest_st to,
+                            uint8_t actions) {
+  Trace_Entry entry;
+  if (!enabled) {
+    return;
+  }
+  entry.timestamp = timestamp;
+  entry.sequence = sequence++;
+  entry.from = (uint8_t) from;
+  entry.to = (uint8_t) to;
+  entry.actions = actions;
+  entry.reserved = 0;
+  SpscQueue_Push(&queue, &entry);
+}
+
+bool Trace_Pop(Trace_Entry* entry) {
+  return enabled && SpscQueue_Pop(&queue, entry);
+}
+
+uint32_t Trace_GetCount() {
+  return enabled ? SpscQueue_GetCount(&queue) : 0;
+}
+
+uint32_t Trace_GetDropped() {
+  return enabled ? SpscQueue_GetDropped(&queue) : 0;
+}
+
+uint32_t Trace_Drain(uint32_t maxEntries) {
+  Trace_Entry entry;
+  uint32_t printed = 0;
+  while (printed < maxEntries && Trace_Pop(&entry)) {
+    const uint8_t* bytes = (const uint8_t*) &entry;
+    uint32_t i;
+    printf("trace ");
+    for (i = 0; i < sizeof(entry); i++) {
+      printf("%02x", bytes[i]);
+    }
+    printf("\n\r");
+    printed++;
+  }
+  return printed;
+}
@@ -0,0 +1,77 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ReflexTestData.h"
+
+// Number of entries the trace can hold before new ones are dropped.
+#define TRACE_CAPACITY 1024
+
+// Which conductors had an action in the state that was left, see
+// Trace_Entry.actions.
+#define TRACE_BUTTON_ACTION 0x1
+#define TRACE_TIMER_ACTION  0x2
+#define TRACE_LED_ACTION    0x4
+#define TRACE_LCD_ACTION    0x8
+
+/**
+ * One state transition. 16 bytes, laid out so that a little-endian dump can
+ * be decoded on any machine (see host/traceDecoder.c).
+ */
+typedef struct Trace_Entry {
+  uint64_t timestamp;   // when the tick that made the transition started, in us
+  uint32_t sequence;    // counts every transition, so gaps show dropped entries
+  uint8_t from;         // ReflexTest_st that was left
+  uint8_t to;           // ReflexTest_st that was entered
+  uint8_t actions;      // TRACE_*_ACTION bits run in the state that was left
+  uint8_t reserved;
+} Trace_Entry;
+
+/**
+ * Empties the trace and starts recording. Until this is called, nothing is
+ * recorded, so games that do not want a trace pay a single test per
+ * transition.
+ */
+void Trace_Init(void);
+
+/**
+ * Records a state transition. Safe to call from the tick; it never blocks
+ * or prints. If the trace is full, the entry is dropped.
+ * @param timestamp When the tick started, in microseconds.
+ * @param from      The state that was left.
+ * @param to        The state that was entered.
+ * @param actions   TRACE_*_ACTION bits for the actions that ran in from.
+ */
+void Trace_RecordTransition(uint64_t timestamp, ReflexTest_st from, ReflexTest_st to,
+                            uint8_t actions);
+
+/**
+ * Takes the oldest entry out of the trace.
+ * @param  entry Where to copy the entry.
+ * @return       FALSE if the trace is empty.
+ */
+bool Trace_Pop(Trace_Entry* entry);
+
+/**
+ * Returns how many entries are waiting to be drained.
+ * @return The number of entries.
+ */
+uint32_t Trace_GetCount(void);
+
+/**
+ * Returns how many entries were dropped because the trace was full.
+ * @return The number of dropped entries.
+ */
+uint32_t Trace_GetDropped(void);
+
+/**
+ * Prints up to the given number of entries, oldest first, as "trace" lines
+ * of hex for host/traceDecoder.c. Call this when the CPU is idle, or with
+ * UINT32_MAX to dump the whole trace on demand.
+ * @param  maxEntries The most entries to print.
+ * @return            The number of entries printed.
+ */
+uint32_t Trace_Drain(uint32_t maxEntries);
+
+#endif /* TRACE_H_ */
@@ -7,13 +7,19 @@
 #include <stdio.h>
 #include "buttons.h"
 #include "../../reflex-test_bsp/ps7_cortexa9_0/include/xparameters.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xstatus.h"
+#include "../vendor/supportFiles/interrupts.h"
 #include "display.h"
+#include "events.h"
 
 // Screen Position Macros
 #define FOURTH(X)         ((X)/4) // Divide the given number by 4
 #define HALF(X)           ((X)/2) // Divide the given number by 2
 #define THREE_FOURTHS(X)  (((X) * 3)/4) // Multiply by 3, then divide by 4
 
+// Called on every button edge once interrupts are enabled.
+static buttons_edgeHandler_t edgeHandler = NULL;
+
 // Globals to track button statuses
 uint8_t btn0_status = BUTTONS_NOT_SET;  // Initialize as NOT_SET
 uint8_t btn1_status = BUTTONS_NOT_SET;  // Initialize as NOT_SET
@@ -38,8 +44,8 @@ uint16_t y_three_fourths; // y-value of the bottom fourth of the screen
 // Helper function to read GPIO registers.
 // @param offset offset from the base address to read from
 int32_t buttons_readGpioRegister(int32_t offset) {
-  // Casted to (uint32_t *) to match data types
-  uint32_t *ptr = (uint32_t *)XPAR_GPIO_PUSH_BUTTONS_BASEADDR + offset;
+  // The offset is in bytes, so add it before the cast.
+  volatile uint32_t *ptr = (volatile uint32_t *)(XPAR_GPIO_PUSH_BUTTONS_BASEADDR + offset);
   return *ptr;
 }
 
@@ -47,8 +53,8 @@ int32_t buttons_readGpioRegister(int32_t offset) {
 // @param offset offset from the base address to write to
 // @param value 32-bit value to write to the register
 void buttons_writeGpioRegister(int32_t offset, uint32_t value) {
-  // Casted to (uint32_t *) to match data types
-  uint32_t *ptr = (uint32_t *)XPAR_GPIO_PUSH_BUTTONS_BASEADDR + offset;
+  // The offset is in bytes, so add it before the cast.
+  volatile uint32_t *ptr = (volatile uint32_t *)(XPAR_GPIO_PUSH_BUTTONS_BASEADDR + offset);
   *ptr = value;
 }
 
@@ -141,6 +147,16 @@ void buttons_write_LCD(int32_t buttons) {
   }
 }
 
+// GPIO interrupt service routine. The status bit is cleared before the
+// handler runs, so an edge that comes while it runs raises a new interrupt.
+static void buttons_isr(void* callBackRef) {
+  buttons_writeGpioRegister(BUTTONS_IP_ISR_OFFSET, BUTTONS_CHANNEL1_INTERRUPT);
+  if (edgeHandler != NULL) {
+    edgeHandler();
+  }
+  events_post(EVENTS_BUTTON_EDGE);  // Wake up the main loop to read it.
+}
+
 //*********************** End Helper Functions ********************************
 
 int buttons_init() {
@@ -153,6 +169,20 @@ int buttons_init() {
   return status;
 }
 
+int buttons_enableInterrupts(buttons_edgeHandler_t handler) {
+  edgeHandler = handler;
+  // Forget edges from before, then enable channel 1 and the global enable.
+  buttons_writeGpioRegister(BUTTONS_IP_ISR_OFFSET,
+                            buttons_readGpioRegister(BUTTONS_IP_ISR_OFFSET));
+  buttons_writeGpioRegister(BUTTONS_IP_IER_OFFSET, BUTTONS_CHANNEL1_INTERRUPT);
+  buttons_writeGpioRegister(BUTTONS_GIER_OFFSET, BUTTONS_GIER_ENABLE);
+  if (interrupts_connectIsr(XPAR_FABRIC_GPIO_PUSH_BUTTONS_IP2INTC_IRPT_INTR,
+                            buttons_isr, NULL) != XST_SUCCESS) {
+    return BUTTONS_INIT_STATUS_FAIL;
+  }
+  return BUTTONS_INIT_STATUS_OK;
+}
+
 int32_t buttons_read() {
 
   // Read the value of the buttons
@@ -21,6 +21,13 @@
 #define BUTTONS_TRISTATE_OFFSET 4
 #define BUTTONS_TRISTATE_SET_AS_INPUT 0xF
 
+// Values for working with the GPIO interrupt
+#define BUTTONS_GIER_OFFSET 0x11C       // global interrupt enable
+#define BUTTONS_IP_ISR_OFFSET 0x120     // interrupt status, write 1 to clear
+#define BUTTONS_IP_IER_OFFSET 0x128     // interrupt enable
+#define BUTTONS_GIER_ENABLE 0x80000000
+#define BUTTONS_CHANNEL1_INTERRUPT 0x1
+
 // Button Mask Values
 #define BUTTONS_BTN0_MASK       0x1
 #define BUTTONS_BTN1_MASK       0x2
@@ -37,6 +44,15 @@
 //    - BUTTONS_INIT_STATUS_FAIL
 int buttons_init();
 
+// Called from the GPIO interrupt whenever a button changes value.
+typedef void (*buttons_edgeHandler_t)(void);
+
+// Enables the GPIO interrupt, which calls the handler on every edge of any
+// button, press or release. Returns BUTTONS_INIT_STATUS_FAIL if the
+// interrupt cannot be connected, in which case the buttons can only be
+// polled.
+int buttons_enableInterrupts(buttons_edgeHandler_t handler);
+
 // Returns the current value of all 4 buttons as the lower 4 bits of the
 // returned value.
 // bit3 = BTN3, bit2 = BTN2, bit1 = BTN1, bit0 = BTN0.
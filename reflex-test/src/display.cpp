@@ -6,8 +6,12 @@
  */
 
 #include "display.h"
+#include "events.h"
 #include "../vendor/supportFiles/Adafruit_TFTLCD.h"
 #include "../vendor/supportFiles/Adafruit_STMPE610.h"
+#include "../vendor/supportFiles/interrupts.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xparameters.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xstatus.h"
 #include <stdbool.h>
 
 // Just define these values here. They won't change in practice and I want to avoid
@@ -24,16 +28,23 @@
 #define TOUCH_SCREEN_MAX_X 3950.0  // This is where the touch-screen maxes out in X.
 #define TOUCH_SCREEN_MAX_Y 4095.0
 
+// The fabric interrupt that the touch controller's INT pin is routed to, if the
+// bitstream routes it. The current one does not, so touch can only be polled.
+#ifdef XPAR_FABRIC_TOUCH_SCREEN_INT_INTR
+#define TOUCH_SCREEN_INTERRUPT_ID XPAR_FABRIC_TOUCH_SCREEN_INT_INTR
+#endif
+
 bool initFlag = false;  // Only allow init to be called once.
+static bool touchInitFlag = false;
 static Adafruit_TFTLCD lcdDisplay = Adafruit_TFTLCD();  // Handle to the LCD display.
 static Adafruit_STMPE610 touchController = Adafruit_STMPE610();
+static display_touchHandler_t touchHandler = NULL;
 
 // Will only execute the body once.
 void display_init() {
   if (!initFlag) {
     lcdDisplay.begin();
     lcdDisplay.setRotation(1);
-    touchController.begin();
   }
 }
 
@@ -180,6 +191,35 @@ size_t display_println(void) {
 
 // These are functions related to the touch-pad.
 
+// Will only execute the body once.
+void display_initTouch() {
+  if (!touchInitFlag) {
+    touchController.begin();
+    touchInitFlag = true;
+  }
+}
+
+// The controller's INT pin is edge-triggered (see Adafruit_STMPE610::begin()), so there
+// is nothing to clear here; display_readTouchedPoints() clears the status over SPI.
+static void display_touchIsr(void* callBackRef) {
+  if (touchHandler != NULL) {
+    touchHandler();
+  }
+  events_post(EVENTS_BUTTON_EDGE);  // A touch is read like a button press.
+}
+
+int display_enableTouchInterrupts(display_touchHandler_t handler) {
+#ifdef TOUCH_SCREEN_INTERRUPT_ID
+  touchHandler = handler;
+  if (interrupts_connectIsr(TOUCH_SCREEN_INTERRUPT_ID, display_touchIsr, NULL) != XST_SUCCESS) {
+    return DISPLAY_TOUCH_STATUS_FAIL;
+  }
+  return DISPLAY_TOUCH_STATUS_OK;
+#else
+  return DISPLAY_TOUCH_STATUS_FAIL;
+#endif
+}
+
 // True if the display is being touched.
 bool display_isTouched(void) {
   return touchController.touched();
@@ -218,6 +258,24 @@ void display_getTouchedPoint(int16_t *x, int16_t *y, uint8_t *z) {
   display_mapToLcdCoordinates(x, y);
 }
 
+// Reads the samples in one burst and maps them to LCD coordinates.
+uint8_t display_readTouchedPoints(display_touchPoint_t points[], uint8_t maxPoints) {
+  TS_Point samples[DISPLAY_TOUCH_FIFO_DEPTH];
+  if (maxPoints > DISPLAY_TOUCH_FIFO_DEPTH) {
+    maxPoints = DISPLAY_TOUCH_FIFO_DEPTH;
+  }
+  uint8_t count = touchController.readFifo(samples, maxPoints);
+  for (uint8_t i = 0; i < count; i++) {
+    int16_t x = samples[i].x;
+    int16_t y = samples[i].y;
+    display_mapToLcdCoordinates(&x, &y);
+    points[i].x = x;
+    points[i].y = y;
+    points[i].z = samples[i].z;
+  }
+  return count;
+}
+
 // Throws away all previous touch data.
 void display_clearOldTouchData() {
   touchController.clearOldTouchData();
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "displayTouch.h"  // The touch-panel half of this API.
 
 #define DISPLAY_DEC 10
 #define DISPLAY_HEX 16
@@ -30,7 +31,7 @@
 // will be C-like, with a functional interface that does not require the user to use constructors or objects.
 // These functions are mostly just wrappers around C++ methods so they can be used for C programming.
 
-// Constructs the necessary LCD and touch-controller objects and performs necessary initializations.
+// Constructs the necessary LCD and touch-controller objects and initializes the LCD.
 void display_init();
 
 // The functionality for these functions comes from Adafruit_GFX.cpp and Adafruit_TFTLCD.cpp.
@@ -91,13 +92,6 @@ void
   unsigned long display_testFillScreen();
   unsigned long display_testText();
 
-// The functionality for these routines comes from Adafruit_STMPE610 (touch controller).
-// True if the display is being touched.
-bool display_isTouched(void);
-// Returns the x-y coordinate point and the pressure (z).
-void display_getTouchedPoint(int16_t *x, int16_t *y, uint8_t *z);
-// Throws away all previous touch data.
-void display_clearOldTouchData();
 
 
 #endif /* DISPLAY_H_ */
@@ -0,0 +1,50 @@
+/*
+ * displayTouch.h
+ *
+ * The touch-panel half of the display API. It has a header of its own so
+ * that code which only reads touch can be tested against it; the drawing
+ * functions in display.h are declared in lists that CMock cannot mock.
+ */
+
+#ifndef DISPLAYTOUCH_H_
+#define DISPLAYTOUCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Status values for display_enableTouchInterrupts().
+#define DISPLAY_TOUCH_STATUS_OK   1
+#define DISPLAY_TOUCH_STATUS_FAIL 0
+
+// The touch controller's FIFO holds at most this many samples.
+#define DISPLAY_TOUCH_FIFO_DEPTH 128
+
+// One touch sample in LCD coordinates, with its pressure (z).
+typedef struct {
+  int16_t x;
+  int16_t y;
+  uint8_t z;
+} display_touchPoint_t;
+
+// Called from the touch controller's interrupt.
+typedef void (*display_touchHandler_t)(void);
+
+// The functionality for these routines comes from Adafruit_STMPE610 (touch controller).
+// Initializes the touch controller. This is kept apart from display_init() so that the
+// LCD can be drawn by one core while the other reads touch over SPI.
+void display_initTouch();
+// Connects the touch controller's interrupt, which calls the handler when the panel
+// is touched and whenever a sample lands in the FIFO. Returns DISPLAY_TOUCH_STATUS_FAIL
+// if the interrupt cannot be connected, in which case touch can only be polled.
+int display_enableTouchInterrupts(display_touchHandler_t handler);
+// Reads up to maxPoints samples out of the FIFO in one SPI burst, in LCD coordinates.
+// Returns the number of samples read; 0 when the FIFO is empty.
+uint8_t display_readTouchedPoints(display_touchPoint_t points[], uint8_t maxPoints);
+// True if the display is being touched.
+bool display_isTouched(void);
+// Returns the x-y coordinate point and the pressure (z).
+void display_getTouchedPoint(int16_t *x, int16_t *y, uint8_t *z);
+// Throws away all previous touch data.
+void display_clearOldTouchData();
+
+#endif /* DISPLAYTOUCH_H_ */
@@ -0,0 +1,60 @@
+//*****************************************************************************
+// Implementation of the event flags for the ZYBO board.
+// The core is put to sleep with WFI until an interrupt posts an event.
+// Events can also come from the second core, which then raises a software
+// generated interrupt on core 0 to wake it up.
+//*****************************************************************************
+
+#include "events.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_exception.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_io.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xparameters.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xreg_cortexa9.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xscugic_hw.h"
+
+// The software generated interrupt that wakes core 0. No handler is
+// connected; the GIC driver's stub acknowledges it once IRQs are unmasked.
+#define EVENTS_WAKE_SGI 15
+// Sends EVENTS_WAKE_SGI to core 0 only.
+#define EVENTS_WAKE_CORE0 (0x1 << 16)
+// The CPU number in MPIDR.
+#define EVENTS_CPU_ID_MASK 0x3
+
+// Events that have been posted but not yet taken by events_wait(). Both
+// cores and the ISRs change it, so it is only changed with atomic operations.
+static volatile uint32_t pendingEvents = EVENTS_NONE;
+
+void events_init() {
+  __atomic_store_n(&pendingEvents, EVENTS_NONE, __ATOMIC_SEQ_CST);
+}
+
+void events_post(uint32_t events) {
+  // LDREX/STREX: an ISR or the other core that posts in between makes the
+  // store fail and retry, so nothing is lost and IRQs stay as they are.
+  __atomic_fetch_or(&pendingEvents, events, __ATOMIC_SEQ_CST);
+  if ((mfcp(XREG_CP15_MULTI_PROC_AFFINITY) & EVENTS_CPU_ID_MASK) != 0) {
+    // A pending interrupt wakes WFI even while core 0 has IRQs masked.
+    Xil_Out32(XPAR_SCUGIC_0_DIST_BASEADDR + XSCUGIC_SFI_TRIG_OFFSET,
+              EVENTS_WAKE_CORE0 | EVENTS_WAKE_SGI);
+  }
+}
+
+uint32_t events_wait() {
+  uint32_t events;
+  u32 cpsr = mfcpsr();
+
+  // Check for events with IRQs masked so that an interrupt can't slip in
+  // between the check and the WFI. WFI still wakes up on a pending IRQ while
+  // IRQs are masked, and restoring the CPSR lets the ISR run and post its
+  // event. The caller's IRQ mask is left as it was.
+  mtcpsr(cpsr | XIL_EXCEPTION_IRQ);
+  while (__atomic_load_n(&pendingEvents, __ATOMIC_SEQ_CST) == EVENTS_NONE) {
+    __asm__ __volatile__("wfi");
+    mtcpsr(cpsr);
+    mtcpsr(cpsr | XIL_EXCEPTION_IRQ);
+  }
+  events = __atomic_exchange_n(&pendingEvents, EVENTS_NONE, __ATOMIC_SEQ_CST);
+  mtcpsr(cpsr);
+
+  return events;
+}
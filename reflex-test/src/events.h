@@ -0,0 +1,29 @@
+//*****************************************************************************
+// Interface for the event flags that wake up the main loop.
+// Interrupt handlers post events, and the main loop sleeps (WFI) until at
+// least one event is pending instead of busy-polling a flag.
+//*****************************************************************************
+
+#ifndef EVENTS_H_
+#define EVENTS_H_
+
+#include <stdint.h>
+
+// Event Mask Values
+#define EVENTS_NONE           0x0
+#define EVENTS_TIMER_TICK     0x1   // The private timer ticked.
+#define EVENTS_BUTTON_EDGE    0x2   // A push button changed value, or the touchscreen was touched.
+#define EVENTS_RENDER_DONE    0x4   // The second core finished drawing the frames sent to it.
+
+// Clears all pending events.
+void events_init();
+
+// Marks the given events as pending and wakes up events_wait().
+// Safe to call from an interrupt handler and from the second core.
+void events_post(uint32_t events);
+
+// Sleeps until at least one event is pending, then returns the mask of all
+// pending events and clears them.
+uint32_t events_wait();
+
+#endif /* EVENTS_H_ */
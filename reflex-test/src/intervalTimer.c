@@ -318,3 +318,104 @@ uint32_t intervalTimer_getTotalDurationInSeconds( uint32_t timerNumber,
 
   return 0;
 }
+
+// Word index of each register, for the fast path.
+#define INTERVALTIMER_WORD(offset) ((offset) / sizeof(uint32_t))
+
+uint32_t intervalTimer_getHandle(uint32_t timerNumber, intervalTimer_Handle* handle) {
+  uintptr_t baseAddress;
+
+  // Determine which base address to use based on the timerNumber
+  switch (timerNumber) {
+    case INTERVALTIMER_TIMER0:
+      baseAddress = XPAR_AXI_TIMER_0_BASEADDR;
+      break;
+    case INTERVALTIMER_TIMER1:
+      baseAddress = XPAR_AXI_TIMER_1_BASEADDR;
+      break;
+    case INTERVALTIMER_TIMER2:
+      baseAddress = XPAR_AXI_TIMER_2_BASEADDR;
+      break;
+    default:  // invalid timer number
+      printf("\nERROR: Not a valid timer number.\n\n");
+      return INTERVALTIMER_TIMER_ERROR;
+  }
+
+  // Start from the state intervalTimer_init() leaves, so the shadow matches.
+  intervalTimer_init(timerNumber);
+  handle->registers = (volatile uint32_t*) baseAddress;
+  handle->tcsr0 = intervalTimer_enableCASC(0);
+  handle->timerNumber = timerNumber;
+  handle->frequency = intervalTimer_getTimerFrequency(timerNumber);
+
+  // 2^32 cycles in microseconds, whole seconds first so nothing overflows.
+  uint64_t wrap = ((1ULL << INTERVALTIMER_REGISTER_WIDTH) / handle->frequency) * 1000000 +
+                  (((1ULL << INTERVALTIMER_REGISTER_WIDTH) % handle->frequency) * 1000000) /
+                  handle->frequency;
+  handle->wrapMicroseconds = (wrap > UINT32_MAX) ? UINT32_MAX : (uint32_t) wrap;
+  return 0;
+}
+
+void intervalTimer_fastStart(intervalTimer_Handle* handle) {
+  handle->tcsr0 |= INTERVALTIMER_ENABLE_ENT0_MASK;
+  handle->registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR0_OFFSET)] = handle->tcsr0;
+}
+
+void intervalTimer_fastStop(intervalTimer_Handle* handle) {
+  handle->tcsr0 &= INTERVALTIMER_CLEAR_ENT0_MASK;
+  handle->registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR0_OFFSET)] = handle->tcsr0;
+}
+
+void intervalTimer_fastReset(intervalTimer_Handle* handle) {
+  volatile uint32_t* registers = handle->registers;
+
+  // Load 0 into both halves, then put TCSR0 back as it was.
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TLR0_OFFSET)] = 0;
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TLR1_OFFSET)] = 0;
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR0_OFFSET)] =
+      handle->tcsr0 | INTERVALTIMER_ENABLE_LOAD0_MASK;
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR1_OFFSET)] = INTERVALTIMER_ENABLE_LOAD0_MASK;
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR0_OFFSET)] = handle->tcsr0;
+  registers[INTERVALTIMER_WORD(INTERVALTIMER_TCSR1_OFFSET)] = 0;
+}
+
+uint64_t intervalTimer_fastRead(const intervalTimer_Handle* handle) {
+  volatile uint32_t* registers = handle->registers;
+
+  uint32_t upper_bits = registers[INTERVALTIMER_WORD(INTERVALTIMER_TCR1_OFFSET)];
+  uint32_t lower_bits = registers[INTERVALTIMER_WORD(INTERVALTIMER_TCR0_OFFSET)];
+  uint32_t upper_bits_2 = registers[INTERVALTIMER_WORD(INTERVALTIMER_TCR1_OFFSET)];
+
+  // If the upper half moved, the lower half wrapped between the reads, and
+  // upper_bits_2:0 is a value the counter held in between. Clear the lower
+  // half with a mask instead of reading it again.
+  lower_bits &= -(uint32_t) (upper_bits == upper_bits_2);
+
+  uint64_t counterValue = upper_bits_2;
+  counterValue <<= INTERVALTIMER_REGISTER_WIDTH;
+  counterValue |= lower_bits;
+  return counterValue;
+}
+
+uint64_t intervalTimer_fastElapsed(const intervalTimer_Handle* handle,
+                                   uint64_t start,
+                                   uint32_t boundMicroseconds) {
+  if (boundMicroseconds < handle->wrapMicroseconds) {
+    // One load; unsigned subtraction is correct across a wrap of TCR0.
+    uint32_t lower_bits = handle->registers[INTERVALTIMER_WORD(INTERVALTIMER_TCR0_OFFSET)];
+    return (uint32_t) (lower_bits - (uint32_t) start);
+  }
+  return intervalTimer_fastRead(handle) - start;
+}
+
+uint32_t intervalTimer_getTotalDurationInMicroseconds( uint32_t timerNumber,
+                                                       uint64_t *microseconds) {
+  uint64_t clockCycles = intervalTimer_read64bitCounter(timerNumber);
+  uint64_t frequency = intervalTimer_getTimerFrequency(timerNumber);
+
+  // Whole seconds first, then the remainder, so that nothing overflows.
+  *microseconds = (clockCycles / frequency) * 1000000 +
+                  ((clockCycles % frequency) * 1000000) / frequency;
+
+  return 0;
+}
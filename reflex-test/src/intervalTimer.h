@@ -34,6 +34,20 @@
 // Width of each register in the timer
 #define INTERVALTIMER_REGISTER_WIDTH 32
 
+/**
+ * A timer resolved once by intervalTimer_getHandle() for the fast path. It
+ * caches the base address and shadows TCSR0, so starting and stopping are a
+ * single store with no validation. Don't mix it with the numbered functions
+ * on the same timer, or the shadow goes stale.
+ */
+typedef struct intervalTimer_Handle {
+  volatile uint32_t* registers;  // the timer's registers, one word each
+  uint32_t tcsr0;                // the last value written to TCSR0
+  uint32_t timerNumber;
+  uint32_t frequency;            // counter clock in Hz
+  uint32_t wrapMicroseconds;     // how long TCR0 takes to wrap around
+} intervalTimer_Handle;
+
 /**
  * Starts the specified timer.
  * @param  timerNumber Number of the timer to start. Valid values are
@@ -93,5 +107,66 @@ uint32_t intervalTimer_resetAll();
  */
 uint32_t intervalTimer_getTotalDurationInSeconds(uint32_t timerNumber, double *seconds);
 
+/**
+ * Calculates the time that has transpired since the counter was last reset
+ * and started, in whole microseconds, without using floating point.
+ * @param  timerNumber  Number of the timer to start. Valid values are
+ *                      INTERVALTIMER_TIMER0, INTERVALTIMER_TIMER1, and
+ *                      INTERVALTIMER_TIMER2
+ * @param  microseconds Address of the variable for storing elapsed time.
+ * @return              Always returns 0
+ */
+uint32_t intervalTimer_getTotalDurationInMicroseconds(uint32_t timerNumber, uint64_t *microseconds);
+
+/**
+ * Validates a timer number once, initializes the timer as intervalTimer_init()
+ * does and fills in a handle for the fast path below.
+ * @param  timerNumber Number of the timer. Valid values are
+ *                     INTERVALTIMER_TIMER0, INTERVALTIMER_TIMER1, and
+ *                     INTERVALTIMER_TIMER2
+ * @param  handle      The handle to fill in.
+ * @return             0 on success or INTERVALTIMER_TIMER_ERROR on error.
+ */
+uint32_t intervalTimer_getHandle(uint32_t timerNumber, intervalTimer_Handle* handle);
+
+/**
+ * Starts the timer with one store to TCSR0.
+ * @param handle A handle from intervalTimer_getHandle().
+ */
+void intervalTimer_fastStart(intervalTimer_Handle* handle);
+
+/**
+ * Stops the timer with one store to TCSR0.
+ * @param handle A handle from intervalTimer_getHandle().
+ */
+void intervalTimer_fastStop(intervalTimer_Handle* handle);
+
+/**
+ * Sets the cascaded counter to 0 without changing whether it runs.
+ * @param handle A handle from intervalTimer_getHandle().
+ */
+void intervalTimer_fastReset(intervalTimer_Handle* handle);
+
+/**
+ * Reads the 64-bit counter with three loads and no branch.
+ * @param  handle A handle from intervalTimer_getHandle().
+ * @return        The counter value in timer clock cycles.
+ */
+uint64_t intervalTimer_fastRead(const intervalTimer_Handle* handle);
+
+/**
+ * Returns the cycles counted since an earlier intervalTimer_fastRead(). When
+ * the caller's bound is shorter than TCR0 takes to wrap, only TCR0 is read
+ * and the lower halves are subtracted modulo 2^32, which is exact for any
+ * interval up to the wrap. Otherwise it falls back to the 64-bit read.
+ * @param  handle             A handle from intervalTimer_getHandle().
+ * @param  start              The counter value at the start of the interval.
+ * @param  boundMicroseconds  The longest the interval can be, in us.
+ * @return                    The elapsed time in timer clock cycles.
+ */
+uint64_t intervalTimer_fastElapsed(const intervalTimer_Handle* handle,
+                                   uint64_t start,
+                                   uint32_t boundMicroseconds);
+
 
 #endif /* INTERVALTIMER_H_ */
@@ -0,0 +1,101 @@
+//*****************************************************************************
+// Implementation of the second core driver for the ZYBO board.
+// Both cores run from the one image built for ps7_cortexa9_0. CPU1 skips the
+// BSP's boot code, so secondCore_boot repeats the parts of boot.S that it
+// needs: coherency, the shared MMU table, caches, VFP and a stack.
+//*****************************************************************************
+
+#include "secondCore.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_types.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_io.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_mmu.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xil_cache.h"
+#include "../../reflex-test_bsp/ps7_cortexa9_0/include/xpseudo_asm.h"
+
+// CPU1 jumps to the address stored here once it wakes up from WFE.
+#define SECONDCORE_START_ADDRESS 0xFFFFFFF0
+// The 1 MB section that holds the high on-chip memory.
+#define SECONDCORE_OCM_SECTION   0xFFF00000
+// S=b1 TEX=b100 AP=b11, Domain=b1111, C=b0, B=b0: shareable, not cached.
+#define SECONDCORE_OCM_UNCACHED  0x14de2
+#define SECONDCORE_STACK_BYTES   0x4000
+
+#define SECONDCORE_STRING(x) #x
+#define SECONDCORE_VALUE(x) SECONDCORE_STRING(x)
+
+uint8_t secondCore_stack[SECONDCORE_STACK_BYTES] __attribute__((aligned(8)));
+void (*volatile secondCore_entry)(void);
+
+// Runs on CPU1 with the MMU off. Mirrors boot.S: join the SCU's coherency
+// domain, invalidate the local caches and TLB, switch on the MMU with core
+// 0's translation table, enable the VFP, then call secondCore_entry.
+__asm__(
+  "  .pushsection .text\n"
+  "  .align 5\n"
+  "  .global secondCore_boot\n"
+  "secondCore_boot:\n"
+  "  mrc p15, 0, r0, c1, c0, 1\n"      // ACTLR: SMP and cache maintenance broadcast
+  "  orr r0, r0, #0x41\n"
+  "  mcr p15, 0, r0, c1, c0, 1\n"
+  "  mov r0, #0\n"
+  "  mcr p15, 0, r0, c8, c7, 0\n"      // invalidate TLBs
+  "  mcr p15, 0, r0, c7, c5, 0\n"      // invalidate icache
+  "  mcr p15, 0, r0, c7, c5, 6\n"      // invalidate branch predictor
+  "  mov r2, #0\n"                     // invalidate the 4 way, 256 set L1 dcache
+  "2:\n"
+  "  mov r1, #0\n"
+  "3:\n"
+  "  orr r0, r1, r2\n"
+  "  mcr p15, 0, r0, c7, c6, 2\n"      // DCISW
+  "  add r1, r1, #32\n"
+  "  cmp r1, #0x2000\n"
+  "  bne 3b\n"
+  "  adds r2, r2, #0x40000000\n"
+  "  bne 2b\n"
+  "  ldr r0, =MMUTable\n"
+  "  orr r0, r0, #0x5B\n"              // outer-cacheable, write-back
+  "  mcr p15, 0, r0, c2, c0, 0\n"      // TTBR0
+  "  mvn r0, #0\n"
+  "  mcr p15, 0, r0, c3, c0, 0\n"      // all domains manager
+  "  ldr r0, =0x1805\n"                // MMU, dcache, icache, branch prediction
+  "  mcr p15, 0, r0, c1, c0, 0\n"
+  "  dsb\n"
+  "  isb\n"
+  "  mrc p15, 0, r1, c1, c0, 2\n"      // full access to the VFP
+  "  orr r1, r1, #(0xf << 20)\n"
+  "  mcr p15, 0, r1, c1, c0, 2\n"
+  "  fmrx r1, FPEXC\n"
+  "  orr r1, r1, #0x40000000\n"
+  "  fmxr FPEXC, r1\n"
+  "  ldr sp, =secondCore_stack + " SECONDCORE_VALUE(SECONDCORE_STACK_BYTES) "\n"
+  "  ldr r0, =secondCore_entry\n"
+  "  ldr r0, [r0]\n"
+  "  blx r0\n"
+  "1:\n"
+  "  wfe\n"
+  "  b 1b\n"
+  "  .ltorg\n"
+  "  .popsection\n");
+
+extern void secondCore_boot(void);
+
+void secondCore_start(void (*entry)(void)) {
+  // Everything the cores share lives in OCM. Take it out of the cache on
+  // both sides rather than keep two L1 caches in step by hand.
+  Xil_SetTlbAttributes(SECONDCORE_OCM_SECTION, SECONDCORE_OCM_UNCACHED);
+  secondCore_entry = entry;
+  // CPU1 reads the entry through its MMU-off, uncached view of DDR.
+  Xil_DCacheFlush();
+  Xil_Out32(SECONDCORE_START_ADDRESS, (u32) secondCore_boot);
+  dsb();
+  __asm__ __volatile__("sev");
+}
+
+void secondCore_notify() {
+  dsb();
+  __asm__ __volatile__("sev");
+}
+
+void secondCore_wait() {
+  __asm__ __volatile__("wfe");
+}
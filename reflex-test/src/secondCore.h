@@ -0,0 +1,22 @@
+//*****************************************************************************
+// Interface for running code on the second Cortex-A9 core (CPU1).
+// After reset the FSBL parks CPU1 in a WFE loop that polls a start address.
+// secondCore_start() hands it a function to run, sharing core 0's image and
+// MMU table. The two cores then signal each other with SEV/WFE.
+//*****************************************************************************
+
+#ifndef SECONDCORE_H_
+#define SECONDCORE_H_
+
+// Starts the second core running the given function, which must not return.
+// The on-chip memory that the cores share is made uncached first.
+void secondCore_start(void (*entry)(void));
+
+// Wakes up the other core if it is sleeping in secondCore_wait().
+void secondCore_notify();
+
+// Sleeps until the other core calls secondCore_notify(). Returns at once if
+// it already has since the last wait, so a notify is never lost.
+void secondCore_wait();
+
+#endif /* SECONDCORE_H_ */
@@ -0,0 +1,22 @@
+#include "fakeGlobalTimer.h"
+
+static u64 now;
+static u64 step;
+
+void fakeGlobalTimer_init(u64 stepTicks) {
+  now = 0;
+  step = stepTicks;
+}
+
+void fakeGlobalTimer_set(u64 ticks) {
+  now = ticks;
+}
+
+void fakeGlobalTimer_advance(u64 ticks) {
+  now += ticks;
+}
+
+u64 fakeGlobalTimer_read(int cmock_num_calls) {
+  now += step;
+  return now;
+}
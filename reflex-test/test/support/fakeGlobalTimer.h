@@ -0,0 +1,37 @@
+#ifndef FAKEGLOBALTIMER_H_
+#define FAKEGLOBALTIMER_H_
+
+#include "xil_types.h"
+
+// A stand-in for the global timer in tests that mock globalTimer.h. The
+// time only moves when the test moves it, or by a set step on every read.
+// Install it in setUp() with
+//   globalTimer_getTimerValue_StubWithCallback(fakeGlobalTimer_read);
+
+/**
+ * Sets the time to 0.
+ * @param step Ticks that every read moves the time on by, or 0.
+ */
+void fakeGlobalTimer_init(u64 step);
+
+/**
+ * Sets the time.
+ * @param ticks The time in global timer ticks.
+ */
+void fakeGlobalTimer_set(u64 ticks);
+
+/**
+ * Moves the time on, as if the code under test took that long.
+ * @param ticks Global timer ticks to add.
+ */
+void fakeGlobalTimer_advance(u64 ticks);
+
+/**
+ * The callback for globalTimer_getTimerValue(). Moves the time on by the
+ * step, then returns it.
+ * @param  cmock_num_calls The number of reads so far, unused.
+ * @return                 The time in global timer ticks.
+ */
+u64 fakeGlobalTimer_read(int cmock_num_calls);
+
+#endif /* FAKEGLOBALTIMER_H_ */
@@ -7,109 +7,199 @@
 
 #include <stdint.h>
 
-void setup(void) {
+// The game that every test works on.
+static ReflexTest_Context context;
+
+// What the next ButtonHardware_Read reports.
+static int32_t heldButtons;
+static ButtonHardware_Press nextPress;
+
+/**
+ * Stands in for ButtonHardware_Read.
+ */
+static int32_t fakeRead(Debounce* debounce, uint64_t* lastTouchPoll, ButtonHardware_Press* press,
+                        int cmock_num_calls) {
+  TEST_ASSERT_EQUAL_PTR(&context.debounce, debounce);
+  TEST_ASSERT_EQUAL_PTR(&context.lastTouchPoll, lastTouchPoll);
+  *press = nextPress;
+  return heldButtons;
+}
+
+/**
+ * Makes the next read report buttons held down and no new press, with the
+ * first of them as the button that came first.
+ */
+static void holdButtons(int32_t buttons) {
+  heldButtons = buttons;
+  nextPress.button = buttons & (~buttons + 1);
+  nextPress.time = 0;
+  nextPress.count = 0;
+}
+
+/**
+ * Makes the next read report new presses, the first of them at 123456 us.
+ */
+static void pressButtons(int32_t first, uint32_t count) {
+  heldButtons = first;
+  nextPress.button = first;
+  nextPress.time = 123456;
+  nextPress.count = count;
+}
+
+void setUp(void) {
+  ButtonHardware_Read_StubWithCallback(fakeRead);
 }
 
 void tearDown(void) {
 }
 
 void testButtonConductor_InitShouldCallModelAndHardwareInit(void) {
-  ButtonModel_Init_Expect();
-  ButtonHardware_Init_Expect();
+  ButtonModel_Init_Expect(&context);
+  ButtonHardware_Init_Expect(&context.debounce, &context.lastTouchPoll);
 
-  ButtonConductor_Init();
+  ButtonConductor_Init(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInShowInfoState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(show_info_st);
-  ButtonConductor_Run();
+void testButtonConductor_ShouldDrainEdgesInShowInfoState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
 }
 
 void testButtonConductor_ListenForButtonsInWaitInfoState(void) {
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN2_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN2_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  holdButtons(BUTTONS_BTN2_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN2_MASK);
+  ButtonConductor_Run(&context);
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN0_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN0_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  holdButtons(BUTTONS_BTN0_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN0_MASK);
+  ButtonConductor_Run(&context);
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN1_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN1_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  holdButtons(BUTTONS_BTN1_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN1_MASK);
+  ButtonConductor_Run(&context);
 }
 
 void testButtonConductor_ListenForButtonsInWaitFiveSecState(void) {
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN2_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN2_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  holdButtons(BUTTONS_BTN2_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN2_MASK);
+  ButtonConductor_Run(&context);
+
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  holdButtons(BUTTONS_BTN0_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN0_MASK);
+  ButtonConductor_Run(&context);
+
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  holdButtons(BUTTONS_BTN1_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN1_MASK);
+  ButtonConductor_Run(&context);
+}
+
+void testButtonConductor_ShouldDrainEdgesInBlankScreenState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, blank_screen_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
+}
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN0_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN0_MASK);
-  ButtonConductor_Run();
+void testButtonConductor_HoldingAButtonBetweenFlashesShouldNotBeAGuess(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  holdButtons(BUTTONS_BTN2_MASK);
+  ButtonConductor_Run(&context);
+}
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN1_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN1_MASK);
-  ButtonConductor_Run();
+void testButtonConductor_PressingBetweenFlashesShouldBeAGuess(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  pressButtons(BUTTONS_BTN1_MASK, 1);
+  ButtonModel_SetAnticipated_Expect(&context);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInBlankScreenState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(blank_screen_st);
-  ButtonConductor_Run();
+void testButtonConductor_DiscardEarlyPressesInBlinkLEDState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  ButtonHardware_DiscardEdges_ExpectAndReturn(&context.debounce, &context.lastTouchPoll, 0x0);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInWaitBetweenFlashState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_between_flash_st);
-  ButtonConductor_Run();
+void testButtonConductor_EarlyPressesInBlinkLEDStateShouldBeAGuess(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  ButtonHardware_DiscardEdges_ExpectAndReturn(&context.debounce, &context.lastTouchPoll, BUTTONS_BTN1_MASK);
+  ButtonModel_SetAnticipated_Expect(&context);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInBlinkLEDState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(blink_led_st);
-  ButtonConductor_Run();
+void testButtonConductor_PassOnTheTimeOfAStampedPress(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  pressButtons(BUTTONS_BTN3_MASK, 1);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN3_MASK);
+  ButtonModel_SetPressTime_Expect(&context, 123456);
+  ButtonModel_CheckResponse_Expect(&context, 123456, 1);
+  ButtonConductor_Run(&context);
 }
 
 void testButtonConductor_ListenForButtonsInWaitForButtonState(void) {
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN2_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN2_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  holdButtons(BUTTONS_BTN2_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN2_MASK);
+  ButtonConductor_Run(&context);
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN0_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN0_MASK);
-  ButtonConductor_Run();
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  holdButtons(BUTTONS_BTN0_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN0_MASK);
+  ButtonConductor_Run(&context);
+
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  holdButtons(BUTTONS_BTN1_MASK);
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN1_MASK);
+  ButtonConductor_Run(&context);
+}
+
+void testButtonConductor_ShouldDrainEdgesInButtonPressedState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, button_pressed_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
+}
 
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  ButtonHardware_Read_ExpectAndReturn(BUTTONS_BTN1_MASK);
-  ButtonModel_SetPressedButton_Expect(BUTTONS_BTN1_MASK);
-  ButtonConductor_Run();
+void testButtonConductor_ShouldDrainEdgesInShowStatsState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, show_stats_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInButtonPressedState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(button_pressed_st);
-  ButtonConductor_Run();
+void testButtonConductor_ShouldDrainEdgesInWaitStatsState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_stats_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInShowStatsState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(show_stats_st);
-  ButtonConductor_Run();
+void testButtonConductor_ShouldDrainEdgesInUpdateScoresState(void) {
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, update_scores_st);
+  ButtonHardware_DrainEdges_Expect(&context.debounce, &context.lastTouchPoll);
+  ButtonConductor_Run(&context);
 }
 
-void testButtonConductor_ShouldDoNothingInWaitStatsState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(wait_stats_st);
-  ButtonConductor_Run();
+void testButtonConductor_EveryStateShouldDrainTheEdges(void) {
+  int state;
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    TEST_ASSERT_NOT_NULL(ButtonConductor_GetAction(state));
+  }
+  TEST_ASSERT_EQUAL_PTR(ButtonConductor_DrainEdges, ButtonConductor_GetAction(init_st));
+  TEST_ASSERT_EQUAL_PTR(ButtonConductor_DrainEdges, ButtonConductor_GetAction(wait_stats_st));
 }
 
-void testButtonConductor_ShouldDoNothingInUpdateScoresState(void) {
-  ButtonModel_GetCurrentState_ExpectAndReturn(update_scores_st);
-  ButtonConductor_Run();
+void testButtonConductor_PassOnTheButtonThatCameFirst(void) {
+  // Button 2 went down before button 0, so it is the one that counts.
+  ButtonModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  pressButtons(BUTTONS_BTN2_MASK, 2);
+  heldButtons = BUTTONS_BTN0_MASK | BUTTONS_BTN2_MASK;
+  ButtonModel_SetPressedButton_Expect(&context, BUTTONS_BTN2_MASK);
+  ButtonModel_SetPressTime_Expect(&context, 123456);
+  ButtonConductor_Run(&context);
 }
@@ -1,49 +1,340 @@
 #include "unity.h"
 #include "ButtonHardware.h"
+#include "Debounce.h"
 #include "mock_ButtonModel.h"
 #include "mock_ButtonConductor.h"
 #include "mock_buttons.h"
 #include "mock_intervalTimer.h"
+#include "mock_InputLog.h"
+#include "mock_globalTimer.h"
+#include "fakeGlobalTimer.h"
+#include "mock_TouchHardware.h"
+#include "SpscQueue.h"
+#include <string.h>
 
-void setup() {
+// Global timer ticks in one microsecond.
+#define US 325
 
+// The GPIO interrupt handler that ButtonHardware_Init() connected.
+static buttons_edgeHandler_t edgeHandler;
+
+// The game's debouncer, and the press the last read reported.
+static Debounce debounce;
+static uint64_t lastTouchPoll;
+static ButtonHardware_Press press;
+
+// Touches waiting for the next read, and the targets the last read said
+// were touched.
+static TouchHardware_Event touches[TOUCHHARDWARE_MAX_EVENTS];
+static uint32_t pendingTouches;
+static int32_t lastTouched;
+
+static int captureEdgeHandler(buttons_edgeHandler_t handler, int cmock_num_calls) {
+  edgeHandler = handler;
+  return BUTTONS_INIT_STATUS_OK;
+}
+
+static uint32_t fakeTouchRead(uint64_t* lastPoll, int32_t touched, TouchHardware_Event* events,
+                              int cmock_num_calls) {
+  uint32_t i;
+  uint32_t count = pendingTouches;
+  lastTouched = touched;
+  for (i = 0; i < count; i++) {
+    events[i] = touches[i];
+  }
+  pendingTouches = 0;
+  return count;
+}
+
+/**
+ * Touches the screen's targets, to be seen by the next read.
+ */
+static void touch(uint64_t timestamp, int32_t targets) {
+  touches[pendingTouches].timestamp = timestamp;
+  touches[pendingTouches].targets = targets;
+  pendingTouches++;
+}
+
+/**
+ * Fires the GPIO interrupt as if the buttons had just changed to the value.
+ */
+static void fireEdge(uint64_t timestamp, int32_t buttons) {
+  fakeGlobalTimer_set(timestamp);
+  buttons_read_ExpectAndReturn(buttons);
+  edgeHandler();
+}
+
+/**
+ * Reads the buttons, noting which press was reported.
+ */
+static int32_t read(void) {
+  memset(&press, 0, sizeof(press));
+  return ButtonHardware_Read(&debounce, &lastTouchPoll, &press);
+}
+
+/**
+ * Reads the buttons at the given time, expecting the value that goes
+ * through the input log.
+ */
+static int32_t readAt(uint64_t timestamp, int32_t gpio, int32_t logged) {
+  fakeGlobalTimer_set(timestamp);
+  buttons_read_ExpectAndReturn(gpio);
+  InputLog_Buttons_ExpectAndReturn(logged, logged);
+  return read();
+}
+
+void setUp(void) {
+  fakeGlobalTimer_init(0);
+  edgeHandler = NULL;
+  pendingTouches = 0;
+  lastTouched = 0;
+  globalTimer_getTimerValue_StubWithCallback(fakeGlobalTimer_read);
+  TouchHardware_Read_StubWithCallback(fakeTouchRead);
+  buttons_init_ExpectAndReturn(1);
+  buttons_enableInterrupts_StubWithCallback(captureEdgeHandler);
+  TouchHardware_Init_Expect();
+  ButtonHardware_Init(&debounce, &lastTouchPoll);
 }
 
-void tearDown() {
+void tearDown(void) {
+}
 
+/**
+ * Turns debouncing off, so every edge counts at once.
+ */
+static void noDebounce(void) {
+  int i;
+  for (i = 0; i < DEBOUNCE_NUMBER_OF_BUTTONS; i++) {
+    ButtonHardware_SetStableWindow(&debounce, i, 0);
+  }
 }
 
 void testButtonHardware_Init(void) {
+  TEST_ASSERT_NOT_NULL(edgeHandler);
+}
 
- buttons_init_ExpectAndReturn(1);
+void testButtonHardware_ReadShouldReturnRawValueWithoutDebouncing() {
+  noDebounce();
+  InputLog_Timestamp_IgnoreAndReturn(0);
+  // New presses are flagged for the input log, but not returned.
+  // The log packs the buttons, the first of them if it is not the lowest,
+  // and the number of presses.
+  TEST_ASSERT_EQUAL(0x1, readAt(0, 0x1, 0x10001));
+  TEST_ASSERT_EQUAL(0x2, readAt(0, 0x2, 0x10002));
+  TEST_ASSERT_EQUAL(0x3, readAt(0, 0x3, 0x10003));
+  TEST_ASSERT_EQUAL(0x4, readAt(0, 0x4, 0x10004));
+  TEST_ASSERT_EQUAL(0x4, readAt(0, 0x4, 0x4));
+  TEST_ASSERT_EQUAL(0xF, readAt(0, 0xF, 0x3000F));
+  TEST_ASSERT_EQUAL(0x1, press.button);
+  TEST_ASSERT_EQUAL(3, press.count);
+}
 
- ButtonHardware_Init();
+void testButtonHardware_ReadShouldReturnTheValueFromTheInputLog() {
+  // While replaying, the input log replaces what the hardware reads.
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x0, 0x4);
+  TEST_ASSERT_EQUAL(0x4, read());
 }
 
-void testButtonHardware_ReadShouldReturnRawValueFromHardware() {
-  int32_t buttonValue = 0;
+void testButtonHardware_PressShouldCountOnlyOnceItHasHeldForTheWindow() {
+  // A bouncing press of button 1, 1000 us after the timer started.
+  fireEdge(1000 * US, 0x2);
+  fireEdge(1002 * US, 0x0);
+  fireEdge(1004 * US, 0x2);
 
-  buttons_read_ExpectAndReturn(0x1);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0x1, buttonValue);
+  // Still inside the window after the last bounce.
+  TEST_ASSERT_EQUAL(0x0, readAt(1004 * US + BUTTONHARDWARE_STABLE_WINDOW * US - 1, 0x2, 0x0));
 
+  // Settled: the press is dated to its first edge, not to when it settled.
+  fakeGlobalTimer_set((1004 + BUTTONHARDWARE_STABLE_WINDOW) * US);
   buttons_read_ExpectAndReturn(0x2);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0x2, buttonValue);
+  InputLog_Buttons_ExpectAndReturn(0x10002, 0x10002);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x2, read());
+  TEST_ASSERT_EQUAL_UINT64(1000, press.time);
+
+  // Holding the button makes no new edge, so no new press.
+  TEST_ASSERT_EQUAL(0x2, readAt(20000 * US, 0x2, 0x2));
+  TEST_ASSERT_EQUAL(0x2, press.button);
+  TEST_ASSERT_EQUAL(0, press.count);
 
+  const Debounce_Stats* stats = Debounce_GetStats(&debounce, 1);
+  TEST_ASSERT_EQUAL(1, stats->edges);
+  TEST_ASSERT_EQUAL(2, stats->bounces);
+  TEST_ASSERT_EQUAL_UINT64(4 * US, stats->longestBounceTime);
+}
+
+void testButtonHardware_ShortGlitchShouldNotBeAPress() {
+  fireEdge(325, 0x4);
+  fireEdge(650, 0x0);
+
+  TEST_ASSERT_EQUAL(0x0, readAt(100000 * US, 0x0, 0x0));
+  TEST_ASSERT_EQUAL(1, Debounce_GetStats(&debounce, 2)->glitches);
+  TEST_ASSERT_EQUAL(0, Debounce_GetStats(&debounce, 2)->edges);
+}
+
+void testButtonHardware_ReadShouldReportATapThatEndedBeforeTheRead() {
+  fireEdge(325, 0x4);
+  fireEdge(20000 * US, 0x0);
+
+  fakeGlobalTimer_set(40000 * US);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x10004, 0x10004);
+  InputLog_Timestamp_ExpectAndReturn(1, 1);
+  TEST_ASSERT_EQUAL(0x4, read());
+}
+
+void testButtonHardware_ShouldDebounceWithoutTheInterrupt() {
+
+  // Polled from the tick, the press is dated to the first tick that saw it.
+  TEST_ASSERT_EQUAL(0x0, readAt(1000 * US, 0x1, 0x0));
+  fakeGlobalTimer_set(7000 * US);
+  buttons_read_ExpectAndReturn(0x1);
+  InputLog_Buttons_ExpectAndReturn(0x10001, 0x10001);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x1, read());
+  TEST_ASSERT_EQUAL_UINT64(1000, press.time);
+}
+
+void testButtonHardware_DiscardEdgesShouldCatchUpWithAReleaseNobodySaw() {
+  // Held down, then the game stopped reading the buttons.
+  TEST_ASSERT_EQUAL(0x0, readAt(0, 0x1, 0x0));
+  fakeGlobalTimer_set(10000 * US);
+  buttons_read_ExpectAndReturn(0x1);
+  InputLog_Buttons_ExpectAndReturn(0x10001, 0x10001);
+  InputLog_Timestamp_ExpectAndReturn(0, 0);
+  TEST_ASSERT_EQUAL(0x1, read());
+
+  // Released long ago, but the first read after is only now.
+  fakeGlobalTimer_set(3000000 * US);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x0, 0x0);
+  TEST_ASSERT_EQUAL(0x0, ButtonHardware_DiscardEdges(&debounce, &lastTouchPoll));
+  TEST_ASSERT_EQUAL(0x0, readAt(3000000 * US + 50 * US, 0x0, 0x0));
+}
+
+void testButtonHardware_StableWindowShouldBePerButton() {
+  // Only button 0 counts at once; button 1 still has to hold still.
+  ButtonHardware_SetStableWindow(&debounce, 0, 0);
+  fakeGlobalTimer_set(1000 * US);
   buttons_read_ExpectAndReturn(0x3);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0x3, buttonValue);
+  InputLog_Buttons_ExpectAndReturn(0x10001, 0x10001);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x1, read());
+}
+
+void testButtonHardware_DiscardEdgesShouldForgetEarlierPresses() {
+  noDebounce();
+
+  fireEdge(325, 0x1);
+  fireEdge(650, 0x0);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x1, 0x1);
+  TEST_ASSERT_EQUAL(0x1, ButtonHardware_DiscardEdges(&debounce, &lastTouchPoll));
+
+  TEST_ASSERT_EQUAL(0x0, readAt(1000, 0x0, 0x0));
+  TEST_ASSERT_EQUAL(0, press.count);
+}
+
+void testButtonHardware_DiscardEdgesShouldReportAButtonHeldDown() {
+  noDebounce();
+
+  fakeGlobalTimer_set(1000 * US);
+  buttons_read_ExpectAndReturn(0x8);
+  InputLog_Buttons_ExpectAndReturn(0x8, 0x8);
+  TEST_ASSERT_EQUAL(0x8, ButtonHardware_DiscardEdges(&debounce, &lastTouchPoll));
+}
+
+void testButtonHardware_FirstButtonShouldGoByTheInterruptsTimestamps() {
+  noDebounce();
+  // Button 3 went down before button 0, though both are seen by one read.
+  fireEdge(1000 * US, 0x8);
+  fireEdge(1040 * US, 0x9);
+
+  fakeGlobalTimer_set(2000 * US);
+  buttons_read_ExpectAndReturn(0x9);
+  InputLog_Buttons_ExpectAndReturn(0x20809, 0x20809);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x9, read());
+  TEST_ASSERT_EQUAL(0x8, press.button);
+  TEST_ASSERT_EQUAL(2, press.count);
+  TEST_ASSERT_EQUAL_UINT64(1000, press.time);
 
-  buttons_read_ExpectAndReturn(0x4);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0x4, buttonValue);
+  // Still held, button 3 stays first.
+  TEST_ASSERT_EQUAL(0x9, readAt(3000 * US, 0x9, 0x809));
+  TEST_ASSERT_EQUAL(0x8, press.button);
+}
+
+void testButtonHardware_TouchingATargetShouldPressItsButton() {
+  // The target for LED 2 is touched at 1000 us, and let go a while later.
+  touch(1000 * US, 0x4);
+  TEST_ASSERT_EQUAL(0x0, readAt(2000 * US, 0x0, 0x0));
+  TEST_ASSERT_EQUAL(0, lastTouched);
+
+  fakeGlobalTimer_set((1000 + BUTTONHARDWARE_STABLE_WINDOW) * US);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x10004, 0x10004);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x4, read());
+  TEST_ASSERT_EQUAL(0x4, press.button);
+  TEST_ASSERT_EQUAL_UINT64(1000, press.time);
+  TEST_ASSERT_EQUAL(0x4, lastTouched);
+
+  // Reading the GPIO does not let go of the target.
+  TEST_ASSERT_EQUAL(0x4, readAt(20000 * US, 0x0, 0x4));
+  touch(30000 * US, 0x0);
+  TEST_ASSERT_EQUAL(0x0, readAt(40000 * US, 0x0, 0x0));
+  TEST_ASSERT_EQUAL(2, Debounce_GetStats(&debounce, BUTTONHARDWARE_TOUCH_SHIFT + 2)->edges);
+}
+
+void testButtonHardware_TouchesAndEdgesShouldBeMergedByTime() {
+  noDebounce();
+  // Button 0 went down after the touch on the target for LED 3 but was
+  // queued first; the touch still comes first.
+  fireEdge(1040 * US, 0x1);
+  touch(1000 * US, 0x8);
+
+  fakeGlobalTimer_set(2000 * US);
+  buttons_read_ExpectAndReturn(0x1);
+  InputLog_Buttons_ExpectAndReturn(0x20809, 0x20809);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x9, read());
+  TEST_ASSERT_EQUAL(0x8, press.button);
+}
+
+void testButtonHardware_DiscardEdgesShouldReportATargetHeldDown() {
+  noDebounce();
+  touch(500 * US, 0x2);
+
+  fakeGlobalTimer_set(1000 * US);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x2, 0x2);
+  TEST_ASSERT_EQUAL(0x2, ButtonHardware_DiscardEdges(&debounce, &lastTouchPoll));
+}
+
+void testButtonHardware_DrainedEdgesShouldBeKeptForTheNextRead() {
+  noDebounce();
+  fireEdge(1000 * US, 0x4);
+  fireEdge(1100 * US, 0x0);
+  ButtonHardware_DrainEdges(&debounce, &lastTouchPoll);
+
+  fakeGlobalTimer_set(2000 * US);
+  buttons_read_ExpectAndReturn(0x0);
+  InputLog_Buttons_ExpectAndReturn(0x10004, 0x10004);
+  InputLog_Timestamp_ExpectAndReturn(1000, 1000);
+  TEST_ASSERT_EQUAL(0x4, read());
+  TEST_ASSERT_EQUAL(1, press.count);
+}
 
-  buttons_read_ExpectAndReturn(0x4);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0x4, buttonValue);
+void testButtonHardware_EdgesThatDoNotFitShouldBeCounted() {
+  uint32_t i;
+  for (i = 0; i < BUTTONHARDWARE_EDGE_CAPACITY + 3; i++) {
+    fireEdge(1000 * US + i, i & 0x1);
+  }
+  TEST_ASSERT_EQUAL(3, ButtonHardware_GetDroppedEdges());
 
-  buttons_read_ExpectAndReturn(0xF);
-  buttonValue = ButtonHardware_Read();
-  TEST_ASSERT_EQUAL(0xF, buttonValue);
+  // Draining makes room again.
+  ButtonHardware_DrainEdges(&debounce, &lastTouchPoll);
+  fireEdge(2000 * US, 0x1);
+  TEST_ASSERT_EQUAL(3, ButtonHardware_GetDroppedEdges());
 }
@@ -4,6 +4,9 @@
 #include "mock_ButtonConductor.h"
 #include "mock_ReflexTestData.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup(void) {
 }
 
@@ -17,51 +20,80 @@ void testButtonModel_SetPressedButtonShouldGivePrecedenceToLowestButton(void) {
   // NOTE: The button model itself translates these bit values instructions
   // {0, 1, 2, 3, 4} so that they match up with the generated sequences.
   uint32_t buttonValue = 0xF;
-  ReflexTestData_SetPressedButton_Expect(1);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 1);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x3;
-  ReflexTestData_SetPressedButton_Expect(1);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 1);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x6;
-  ReflexTestData_SetPressedButton_Expect(2);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 2);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x4;
-  ReflexTestData_SetPressedButton_Expect(3);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 3);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x8;
-  ReflexTestData_SetPressedButton_Expect(4);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 4);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0xA;
-  ReflexTestData_SetPressedButton_Expect(2);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 2);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x0;
-  ReflexTestData_SetPressedButton_Expect(0);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 0);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 
   buttonValue = 0x1;
-  ReflexTestData_SetPressedButton_Expect(1);
-  ButtonModel_SetPressedButton(buttonValue);
+  ReflexTestData_SetPressedButton_Expect(&context, 1);
+  ButtonModel_SetPressedButton(&context, buttonValue);
 }
 
 /**
  * This test just makes sure that the connection is properly made.
  */
 void testButtonModel_GetCurrentStateGetsStateFromReflexTestData(void) {
-  ReflexTestData_GetCurrentState_ExpectAndReturn(init_st);
-  ButtonModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, init_st);
+  ButtonModel_GetCurrentState(&context);
 }
 
 /**
  * This test just makes sure that the connection is properly made.
  */
 void testButtonModel_GetPressedButtonFromReflexTestData(void) {
-  ReflexTestData_GetPressedButton_ExpectAndReturn(0x1);
-  int32_t buttonValue = ButtonModel_GetPressedButton();
+  ReflexTestData_GetPressedButton_ExpectAndReturn(&context, 0x1);
+  int32_t buttonValue = ButtonModel_GetPressedButton(&context);
   TEST_ASSERT_EQUAL(0x1, buttonValue);
 }
+
+/**
+ * This test just makes sure that the connection is properly made.
+ */
+void testButtonModel_SetPressTimeSavesToReflexTestData(void) {
+  ReflexTestData_SetPressTime_Expect(&context, 123456);
+  ButtonModel_SetPressTime(&context, 123456);
+}
+
+/**
+ * This test just makes sure that the connection is properly made.
+ */
+void testButtonModel_SetAnticipatedSavesToReflexTestData(void) {
+  ReflexTestData_SetAnticipated_Expect(&context, true);
+  ButtonModel_SetAnticipated(&context);
+}
+
+void testButtonModel_RightButtonShouldNotBeAWrongPress(void) {
+  ReflexTestData_IsCorrectButtonPressed_ExpectAndReturn(&context, true);
+  ButtonModel_CheckResponse(&context, 1250000, 1);
+}
+
+void testButtonModel_WrongButtonShouldBeScoredWithItsLatency(void) {
+  ReflexTestData_IsCorrectButtonPressed_ExpectAndReturn(&context, false);
+  ReflexTestData_GetStimulusTime_ExpectAndReturn(&context, 1000000);
+  ReflexTestData_RecordWrongPresses_Expect(&context, 2, 180000);
+  ReflexTestData_SetPressTime_Expect(&context, 0);
+  ButtonModel_CheckResponse(&context, 1180000, 2);
+}
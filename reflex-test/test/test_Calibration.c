@@ -0,0 +1,90 @@
+#include "unity.h"
+#include "Calibration.h"
+#include "mock_InputLog.h"
+#include "mock_intervalTimer.h"
+#include "mock_leds.h"
+#include "mock_globalTimer.h"
+#include "fakeGlobalTimer.h"
+
+static int slowLedWrite(int ledValue, int cmock_num_calls) {
+  fakeGlobalTimer_advance(100);
+  return 0;
+}
+
+static uint32_t slowTimerReset(uint32_t timerNumber, int cmock_num_calls) {
+  fakeGlobalTimer_advance(300);
+  return 0;
+}
+
+static uint32_t slowTimerStart(uint32_t timerNumber, int cmock_num_calls) {
+  fakeGlobalTimer_advance(40);
+  return 0;
+}
+
+static uint32_t slowTimerRead(uint32_t timerNumber, uint64_t* microseconds, int cmock_num_calls) {
+  fakeGlobalTimer_advance(120);
+  *microseconds = 0;
+  return 0;
+}
+
+static uint32_t getHandle(uint32_t timerNumber, intervalTimer_Handle* handle, int cmock_num_calls) {
+  handle->registers = NULL;
+  handle->tcsr0 = INTERVALTIMER_ENABLE_CASC_MASK;
+  handle->timerNumber = timerNumber;
+  return 0;
+}
+
+static void fastStart(intervalTimer_Handle* handle, int cmock_num_calls) {
+  fakeGlobalTimer_advance(2);
+}
+
+static uint64_t fastRead(const intervalTimer_Handle* handle, int cmock_num_calls) {
+  fakeGlobalTimer_advance(9);
+  return 0;
+}
+
+static uint64_t fastElapsed(const intervalTimer_Handle* handle, uint64_t start,
+                            uint32_t boundMicroseconds, int cmock_num_calls) {
+  fakeGlobalTimer_advance(4);
+  return 0;
+}
+
+void setUp(void) {
+  // The global timer moves on by a few ticks whenever it is read.
+  fakeGlobalTimer_init(5);
+  globalTimer_getTimerValue_StubWithCallback(fakeGlobalTimer_read);
+  leds_write_StubWithCallback(slowLedWrite);
+  intervalTimer_reset_StubWithCallback(slowTimerReset);
+  intervalTimer_start_StubWithCallback(slowTimerStart);
+  intervalTimer_getTotalDurationInMicroseconds_StubWithCallback(slowTimerRead);
+  intervalTimer_getHandle_StubWithCallback(getHandle);
+  intervalTimer_fastStart_StubWithCallback(fastStart);
+  intervalTimer_fastRead_StubWithCallback(fastRead);
+  intervalTimer_fastElapsed_StubWithCallback(fastElapsed);
+  intervalTimer_fastReset_Ignore();
+}
+
+void tearDown(void) {
+}
+
+void testCalibration_ShouldMeasureEachCostLessTheTimestamp(void) {
+  Calibration_Run();
+
+  const Calibration_Constants* constants = Calibration_Get();
+  TEST_ASSERT_EQUAL(5, constants->timestampTicks);
+  TEST_ASSERT_EQUAL(100, constants->ledWriteTicks);
+  TEST_ASSERT_EQUAL(300, constants->timerResetTicks);
+  TEST_ASSERT_EQUAL(40, constants->timerStartTicks);
+  TEST_ASSERT_EQUAL(120, constants->timerReadTicks);
+  TEST_ASSERT_EQUAL(2, constants->fastStartTicks);
+  TEST_ASSERT_EQUAL(9, constants->fastReadTicks);
+  TEST_ASSERT_EQUAL(4, constants->fastElapsedTicks);
+}
+
+void testCalibration_OverheadShouldBeNanosecondsThroughTheInputLog(void) {
+  Calibration_Run();
+
+  // 105 ticks at 325 MHz
+  InputLog_Calibration_ExpectAndReturn(323, 400);
+  TEST_ASSERT_EQUAL(400, Calibration_GetStimulusOverhead());
+}
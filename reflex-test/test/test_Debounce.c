@@ -0,0 +1,177 @@
+#include "unity.h"
+#include "Debounce.h"
+
+#define WINDOW 100
+
+static Debounce debounce;
+static uint64_t firstPress;
+
+void setUp(void) {
+  Debounce_Init(&debounce, WINDOW);
+  firstPress = 0;
+}
+
+void tearDown(void) {
+}
+
+void testDebounce_InitShouldReleaseEveryButton(void) {
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+  TEST_ASSERT_EQUAL(0, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL(0, Debounce_GetStats(&debounce, 0)->edges);
+}
+
+void testDebounce_PressShouldWaitForTheWindow(void) {
+  Debounce_Sample(&debounce, 0x1, 1000);
+  Debounce_Sample(&debounce, 0x1, 1000 + WINDOW - 1);
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+
+  Debounce_Sample(&debounce, 0x1, 1000 + WINDOW);
+  TEST_ASSERT_EQUAL(0x1, Debounce_GetButtons(&debounce));
+}
+
+void testDebounce_EdgeShouldBeDatedToTheFirstBounce(void) {
+  Debounce_Sample(&debounce, 0x4, 1000);
+  Debounce_Sample(&debounce, 0x0, 1010);
+  Debounce_Sample(&debounce, 0x4, 1030);
+  Debounce_Sample(&debounce, 0x4, 1030 + WINDOW);
+
+  TEST_ASSERT_EQUAL(0x4, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL_UINT64(1000, firstPress);
+  TEST_ASSERT_EQUAL(0, Debounce_TakePresses(&debounce, &firstPress));
+
+  const Debounce_Stats* stats = Debounce_GetStats(&debounce, 2);
+  TEST_ASSERT_EQUAL(1, stats->edges);
+  TEST_ASSERT_EQUAL(2, stats->bounces);
+  TEST_ASSERT_EQUAL_UINT64(30, stats->totalBounceTime);
+  TEST_ASSERT_EQUAL_UINT64(30, stats->longestBounceTime);
+}
+
+void testDebounce_RawLevelShouldFollowEverySample(void) {
+  Debounce_Sample(&debounce, 0x21, 1000);
+  TEST_ASSERT_EQUAL(0x21, Debounce_GetRaw(&debounce));
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+
+  Debounce_Sample(&debounce, 0x20, 1010);
+  TEST_ASSERT_EQUAL(0x20, Debounce_GetRaw(&debounce));
+}
+
+void testDebounce_GlitchShouldNotMoveTheLevel(void) {
+  Debounce_Sample(&debounce, 0x2, 1000);
+  Debounce_Sample(&debounce, 0x0, 1020);
+  Debounce_Sample(&debounce, 0x0, 1020 + WINDOW);
+
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+  TEST_ASSERT_EQUAL(0, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL(1, Debounce_GetStats(&debounce, 1)->glitches);
+  TEST_ASSERT_EQUAL(0, Debounce_GetStats(&debounce, 1)->edges);
+}
+
+void testDebounce_ReleaseShouldNotBeAPress(void) {
+  Debounce_Sample(&debounce, 0x1, 0);
+  Debounce_Sample(&debounce, 0x1, WINDOW);
+  Debounce_TakePresses(&debounce, &firstPress);
+
+  Debounce_Sample(&debounce, 0x0, 1000);
+  Debounce_Sample(&debounce, 0x0, 1000 + WINDOW);
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+  TEST_ASSERT_EQUAL(0, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL(2, Debounce_GetStats(&debounce, 0)->edges);
+}
+
+void testDebounce_QuietBurstShouldSettleBeforeTheNextEdge(void) {
+  // No sample came between the press and the release, but the press had
+  // held for the window by the time the release arrived.
+  Debounce_Sample(&debounce, 0x8, 1000);
+  Debounce_Sample(&debounce, 0x0, 5000);
+
+  TEST_ASSERT_EQUAL(0x8, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL_UINT64(1000, firstPress);
+  TEST_ASSERT_EQUAL(0, Debounce_GetStats(&debounce, 3)->bounces);
+}
+
+void testDebounce_EarliestPressShouldBeKept(void) {
+  Debounce_Sample(&debounce, 0x2, 1000);
+  Debounce_Sample(&debounce, 0x3, 1050);
+  Debounce_SetWindow(&debounce, 0, 10);
+  Debounce_Sample(&debounce, 0x3, 1060);
+  Debounce_Sample(&debounce, 0x3, 1100);
+
+  TEST_ASSERT_EQUAL(0x3, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL_UINT64(1000, firstPress);
+}
+
+void testDebounce_ZeroWindowShouldTakeEdgesAtOnce(void) {
+  Debounce_Init(&debounce, 0);
+  Debounce_Sample(&debounce, 0x1, 1000);
+  TEST_ASSERT_EQUAL(0x1, Debounce_GetButtons(&debounce));
+  Debounce_Sample(&debounce, 0x0, 1001);
+  TEST_ASSERT_EQUAL(0x0, Debounce_GetButtons(&debounce));
+  TEST_ASSERT_EQUAL(0x1, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL(0, Debounce_GetStats(&debounce, 0)->glitches);
+}
+
+void testDebounce_ResyncShouldTakeTheRawLevelAtOnce(void) {
+  Debounce_Sample(&debounce, 0x1, 0);
+  Debounce_Sample(&debounce, 0x1, WINDOW);
+  Debounce_TakePresses(&debounce, &firstPress);
+
+  Debounce_Resync(&debounce, 0x2, 5000);
+  TEST_ASSERT_EQUAL(0x2, Debounce_GetButtons(&debounce));
+  TEST_ASSERT_EQUAL(0, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL_UINT64(DEBOUNCE_NEVER, Debounce_GetNextSettle(&debounce));
+}
+
+void testDebounce_NextSettleShouldBeTheEarliestBurst(void) {
+  TEST_ASSERT_EQUAL_UINT64(DEBOUNCE_NEVER, Debounce_GetNextSettle(&debounce));
+  Debounce_SetWindow(&debounce, 1, 30);
+  Debounce_Sample(&debounce, 0x1, 1000);
+  Debounce_Sample(&debounce, 0x3, 1010);
+  TEST_ASSERT_EQUAL_UINT64(1040, Debounce_GetNextSettle(&debounce));
+}
+
+void testDebounce_OlderSampleShouldNotSettleABurst(void) {
+  Debounce_Sample(&debounce, 0x1, 1000);
+  Debounce_Sample(&debounce, 0x1, 900);
+  TEST_ASSERT_EQUAL(0, Debounce_GetButtons(&debounce));
+}
+
+void testDebounce_FirstButtonShouldGoByTimeNotByBit(void) {
+  Debounce_Init(&debounce, 0);
+  Debounce_Sample(&debounce, 0x8, 1000);
+  Debounce_Sample(&debounce, 0x9, 1020);
+  Debounce_Sample(&debounce, 0xB, 1030);
+
+  TEST_ASSERT_EQUAL(3, Debounce_GetPendingPresses(&debounce));
+  TEST_ASSERT_EQUAL(0x8, Debounce_GetFirstButton(&debounce, 0xB));
+  TEST_ASSERT_EQUAL(0x1, Debounce_GetFirstButton(&debounce, 0x3));
+  TEST_ASSERT_EQUAL(0, Debounce_GetFirstButton(&debounce, 0x0));
+  TEST_ASSERT_EQUAL_UINT64(1020, Debounce_GetPressTime(&debounce, 0));
+  TEST_ASSERT_EQUAL(0xB, Debounce_TakePresses(&debounce, &firstPress));
+  TEST_ASSERT_EQUAL_UINT64(1000, firstPress);
+  TEST_ASSERT_EQUAL(0, Debounce_GetPendingPresses(&debounce));
+
+  // Held buttons keep the order they went down in.
+  TEST_ASSERT_EQUAL(0x8, Debounce_GetFirstButton(&debounce, Debounce_GetButtons(&debounce)));
+}
+
+void testDebounce_RepeatedPressShouldCountButKeepItsFirstTime(void) {
+  Debounce_Init(&debounce, 0);
+  Debounce_Sample(&debounce, 0x2, 1000);
+  Debounce_Sample(&debounce, 0x0, 1010);
+  Debounce_Sample(&debounce, 0x1, 1015);
+  Debounce_Sample(&debounce, 0x3, 1020);
+
+  TEST_ASSERT_EQUAL(3, Debounce_GetPendingPresses(&debounce));
+  TEST_ASSERT_EQUAL(0x2, Debounce_GetFirstButton(&debounce, 0x3));
+  TEST_ASSERT_EQUAL_UINT64(1000, Debounce_GetPressTime(&debounce, 1));
+}
+
+void testDebounce_ResyncShouldDateAnUnseenPressToNow(void) {
+  Debounce_Sample(&debounce, 0x1, 0);
+  Debounce_Sample(&debounce, 0x1, WINDOW);
+  Debounce_TakePresses(&debounce, &firstPress);
+
+  Debounce_Resync(&debounce, 0x3, 5000);
+  TEST_ASSERT_EQUAL_UINT64(5000, Debounce_GetPressTime(&debounce, 1));
+  TEST_ASSERT_EQUAL(0x1, Debounce_GetFirstButton(&debounce, Debounce_GetButtons(&debounce)));
+}
@@ -1,10 +1,15 @@
 #include "unity.h"
 #include "Executor.h"
+#include "SoftTimer.h"
 #include "mock_ButtonConductor.h"
 #include "mock_LedConductor.h"
 #include "mock_LcdConductor.h"
 #include "mock_TimerConductor.h"
 #include "mock_ReflexTestData.h"
+#include "mock_Trace.h"
+
+// The game that every test works on.
+static ReflexTest_Context context;
 
 void setUp(void) {
 }
@@ -12,32 +17,223 @@ void setUp(void) {
 void tearDown(void) {
 }
 
+// Records the order in which the fake conductor actions were called.
+#define MAX_CALLS 8
+static char calls[MAX_CALLS + 1];
+static int numberOfCalls;
+
+static void recordCall(char conductor) {
+  if (numberOfCalls < MAX_CALLS) {
+    calls[numberOfCalls++] = conductor;
+    calls[numberOfCalls] = '\0';
+  }
+}
+
+static void fakeButtonAction(ReflexTest_Context* context) { recordCall('B'); }
+static void fakeTimerAction(ReflexTest_Context* context)  { recordCall('T'); }
+static void fakeLedAction(ReflexTest_Context* context)    { recordCall('L'); }
+static void fakeLcdAction(ReflexTest_Context* context)    { recordCall('D'); }
+
+// The fake conductors only act in blink_led_st and show_info_st.
+static ReflexTest_Action fakeButtonGetAction(ReflexTest_st state, int numCalls) {
+  return (state == blink_led_st) ? fakeButtonAction : NULL;
+}
+
+static ReflexTest_Action fakeTimerGetAction(ReflexTest_st state, int numCalls) {
+  return (state == blink_led_st) ? fakeTimerAction : NULL;
+}
+
+static ReflexTest_Action fakeLedGetAction(ReflexTest_st state, int numCalls) {
+  return (state == blink_led_st || state == show_info_st) ? fakeLedAction : NULL;
+}
+
+static ReflexTest_Action fakeLcdGetAction(ReflexTest_st state, int numCalls) {
+  return (state == blink_led_st) ? fakeLcdAction : NULL;
+}
+
+static void initWithFakeConductorsAndTrace(void) {
+  ButtonConductor_Init_Expect(&context);
+  LedConductor_Init_Expect(&context);
+  TimerConductor_Init_Expect(&context);
+  LcdConductor_Init_Expect(&context);
+  ReflexTestData_Init_Expect(&context);
+  ButtonConductor_GetAction_StubWithCallback(fakeButtonGetAction);
+  TimerConductor_GetAction_StubWithCallback(fakeTimerGetAction);
+  LedConductor_GetAction_StubWithCallback(fakeLedGetAction);
+  LcdConductor_GetAction_StubWithCallback(fakeLcdGetAction);
+
+  Executor_Init(&context);
+
+  numberOfCalls = 0;
+  calls[0] = '\0';
+}
+
+// Most tests are not about the trace.
+static void initWithFakeConductors(void) {
+  initWithFakeConductorsAndTrace();
+  Trace_RecordTransition_Ignore();
+}
+
 void testExecutor_InitShouldCallInitOfAllConductors(void) {
-  ButtonConductor_Init_Expect();
-  LedConductor_Init_Expect();
-  TimerConductor_Init_Expect();
-  LcdConductor_Init_Expect();
-  ReflexTestData_Init_Expect();
+  initWithFakeConductors();
+}
+
+void testExecutor_RunShouldCallActionsForEachConductorInOrderAndReturnTrueAlways(void) {
+  initWithFakeConductors();
 
-  Executor_Init();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(0);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_for_button_st);
+
+  TEST_ASSERT_EQUAL(true, Executor_Run(&context));
+
+  // First read buttons, then manage the timers, then work with the sequences,
+  // and finally show the state information.
+  TEST_ASSERT_EQUAL_STRING("BTLD", calls);
 }
 
-void testExecutor_RunShouldCallRunForEachConductorAndReturnTrueAlways(void) {
-  // First, read buttons
-  ButtonConductor_Run_Expect();
+void testExecutor_TransitionsShouldBeTracedWithTheActionsThatRan(void) {
+  initWithFakeConductorsAndTrace();
 
-  // Then, manage the timers
-  TimerConductor_Run_Expect();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(1234);
+  Trace_RecordTransition_Expect(1234, blink_led_st, wait_for_button_st,
+                                TRACE_BUTTON_ACTION | TRACE_TIMER_ACTION |
+                                TRACE_LED_ACTION | TRACE_LCD_ACTION);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_for_button_st);
+  Executor_Run(&context);
 
-  // Next, work with the sequences and update the index
-  LedConductor_Run_Expect();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(2000);
+  Trace_RecordTransition_Expect(2000, show_info_st, wait_info_st, TRACE_LED_ACTION);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_info_st);
+  Executor_Run(&context);
+}
 
-  // Finally, show the state information. This must be last to have accurate
-  // data.
-  LcdConductor_Run_Expect();
+void testExecutor_TicksThatStayInTheStateShouldNotBeTraced(void) {
+  initWithFakeConductorsAndTrace();
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(init_st);
-  ReflexTestData_SetCurrentState_Expect(show_info_st);
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(0);
+  ReflexTestData_GetPressedButton_ExpectAndReturn(&context, 0x0);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_info_st);
+  Executor_Run(&context);
+}
+
+void testExecutor_RunShouldOnlyCallActionsThatExistForTheState(void) {
+  initWithFakeConductors();
+
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(0);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_info_st);
+  TEST_ASSERT_EQUAL(true, Executor_Run(&context));
+  TEST_ASSERT_EQUAL_STRING("L", calls);
+}
+
+void testExecutor_RunShouldCallNoActionsInIdleStates(void) {
+  initWithFakeConductors();
+
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, init_st);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(0);
+  ReflexTestData_SetCurrentState_Expect(&context, show_info_st);
+  TEST_ASSERT_EQUAL(true, Executor_Run(&context));
+  TEST_ASSERT_EQUAL_STRING("", calls);
+}
+
+/**
+ * Helper function that expects one tick of Executor_Run at the given time.
+ */
+static void expectTick(ReflexTest_st state, uint64_t now) {
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, state);
+  TimerConductor_GetCurrentTime_ExpectAndReturn(now);
+}
+
+void testExecutor_WaitStatsShouldLastFiveSecondsFromWhenItWasArmed(void) {
+  initWithFakeConductors();
+
+  // show_stats_st arms the deadline 5 seconds from now.
+  expectTick(show_stats_st, 1000000);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_stats_st);
+  Executor_Run(&context);
+
+  // The first tick in the waiting state still runs the state update.
+  expectTick(wait_stats_st, 1001000);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_stats_st);
+  Executor_Run(&context);
+
+  // Ticks before the deadline are skipped, however late they are, but
+  // still drain the button edges.
+  expectTick(wait_stats_st, 5999999);
+  LcdConductor_IsFrameDone_ExpectAndReturn(&context, true);
+  ButtonConductor_DrainEdges_Expect(&context);
+  Executor_Run(&context);
+
+  expectTick(wait_stats_st, 6000000);
+  ReflexTestData_SetCurrentState_Expect(&context, update_scores_st);
+  Executor_Run(&context);
+}
+
+void testExecutor_WaitingStatesShouldKeepTickingUntilTheLcdFrameIsDone(void) {
+  initWithFakeConductors();
+
+  expectTick(wait_stats_st, 1000000);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_stats_st);
+  Executor_Run(&context);
+
+  // The frame is not finished, so the tick runs although no timer expired.
+  expectTick(wait_stats_st, 1010000);
+  LcdConductor_IsFrameDone_ExpectAndReturn(&context, false);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_stats_st);
+  Executor_Run(&context);
+
+  expectTick(wait_stats_st, 1020000);
+  LcdConductor_IsFrameDone_ExpectAndReturn(&context, true);
+  ButtonConductor_DrainEdges_Expect(&context);
+  Executor_Run(&context);
+}
+
+void testExecutor_ButtonTimeoutShouldNotBeStretchedByMissedTicks(void) {
+  initWithFakeConductors();
+
+  expectTick(blink_led_st, 0);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_for_button_st);
+  Executor_Run(&context);
+
+  // A single late tick after the deadline times out immediately.
+  expectTick(wait_for_button_st, 5000000);
+  ReflexTestData_IsCorrectButtonPressed_ExpectAndReturn(&context, false);
+  ReflexTestData_SetCurrentState_Expect(&context, show_info_st);
+  Executor_Run(&context);
+}
+
+void testExecutor_ReleasingTheButtonShouldCancelTheHoldTimer(void) {
+  initWithFakeConductors();
+
+  expectTick(wait_info_st, 0);
+  ReflexTestData_GetPressedButton_ExpectAndReturn(&context, 0x1);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_five_seconds_st);
+  Executor_Run(&context);
+
+  expectTick(wait_five_seconds_st, 1000);
+  ReflexTestData_GetPressedButton_ExpectAndReturn(&context, 0x0);
+  ReflexTestData_SetCurrentState_Expect(&context, wait_info_st);
+  Executor_Run(&context);
+
+  TEST_ASSERT_EQUAL_UINT64(SOFTTIMER_NEVER, SoftTimer_GetNextDeadline(&context.timers));
+}
+
+void testExecutor_TickPeriodShouldFollowTheState(void) {
+  TEST_ASSERT_EQUAL(EXECUTOR_RESPONSE_TICK_PERIOD, Executor_GetTickPeriod(wait_for_button_st));
+  TEST_ASSERT_EQUAL(EXECUTOR_IDLE_TICK_PERIOD, Executor_GetTickPeriod(wait_stats_st));
+  TEST_ASSERT_EQUAL(EXECUTOR_IDLE_TICK_PERIOD, Executor_GetTickPeriod(wait_between_flash_st));
+  TEST_ASSERT_EQUAL(EXECUTOR_DEFAULT_TICK_PERIOD, Executor_GetTickPeriod(show_info_st));
+  TEST_ASSERT_EQUAL(EXECUTOR_DEFAULT_TICK_PERIOD,
+                    Executor_GetTickPeriod((ReflexTest_st) REFLEXTESTDATA_NUMBER_OF_STATES));
+}
 
-  TEST_ASSERT_EQUAL(true, Executor_Run());
+void testExecutor_EveryStateShouldHaveATickPeriod(void) {
+  int state;
+  for (state = 0; state < REFLEXTESTDATA_NUMBER_OF_STATES; state++) {
+    TEST_ASSERT_TRUE(Executor_GetTickPeriod(state) > 0);
+  }
 }
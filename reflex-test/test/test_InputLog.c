@@ -0,0 +1,157 @@
+#include "unity.h"
+#include "InputLog.h"
+#include <string.h>
+
+#define LOG_SIZE 256
+
+static uint8_t log[LOG_SIZE];
+
+void setUp(void) {
+  memset(log, 0, sizeof(log));
+  InputLog_Init();
+}
+
+void tearDown(void) {
+}
+
+/**
+ * Records a tick that reads the time and the buttons.
+ */
+static void recordTick(uint64_t now, int32_t buttons) {
+  InputLog_Timestamp(now);
+  InputLog_Buttons(buttons);
+}
+
+void testInputLog_ValuesShouldPassThroughWhenOff(void) {
+  TEST_ASSERT_EQUAL(INPUTLOG_OFF, InputLog_GetMode());
+  TEST_ASSERT_EQUAL(0x5, InputLog_Buttons(0x5));
+  TEST_ASSERT_EQUAL_UINT64(123456789, InputLog_Timestamp(123456789));
+  TEST_ASSERT_EQUAL(500000, InputLog_ResponseTime(500000));
+  TEST_ASSERT_TRUE(InputLog_State(wait_info_st));
+  TEST_ASSERT_EQUAL(0, InputLog_GetSize());
+}
+
+void testInputLog_ReplayShouldReturnWhatWasRecorded(void) {
+  InputLog_StartRecording(log, sizeof(log));
+  TEST_ASSERT_EQUAL(INPUTLOG_RECORDING, InputLog_GetMode());
+  InputLog_Timestamp(1000);
+  InputLog_Buttons(0x1);
+  InputLog_Timestamp(1050);           // short delta
+  InputLog_Buttons(0x12345);          // does not fit in a nibble
+  InputLog_ResponseTime(123456);
+  InputLog_State(button_pressed_st);
+  InputLog_Timestamp(5000000000ULL);  // long delta
+  InputLog_Stop();
+  uint32_t size = InputLog_GetSize();
+
+  TEST_ASSERT_TRUE(InputLog_StartReplay(log, size));
+  TEST_ASSERT_EQUAL(INPUTLOG_REPLAYING, InputLog_GetMode());
+  TEST_ASSERT_EQUAL_UINT64(1000, InputLog_Timestamp(0));
+  TEST_ASSERT_EQUAL(0x1, InputLog_Buttons(0));
+  TEST_ASSERT_EQUAL_UINT64(1050, InputLog_Timestamp(0));
+  TEST_ASSERT_EQUAL(0x12345, InputLog_Buttons(0));
+  TEST_ASSERT_EQUAL(123456, InputLog_ResponseTime(0));
+  TEST_ASSERT_TRUE(InputLog_State(button_pressed_st));
+  TEST_ASSERT_FALSE(InputLog_IsReplayDone());
+  TEST_ASSERT_EQUAL_UINT64(5000000000ULL, InputLog_Timestamp(0));
+  TEST_ASSERT_TRUE(InputLog_IsReplayDone());
+  TEST_ASSERT_FALSE(InputLog_HasDiverged());
+}
+
+void testInputLog_RepeatedTicksShouldCollapseIntoOneRecord(void) {
+  int i;
+  InputLog_StartRecording(log, sizeof(log));
+  for (i = 1; i <= 10000; i++) {
+    recordTick(i * 50, 0x0);
+  }
+  recordTick(10001 * 50, 0x2);
+  InputLog_Stop();
+
+  // Two ticks to spot the pattern, one repeat, and the last tick.
+  TEST_ASSERT_TRUE(InputLog_GetSize() < INPUTLOG_HEADER_SIZE + 16);
+
+  TEST_ASSERT_TRUE(InputLog_StartReplay(log, InputLog_GetSize()));
+  for (i = 1; i <= 10000; i++) {
+    TEST_ASSERT_EQUAL_UINT64(i * 50, InputLog_Timestamp(0));
+    TEST_ASSERT_EQUAL(0x0, InputLog_Buttons(0x8));
+  }
+  TEST_ASSERT_EQUAL_UINT64(10001 * 50, InputLog_Timestamp(0));
+  TEST_ASSERT_EQUAL(0x2, InputLog_Buttons(0x8));
+  TEST_ASSERT_TRUE(InputLog_IsReplayDone());
+}
+
+void testInputLog_StopShouldWriteOutARepeatInProgress(void) {
+  InputLog_StartRecording(log, sizeof(log));
+  InputLog_Buttons(0x1);
+  InputLog_Buttons(0x1);
+  uint32_t sizeBeforeRepeat = InputLog_GetSize();
+  InputLog_Buttons(0x1);
+  InputLog_Buttons(0x1);
+  TEST_ASSERT_EQUAL(sizeBeforeRepeat, InputLog_GetSize());
+
+  InputLog_Stop();
+  TEST_ASSERT_TRUE(InputLog_GetSize() > sizeBeforeRepeat);
+  TEST_ASSERT_EQUAL(INPUTLOG_OFF, InputLog_GetMode());
+}
+
+void testInputLog_ReplayShouldDivergeWhenTheStateDoesNotMatch(void) {
+  InputLog_StartRecording(log, sizeof(log));
+  InputLog_State(wait_for_button_st);
+  InputLog_Buttons(0x1);
+  InputLog_Stop();
+
+  InputLog_StartReplay(log, InputLog_GetSize());
+  TEST_ASSERT_FALSE(InputLog_State(show_info_st));
+  TEST_ASSERT_TRUE(InputLog_HasDiverged());
+  TEST_ASSERT_FALSE(InputLog_IsReplayDone());
+  // Once replay has diverged, live values pass through.
+  TEST_ASSERT_EQUAL(0x4, InputLog_Buttons(0x4));
+}
+
+void testInputLog_ReplayShouldDivergeWhenTheGameReadsSomethingElse(void) {
+  InputLog_StartRecording(log, sizeof(log));
+  InputLog_Buttons(0x1);
+  InputLog_Stop();
+
+  InputLog_StartReplay(log, InputLog_GetSize());
+  TEST_ASSERT_EQUAL_UINT64(777, InputLog_Timestamp(777));
+  TEST_ASSERT_TRUE(InputLog_HasDiverged());
+}
+
+void testInputLog_RecordingShouldStopWhenTheBufferIsFull(void) {
+  int i;
+  InputLog_StartRecording(log, INPUTLOG_HEADER_SIZE + 20);
+  for (i = 0; i < 20; i++) {
+    InputLog_ResponseTime(0x10000000 + i);   // 6 bytes each, never repeated
+  }
+  TEST_ASSERT_TRUE(InputLog_IsFull());
+  TEST_ASSERT_EQUAL(INPUTLOG_OFF, InputLog_GetMode());
+  TEST_ASSERT_EQUAL(INPUTLOG_HEADER_SIZE + 18, InputLog_GetSize());
+
+  // The records that fit still replay.
+  TEST_ASSERT_TRUE(InputLog_StartReplay(log, InputLog_GetSize()));
+  TEST_ASSERT_EQUAL(0x10000000, InputLog_ResponseTime(7));
+  TEST_ASSERT_EQUAL(0x10000001, InputLog_ResponseTime(7));
+  TEST_ASSERT_EQUAL(0x10000002, InputLog_ResponseTime(7));
+  TEST_ASSERT_TRUE(InputLog_IsReplayDone());
+  TEST_ASSERT_EQUAL(7, InputLog_ResponseTime(7));
+}
+
+void testInputLog_ReplayShouldRejectALogWithoutAHeader(void) {
+  uint8_t notALog[] = { 'R', 'T', 'I', 'X', INPUTLOG_VERSION };
+  TEST_ASSERT_FALSE(InputLog_StartReplay(notALog, sizeof(notALog)));
+  TEST_ASSERT_FALSE(InputLog_StartReplay(notALog, 3));
+  TEST_ASSERT_EQUAL(INPUTLOG_OFF, InputLog_GetMode());
+}
+
+void testInputLog_ReplayShouldReturnTheRecordedCalibration(void) {
+  InputLog_StartRecording(log, sizeof(log));
+  InputLog_Calibration(1234);
+  InputLog_ResponseTime(250000);
+  InputLog_Stop();
+
+  InputLog_StartReplay(log, InputLog_GetSize());
+  TEST_ASSERT_EQUAL(1234, InputLog_Calibration(0));
+  TEST_ASSERT_EQUAL(250000, InputLog_ResponseTime(0));
+  TEST_ASSERT_FALSE(InputLog_HasDiverged());
+}
@@ -1,77 +1,137 @@
 #include "unity.h"
 #include "LcdConductor.h"
 
-#include "mock_LcdHardware.h"
+#include "mock_LcdMailbox.h"
 #include "mock_LcdModel.h"
 #include "mock_ReflexTestData.h"
 
-void testLcdConductor_InitShouldCallModelAndHardwareInit() {
-  LcdModel_Init_Expect();
-  LcdHardware_Init_Expect();
+// The game that every test works on.
+static ReflexTest_Context context;
 
-  LcdConductor_Init();
+void setUp(void) {
+  context.lcdFrameDone = true;
+}
+
+void tearDown(void) {
+}
+
+void testLcdConductor_InitShouldCallModelAndMailboxInit() {
+  context.lcdFrameDone = false;
+  LcdModel_Init_Expect(&context);
+  LcdMailbox_Init_Expect(&context.lcdFrame);
+
+  LcdConductor_Init(&context);
+  TEST_ASSERT_TRUE(LcdConductor_IsFrameDone(&context));
 }
 
 void testLcdConductor_DisplayInfoInShowInfoState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(show_info_st);
-  LcdModel_GetHighScores_ExpectAndReturn(NULL);
-  LcdModel_GetAverageResponseTime_ExpectAndReturn(1.23);
-  LcdHardware_ShowInfo_Expect(NULL, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, 1.23);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  LcdModel_GetHighScores_ExpectAndReturn(&context, NULL);
+  LcdModel_GetAverageResponseTime_ExpectAndReturn(&context, 1230000);
+  LcdMailbox_ShowInfo_Expect(&context.lcdFrame, NULL, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, 1230000);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, false);
+  LcdConductor_Run(&context);
+  TEST_ASSERT_FALSE(LcdConductor_IsFrameDone(&context));
 }
 
 void testLcdConductor_ShouldDoNothingInWaitInfoState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_ShouldDoNothingInWaitFiveSecState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_BlankScreeninBlankScreenState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(blank_screen_st);
-  LcdHardware_BlankScreen_Expect();
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, blank_screen_st);
+  LcdMailbox_BlankScreen_Expect(&context.lcdFrame);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_ShouldDoNothingInWaitBetweenFlashState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(wait_between_flash_st);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  LcdConductor_Run(&context);
 }
 
-void testLcdConductor_DoNothingInBlinkLEDState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(blink_led_st);
-  LcdConductor_Run();
+void testLcdConductor_ShowTargetInBlinkLEDState(void) {
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  LcdModel_GetTarget_ExpectAndReturn(&context, 0x2);
+  LcdMailbox_ShowTargets_Expect(&context.lcdFrame, 0x2);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
+  TEST_ASSERT_TRUE(LcdConductor_IsFrameDone(&context));
 }
 
 void testLcdConductor_ShouldDoNothingInWaitForButtonState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  LcdConductor_Run(&context);
 }
 
-void testLcdConductor_DoNothingInButtonPressedState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(button_pressed_st);
-  LcdConductor_Run();
+void testLcdConductor_HideTargetInButtonPressedState(void) {
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, button_pressed_st);
+  LcdMailbox_ShowTargets_Expect(&context.lcdFrame, 0);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_DisplayStatsInShowStatsState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(show_stats_st);
-  LcdModel_GetAverageResponseTime_ExpectAndReturn(1.2345);
-  LcdModel_GetMinResponseTime_ExpectAndReturn(2.3456);
-  LcdModel_GetMaxResponseTime_ExpectAndReturn(3.4567);
-  LcdHardware_ShowStats_Expect(1.2345, 2.3456, 3.4567);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, show_stats_st);
+  LcdModel_GetAverageResponseTime_ExpectAndReturn(&context, 1234500);
+  LcdModel_GetMinResponseTime_ExpectAndReturn(&context, 2345600);
+  LcdModel_GetMaxResponseTime_ExpectAndReturn(&context, 3456700);
+  LcdMailbox_ShowStats_Expect(&context.lcdFrame, 1234500, 2345600, 3456700);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_ShouldDoNothingInWaitStatsState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(wait_stats_st);
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_stats_st);
+  LcdConductor_Run(&context);
 }
 
 void testLcdConductor_BlankScreenInUpdateScoresState(void) {
-  LcdModel_GetCurrentState_ExpectAndReturn(update_scores_st);
-  LcdHardware_BlankScreen_Expect();
-  LcdConductor_Run();
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, update_scores_st);
+  LcdMailbox_BlankScreen_Expect(&context.lcdFrame);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
+}
+
+void testLcdConductor_IdleStatesShouldFinishAFrameThatIsNotDone(void) {
+  context.lcdFrameDone = false;
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_IDLE_RENDER_BUDGET, false);
+  LcdConductor_Run(&context);
+
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  LcdMailbox_Render_ExpectAndReturn(&context.lcdFrame, LCDCONDUCTOR_IDLE_RENDER_BUDGET, true);
+  LcdConductor_Run(&context);
+  TEST_ASSERT_TRUE(LcdConductor_IsFrameDone(&context));
+
+  // Once the frame is done, the idle states do nothing again.
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  LcdConductor_Run(&context);
+}
+
+void testLcdConductor_ShouldNotDrawWhileThePlayerIsTimed(void) {
+  context.lcdFrameDone = false;
+  LcdModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  LcdConductor_Run(&context);
+  TEST_ASSERT_FALSE(LcdConductor_IsFrameDone(&context));
+}
+
+void testLcdConductor_GetActionShouldOnlyReturnActionsForActiveStates(void) {
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(show_info_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(blank_screen_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(show_stats_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(update_scores_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(wait_between_flash_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(wait_stats_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(blink_led_st));
+  TEST_ASSERT_NOT_NULL(LcdConductor_GetAction(button_pressed_st));
+
+  TEST_ASSERT_NULL(LcdConductor_GetAction(init_st));
+  TEST_ASSERT_NULL(LcdConductor_GetAction(wait_for_button_st));
 }
@@ -0,0 +1,71 @@
+#include "unity.h"
+#include "LcdFrame.h"
+
+// A frame type for the tests; LcdFrame does not look at it.
+#define FRAME_TYPE 3
+
+static LcdFrame frame;
+
+void setUp(void) {
+  LcdFrame_Init(&frame);
+}
+
+void tearDown(void) {
+}
+
+void testLcdFrame_InitShouldLeaveNothingToDraw(void) {
+  TEST_ASSERT_EQUAL(LCDFRAME_NO_FRAME, frame.type);
+  TEST_ASSERT_EQUAL(0, frame.step);
+  TEST_ASSERT_EQUAL(0, frame.shownTargets);
+
+  // With no costs known yet, any step fits.
+  TEST_ASSERT_TRUE(LcdFrame_NextStepFits(&frame, LCDFRAME_FILL_STEP, 100, 100));
+  TEST_ASSERT_TRUE(LcdFrame_NextStepFits(&frame, LCDFRAME_TEXT_STEP, 100, 100));
+}
+
+void testLcdFrame_FinishStepShouldMoveOn(void) {
+  LcdFrame_Start(&frame, FRAME_TYPE);
+  TEST_ASSERT_EQUAL(FRAME_TYPE, frame.type);
+  LcdFrame_FinishStep(&frame, LCDFRAME_FILL_STEP, 10);
+  LcdFrame_FinishStep(&frame, LCDFRAME_TEXT_STEP, 10);
+  TEST_ASSERT_EQUAL(2, frame.step);
+}
+
+void testLcdFrame_NextStepShouldFitByTheLongestOfItsKind(void) {
+  LcdFrame_FinishStep(&frame, LCDFRAME_FILL_STEP, 40);
+  LcdFrame_FinishStep(&frame, LCDFRAME_FILL_STEP, 30);
+  LcdFrame_FinishStep(&frame, LCDFRAME_TEXT_STEP, 5);
+
+  TEST_ASSERT_TRUE(LcdFrame_NextStepFits(&frame, LCDFRAME_FILL_STEP, 60, 100));
+  TEST_ASSERT_FALSE(LcdFrame_NextStepFits(&frame, LCDFRAME_FILL_STEP, 61, 100));
+  TEST_ASSERT_TRUE(LcdFrame_NextStepFits(&frame, LCDFRAME_TEXT_STEP, 95, 100));
+  TEST_ASSERT_FALSE(LcdFrame_NextStepFits(&frame, LCDFRAME_TEXT_STEP, 96, 100));
+}
+
+void testLcdFrame_StartShouldKeepTheStepCosts(void) {
+  LcdFrame_Start(&frame, FRAME_TYPE);
+  LcdFrame_FinishStep(&frame, LCDFRAME_TEXT_STEP, 50);
+
+  LcdFrame_Start(&frame, FRAME_TYPE);
+  TEST_ASSERT_EQUAL(0, frame.step);
+  TEST_ASSERT_FALSE(LcdFrame_NextStepFits(&frame, LCDFRAME_TEXT_STEP, 51, 100));
+}
+
+void testLcdFrame_StartShouldKeepWhatIsOnTheScreen(void) {
+  frame.shownTargets = 0x4;
+  LcdFrame_Start(&frame, FRAME_TYPE);
+  TEST_ASSERT_EQUAL(0x4, frame.shownTargets);
+}
+
+void testLcdFrame_FramesShouldNotShareState(void) {
+  LcdFrame other;
+  LcdFrame_Init(&other);
+  LcdFrame_Start(&frame, FRAME_TYPE);
+  LcdFrame_FinishStep(&frame, LCDFRAME_FILL_STEP, 90);
+  frame.shownTargets = 0x1;
+
+  TEST_ASSERT_EQUAL(LCDFRAME_NO_FRAME, other.type);
+  TEST_ASSERT_EQUAL(0, other.shownTargets);
+  TEST_ASSERT_EQUAL(0, other.step);
+  TEST_ASSERT_TRUE(LcdFrame_NextStepFits(&other, LCDFRAME_FILL_STEP, 100, 100));
+}
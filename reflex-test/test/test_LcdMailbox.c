@@ -0,0 +1,127 @@
+#include "unity.h"
+#include "LcdMailbox.h"
+#include "ReflexTestData.h"
+#include "SpscQueue.h"
+#include "mock_LcdHardware.h"
+#include "mock_secondCore.h"
+#include <string.h>
+
+static uint32_t scores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES] = { 100000, 200000, 300000 };
+
+// The game's frame, and the one the second core draws into.
+static LcdFrame frame;
+static LcdFrame remoteFrame;
+
+// How many times the second core said it had caught up.
+static int doneCount;
+
+static void countDone(void) {
+  doneCount++;
+}
+
+void setUp(void) {
+  LcdMailbox_SetRemote(false);
+  LcdMailbox_SetDoneHandler(NULL);
+  doneCount = 0;
+  memset(&frame, 0, sizeof(frame));
+  memset(&remoteFrame, 0, sizeof(remoteFrame));
+}
+
+void tearDown(void) {
+}
+
+/**
+ * Starts an empty mailbox in remote mode, as Main does for the second core.
+ */
+static void initRemote(void) {
+  LcdMailbox_SetRemote(true);
+  LcdMailbox_Init(&frame);
+}
+
+void testLcdMailbox_LocalModeShouldDrawInTheCaller(void) {
+  LcdHardware_Init_Expect(&frame);
+  LcdMailbox_Init(&frame);
+  TEST_ASSERT_FALSE(LcdMailbox_IsRemote());
+
+  LcdHardware_StartInfo_Expect(&frame, scores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, 200000);
+  LcdMailbox_ShowInfo(&frame, scores, REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES, 200000);
+  LcdHardware_StartBlankScreen_Expect(&frame);
+  LcdMailbox_BlankScreen(&frame);
+  LcdHardware_StartStats_Expect(&frame, 1000000, 500000, 1500000);
+  LcdMailbox_ShowStats(&frame, 1000000, 500000, 1500000);
+  LcdHardware_StartTargets_Expect(&frame, 0x4);
+  LcdMailbox_ShowTargets(&frame, 0x4);
+
+  LcdHardware_Render_ExpectAndReturn(&frame, 300, false);
+  TEST_ASSERT_FALSE(LcdMailbox_Render(&frame, 300));
+
+  TEST_ASSERT_FALSE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_EQUAL(0, LcdMailbox_GetPending());
+}
+
+void testLcdMailbox_RemoteModeShouldQueueCommandsAndWakeTheSecondCore(void) {
+  initRemote();
+  TEST_ASSERT_TRUE(LcdMailbox_IsRemote());
+
+  secondCore_notify_Expect();
+  LcdMailbox_BlankScreen(&frame);
+  secondCore_notify_Expect();
+  LcdMailbox_ShowStats(&frame, 1000000, 500000, 1500000);
+  secondCore_notify_Expect();
+  LcdMailbox_ShowTargets(&frame, 0x4);
+  TEST_ASSERT_EQUAL(3, LcdMailbox_GetPending());
+  TEST_ASSERT_FALSE(LcdMailbox_Render(&frame, 300));
+
+  // The second core draws them in order.
+  LcdHardware_BlankScreen_Expect(&remoteFrame);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+  LcdHardware_ShowStats_Expect(&remoteFrame, 1000000, 500000, 1500000);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+  LcdHardware_ShowTargets_Expect(&remoteFrame, 0x4);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_FALSE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_EQUAL(0, LcdMailbox_GetPending());
+  TEST_ASSERT_TRUE(LcdMailbox_Render(&frame, 300));
+}
+
+void testLcdMailbox_RemoteShowInfoShouldCopyTheScores(void) {
+  uint32_t live[] = { 100000, 200000, 300000 };
+  uint32_t drawn[] = { 100000, 200000, 300000 };
+  initRemote();
+  secondCore_notify_Expect();
+  LcdMailbox_ShowInfo(&frame, live, 3, 300000);
+  live[0] = 9900000;  // the game changes its scores before the frame is drawn
+
+  LcdHardware_ShowInfo_Expect(&remoteFrame, drawn, 3, 300000);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+}
+
+void testLcdMailbox_FullMailboxShouldDropCommands(void) {
+  int i;
+  initRemote();
+  secondCore_notify_Ignore();
+  for (i = 0; i < LCDMAILBOX_CAPACITY + 2; i++) {
+    LcdMailbox_BlankScreen(&frame);
+  }
+  TEST_ASSERT_EQUAL(LCDMAILBOX_CAPACITY, LcdMailbox_GetPending());
+  TEST_ASSERT_EQUAL(2, LcdMailbox_GetDropped());
+}
+
+void testLcdMailbox_DoneHandlerShouldRunOnceTheSecondCoreCatchesUp(void) {
+  initRemote();
+  LcdMailbox_SetDoneHandler(countDone);
+  secondCore_notify_Ignore();
+  LcdMailbox_BlankScreen(&frame);
+  LcdMailbox_ShowTargets(&frame, 0x4);
+
+  LcdHardware_BlankScreen_Expect(&remoteFrame);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_EQUAL(0, doneCount);
+  LcdHardware_ShowTargets_Expect(&remoteFrame, 0x4);
+  TEST_ASSERT_TRUE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_EQUAL(1, doneCount);
+
+  // Nothing was drawn, so nothing is done.
+  TEST_ASSERT_FALSE(LcdMailbox_Service(&remoteFrame));
+  TEST_ASSERT_EQUAL(1, doneCount);
+}
@@ -2,6 +2,9 @@
 #include "LcdModel.h"
 #include "mock_ReflexTestData.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
  void setup() {
 
  }
@@ -13,86 +16,91 @@
 void testLcdModel_GetCurrentStateReturnsStateFromReflexTestData() {
   ReflexTest_st currentState;
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(init_st);
-  currentState = LcdModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, init_st);
+  currentState = LcdModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(init_st, currentState);
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(show_info_st);
-  currentState = LcdModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  currentState = LcdModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(show_info_st, currentState);
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(blink_led_st);
-  currentState = LcdModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  currentState = LcdModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(blink_led_st, currentState);
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(show_stats_st);
-  currentState = LcdModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, show_stats_st);
+  currentState = LcdModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(show_stats_st, currentState);
 
-  ReflexTestData_GetCurrentState_ExpectAndReturn(update_scores_st);
-  currentState = LcdModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, update_scores_st);
+  currentState = LcdModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(update_scores_st, currentState);
 }
 
 void testLcdModel_GetAverageResponseTimePullsDataFromReflexTestData() {
-  double average = 0.0;
+  uint32_t average = 0;
 
-  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(1.123);
-  average = LcdModel_GetAverageResponseTime();
-  TEST_ASSERT_EQUAL(1.123, average);
+  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(&context, 1123000);
+  average = LcdModel_GetAverageResponseTime(&context);
+  TEST_ASSERT_EQUAL(1123000, average);
 
-  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(8.001);
-  average = LcdModel_GetAverageResponseTime();
-  TEST_ASSERT_EQUAL(8.001, average);
+  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(&context, 8001000);
+  average = LcdModel_GetAverageResponseTime(&context);
+  TEST_ASSERT_EQUAL(8001000, average);
 
-  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(7.0);
-  average = LcdModel_GetAverageResponseTime();
-  TEST_ASSERT_EQUAL(7.0, average);
+  ReflexTestData_GetAverageResponseTime_ExpectAndReturn(&context, 7000000);
+  average = LcdModel_GetAverageResponseTime(&context);
+  TEST_ASSERT_EQUAL(7000000, average);
 }
 
 void testLcdModel_GetMinResponseTimePullsDataFromReflexTestData() {
-  double min = 0.0;
+  uint32_t min = 0;
 
-  ReflexTestData_GetMinResponseTime_ExpectAndReturn(0.123);
-  min = LcdModel_GetMinResponseTime();
-  TEST_ASSERT_EQUAL(0.123, min);
+  ReflexTestData_GetMinResponseTime_ExpectAndReturn(&context, 123000);
+  min = LcdModel_GetMinResponseTime(&context);
+  TEST_ASSERT_EQUAL(123000, min);
 
-  ReflexTestData_GetMinResponseTime_ExpectAndReturn(1.189);
-  min = LcdModel_GetMinResponseTime();
-  TEST_ASSERT_EQUAL(1.189, min);
+  ReflexTestData_GetMinResponseTime_ExpectAndReturn(&context, 1189000);
+  min = LcdModel_GetMinResponseTime(&context);
+  TEST_ASSERT_EQUAL(1189000, min);
 
-  ReflexTestData_GetMinResponseTime_ExpectAndReturn(7.0);
-  min = LcdModel_GetMinResponseTime();
-  TEST_ASSERT_EQUAL(7.0, min);
+  ReflexTestData_GetMinResponseTime_ExpectAndReturn(&context, 7000000);
+  min = LcdModel_GetMinResponseTime(&context);
+  TEST_ASSERT_EQUAL(7000000, min);
 }
 
 void testLcdModel_GetMaxResponseTimePullsDataFromReflexTestData() {
-  double max = 0.0;
+  uint32_t max = 0;
 
-  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(0.123);
-  max = LcdModel_GetMaxResponseTime();
-  TEST_ASSERT_EQUAL(0.123, max);
+  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(&context, 123000);
+  max = LcdModel_GetMaxResponseTime(&context);
+  TEST_ASSERT_EQUAL(123000, max);
 
-  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(1.189);
-  max = LcdModel_GetMaxResponseTime();
-  TEST_ASSERT_EQUAL(1.189, max);
+  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(&context, 1189000);
+  max = LcdModel_GetMaxResponseTime(&context);
+  TEST_ASSERT_EQUAL(1189000, max);
 
-  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(7.0);
-  max = LcdModel_GetMaxResponseTime();
-  TEST_ASSERT_EQUAL(7.0, max);
+  ReflexTestData_GetMaxResponseTime_ExpectAndReturn(&context, 7000000);
+  max = LcdModel_GetMaxResponseTime(&context);
+  TEST_ASSERT_EQUAL(7000000, max);
 }
 
-void testLcdModel_GetHighScoresShouldReturnAPointerToAnArrayOfDoubles() {
-  double* address;
-  ReflexTestData_GetHighScores_ExpectAndReturn((double *)0xDEADBEEF);
-  address = LcdModel_GetHighScores();
+void testLcdModel_GetHighScoresShouldReturnAPointerToAnArrayOfScores() {
+  uint32_t* address;
+  ReflexTestData_GetHighScores_ExpectAndReturn(&context, (uint32_t *)0xDEADBEEF);
+  address = LcdModel_GetHighScores(&context);
   TEST_ASSERT_EQUAL(0xDEADBEEF, address);
 
-  ReflexTestData_GetHighScores_ExpectAndReturn((double *)0x10203040);
-  address = LcdModel_GetHighScores();
+  ReflexTestData_GetHighScores_ExpectAndReturn(&context, (uint32_t *)0x10203040);
+  address = LcdModel_GetHighScores(&context);
   TEST_ASSERT_EQUAL(0x10203040, address);
 
-  ReflexTestData_GetHighScores_ExpectAndReturn((double *)0x12341234);
-  address = LcdModel_GetHighScores();
+  ReflexTestData_GetHighScores_ExpectAndReturn(&context, (uint32_t *)0x12341234);
+  address = LcdModel_GetHighScores(&context);
   TEST_ASSERT_EQUAL(0x12341234, address);
 }
+
+void testLcdModel_GetTargetShouldReturnTheLedInPlay() {
+  ReflexTestData_GetLed_ExpectAndReturn(&context, 0x4);
+  TEST_ASSERT_EQUAL(0x4, LcdModel_GetTarget(&context));
+}
@@ -4,6 +4,9 @@
 #include "mock_LedHardware.h"
 #include <stdbool.h>
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup() {
 
 }
@@ -13,84 +16,96 @@ void tearDown() {
 }
 
 void testInitShouldCallModelAndHardwareInit() {
-  LedModel_Init_Expect();
-  LedHardware_Init_Expect();
+  LedModel_Init_Expect(&context);
+  LedHardware_Init_Expect(&context.leds);
 
-  LedConductor_Init();
+  LedConductor_Init(&context);
 }
 
 void testLedConductor_RunShouldDriveStateMachine() {
 
-  LedModel_GetCurrentState_ExpectAndReturn(init_st);
+  LedModel_GetCurrentState_ExpectAndReturn(&context, init_st);
 
-  LedConductor_Run();
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_InitShouldCallModelAndHardwareInit(void) {
-  LedModel_Init_Expect();
-  LedHardware_Init_Expect();
+  LedModel_Init_Expect(&context);
+  LedHardware_Init_Expect(&context.leds);
 
-  LedConductor_Init();
+  LedConductor_Init(&context);
 }
 
 void testLedConductor_BlankLEDsInShowInfoState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(show_info_st);
-  LedHardware_BlankAllLeds_Expect();
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  LedHardware_BlankAllLeds_Expect(&context.leds);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_BlankLEDsInWaitInfoState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  LedHardware_BlankAllLeds_Expect();
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  LedHardware_BlankAllLeds_Expect(&context.leds);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInWaitFiveSecState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInBlankScreenState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(blank_screen_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, blank_screen_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInWaitBetweenFlashState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(wait_between_flash_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_TurnOnTheNextLEDInLEDState(void) {
-  // NOTE: The interval timer is started by the Timer Conductor
-  LedModel_GetCurrentState_ExpectAndReturn(blink_led_st);
-  LedModel_GetLed_ExpectAndReturn(0x1);
-  LedHardware_Enable_Expect(0x1);
-  LedConductor_Run();
+  // The time the LED went on is what the response is measured from.
+  LedModel_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  LedModel_GetLed_ExpectAndReturn(&context, 0x1);
+  LedHardware_Stimulus_ExpectAndReturn(&context.leds, 0x1, 123456);
+  LedModel_SetStimulusTime_Expect(&context, 123456);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInWaitForButtonState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_TurnOffTheLEDsAndIncrementInButtonPressedState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(button_pressed_st);
-  LedModel_IncrementIndex_Expect();
-  LedHardware_BlankAllLeds_Expect();
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, button_pressed_st);
+  LedModel_IncrementIndex_Expect(&context);
+  LedHardware_BlankAllLeds_Expect(&context.leds);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInShowStatsState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(show_stats_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, show_stats_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInWaitStatsState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(wait_stats_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, wait_stats_st);
+  LedConductor_Run(&context);
 }
 
 void testLedConductor_ShouldDoNothingInUpdateScoresState(void) {
-  LedModel_GetCurrentState_ExpectAndReturn(update_scores_st);
-  LedConductor_Run();
+  LedModel_GetCurrentState_ExpectAndReturn(&context, update_scores_st);
+  LedConductor_Run(&context);
+}
+
+void testLedConductor_GetActionShouldOnlyReturnActionsForActiveStates(void) {
+  TEST_ASSERT_NOT_NULL(LedConductor_GetAction(show_info_st));
+  TEST_ASSERT_NOT_NULL(LedConductor_GetAction(wait_info_st));
+  TEST_ASSERT_NOT_NULL(LedConductor_GetAction(blink_led_st));
+  TEST_ASSERT_NOT_NULL(LedConductor_GetAction(button_pressed_st));
+
+  TEST_ASSERT_NULL(LedConductor_GetAction(init_st));
+  TEST_ASSERT_NULL(LedConductor_GetAction(wait_between_flash_st));
+  TEST_ASSERT_NULL(LedConductor_GetAction(wait_stats_st));
 }
@@ -1,13 +1,20 @@
 #include "unity.h"
 #include "LedHardware.h"
+#include "LedShadow.h"
 #include "mock_LedModel.h"
 #include "mock_LedConductor.h"
 #include "mock_leds.h"
+#include "mock_InputLog.h"
+#include "mock_globalTimer.h"
 
 #include <stdbool.h>
 
-void setup() {
+// The shadow of the game that every test works on.
+static LedShadow shadow;
 
+void setUp() {
+  leds_init_ExpectAndReturn(false, 0);
+  LedHardware_Init(&shadow);
 }
 
 void tearDown() {
@@ -16,7 +23,8 @@ void tearDown() {
 
 void testLedHardware_InitShouldCallLeds_Init() {
   leds_init_ExpectAndReturn(false, 88);
-  LedHardware_Init();
+  LedHardware_Init(&shadow);
+  TEST_ASSERT_EQUAL(LEDSHADOW_UNKNOWN, shadow.leds);
 }
 
 void testLedHardware_LEDNumbersMustBeConvertedCorrectly() {
@@ -24,19 +32,62 @@ void testLedHardware_LEDNumbersMustBeConvertedCorrectly() {
   // LED number {0, 1, 2, 3, 4} into the bit mask needed by the hardware.
 
   leds_write_ExpectAndReturn(0x8, 0);
-  LedHardware_Enable(4);
+  LedHardware_Enable(&shadow, 4);
 
   leds_write_ExpectAndReturn(0x4, 0);
-  LedHardware_Enable(3);
+  LedHardware_Enable(&shadow, 3);
 
   leds_write_ExpectAndReturn(0x2, 0);
-  LedHardware_Enable(2);
+  LedHardware_Enable(&shadow, 2);
 
   leds_write_ExpectAndReturn(0x1, 0);
-  LedHardware_Enable(1);
+  LedHardware_Enable(&shadow, 1);
 }
 
 void testLedHardware_BlankLEDsShouldWriteZeroToHardware() {
   leds_write_ExpectAndReturn(0x0, 0);
-  LedHardware_BlankAllLeds();
+  LedHardware_BlankAllLeds(&shadow);
+}
+
+void testLedHardware_StimulusShouldStampTheLedWrite() {
+  // The timer is read right before the write, and logged after it.
+  globalTimer_getTimerValue_ExpectAndReturn(2000 * 325ULL);
+  leds_write_ExpectAndReturn(0x4, 0);
+  InputLog_Timestamp_ExpectAndReturn(2000, 2000);
+  TEST_ASSERT_EQUAL_UINT64(2000, LedHardware_Stimulus(&shadow, 3));
+}
+
+void testLedHardware_RewritingTheSameValueShouldBeSkipped() {
+  leds_write_ExpectAndReturn(0x0, 0);
+  LedHardware_BlankAllLeds(&shadow);
+  // The LEDs are already off: nothing goes out.
+  LedHardware_BlankAllLeds(&shadow);
+  LedHardware_BlankAllLeds(&shadow);
+
+  TEST_ASSERT_EQUAL(1, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(2, LedShadow_GetElidedWrites(&shadow));
+
+  leds_write_ExpectAndReturn(0x2, 0);
+  LedHardware_Enable(&shadow, 2);
+  LedHardware_Enable(&shadow, 2);
+  leds_write_ExpectAndReturn(0x0, 0);
+  LedHardware_BlankAllLeds(&shadow);
+
+  TEST_ASSERT_EQUAL(3, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(3, LedShadow_GetElidedWrites(&shadow));
+}
+
+void testLedHardware_StimulusShouldAlwaysBeWritten() {
+  // Even if the LED were already on, the stimulus is the write itself.
+  leds_write_ExpectAndReturn(0x4, 0);
+  LedHardware_Enable(&shadow, 3);
+  globalTimer_getTimerValue_ExpectAndReturn(2000 * 325ULL);
+  leds_write_ExpectAndReturn(0x4, 0);
+  InputLog_Timestamp_ExpectAndReturn(2000, 2000);
+  LedHardware_Stimulus(&shadow, 3);
+
+  // The shadow follows the stimulus.
+  LedHardware_Enable(&shadow, 3);
+  TEST_ASSERT_EQUAL(2, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(1, LedShadow_GetElidedWrites(&shadow));
 }
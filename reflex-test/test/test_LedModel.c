@@ -4,6 +4,9 @@
 #include "mock_LedConductor.h"
 #include "mock_ReflexTestData.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup() {
 
 }
@@ -13,26 +16,31 @@ void tearDown() {
 }
 
 void testLedModel_ShouldIncrementIndexOfReflexTestData() {
-  ReflexTestData_IncrementIndex_Expect();
-  LedModel_IncrementIndex();
+  ReflexTestData_IncrementIndex_Expect(&context);
+  LedModel_IncrementIndex(&context);
 }
 
 void testLedModel_ShouldGetCurrentStateFromReflexTestData() {
-  ReflexTestData_GetCurrentState_ExpectAndReturn(init_st);
-  ReflexTest_st test = LedModel_GetCurrentState();
+  ReflexTestData_GetCurrentState_ExpectAndReturn(&context, init_st);
+  ReflexTest_st test = LedModel_GetCurrentState(&context);
   TEST_ASSERT_EQUAL(init_st, test);
 }
 
 void testLedModel_GetLedShouldGetLedFromReflexTestData() {
-  ReflexTestData_GetLed_ExpectAndReturn(0x1);
-  int32_t test = LedModel_GetLed();
+  ReflexTestData_GetLed_ExpectAndReturn(&context, 0x1);
+  int32_t test = LedModel_GetLed(&context);
   TEST_ASSERT_EQUAL(0x1, test);
 }
 
 void testLedModel_IsSequenceDoneShouldReturnBoolFromReflexTestData() {
-  ReflexTestData_IsSequenceDone_ExpectAndReturn(true);
-  TEST_ASSERT_TRUE(LedModel_IsSequenceDone());
+  ReflexTestData_IsSequenceDone_ExpectAndReturn(&context, true);
+  TEST_ASSERT_TRUE(LedModel_IsSequenceDone(&context));
+
+  ReflexTestData_IsSequenceDone_ExpectAndReturn(&context, false);
+  TEST_ASSERT_FALSE(LedModel_IsSequenceDone(&context));
+}
 
-  ReflexTestData_IsSequenceDone_ExpectAndReturn(false);
-  TEST_ASSERT_FALSE(LedModel_IsSequenceDone());
+void testLedModel_SetStimulusTimeShouldSaveToReflexTestData() {
+  ReflexTestData_SetStimulusTime_Expect(&context, 123456);
+  LedModel_SetStimulusTime(&context, 123456);
 }
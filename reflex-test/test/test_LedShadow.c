@@ -0,0 +1,42 @@
+#include "unity.h"
+#include "LedShadow.h"
+
+static LedShadow shadow;
+
+void setUp(void) {
+  LedShadow_Init(&shadow);
+}
+
+void tearDown(void) {
+}
+
+void testLedShadow_InitShouldKnowNothingAndCountNothing(void) {
+  TEST_ASSERT_EQUAL(LEDSHADOW_UNKNOWN, shadow.leds);
+  TEST_ASSERT_EQUAL(0, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(0, LedShadow_GetElidedWrites(&shadow));
+}
+
+void testLedShadow_FirstWriteShouldAlwaysGoOut(void) {
+  TEST_ASSERT_TRUE(LedShadow_Update(&shadow, 0x0));
+  TEST_ASSERT_EQUAL(1, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(0, LedShadow_GetElidedWrites(&shadow));
+}
+
+void testLedShadow_SameValueShouldBeSkipped(void) {
+  TEST_ASSERT_TRUE(LedShadow_Update(&shadow, 0x2));
+  TEST_ASSERT_FALSE(LedShadow_Update(&shadow, 0x2));
+  TEST_ASSERT_FALSE(LedShadow_Update(&shadow, 0x2));
+  TEST_ASSERT_TRUE(LedShadow_Update(&shadow, 0x0));
+
+  TEST_ASSERT_EQUAL(2, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(2, LedShadow_GetElidedWrites(&shadow));
+}
+
+void testLedShadow_ForcedWriteShouldCountAndBeRemembered(void) {
+  TEST_ASSERT_TRUE(LedShadow_Update(&shadow, 0x4));
+  LedShadow_Force(&shadow, 0x4);
+  TEST_ASSERT_FALSE(LedShadow_Update(&shadow, 0x4));
+
+  TEST_ASSERT_EQUAL(2, LedShadow_GetIssuedWrites(&shadow));
+  TEST_ASSERT_EQUAL(1, LedShadow_GetElidedWrites(&shadow));
+}
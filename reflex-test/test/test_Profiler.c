@@ -0,0 +1,171 @@
+#include "unity.h"
+#include "Profiler.h"
+#include "mock_ReflexTestData.h"
+
+void setUp(void) {
+  Profiler_Init();
+}
+
+void tearDown(void) {
+}
+
+void testProfiler_InitShouldClearAllStates(void) {
+  Profiler_RecordBusy(wait_info_st, 100);
+  Profiler_RecordIdle(wait_info_st, 100);
+
+  Profiler_Init();
+
+  TEST_ASSERT_EQUAL(0, Profiler_GetBusyCycles(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetIdleCycles(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetBusyPercent(wait_info_st));
+}
+
+void testProfiler_ShouldAccumulateTimePerState(void) {
+  Profiler_RecordBusy(wait_info_st, 10);
+  Profiler_RecordBusy(wait_info_st, 15);
+  Profiler_RecordIdle(wait_info_st, 75);
+  Profiler_RecordBusy(show_info_st, 1000);
+
+  TEST_ASSERT_EQUAL(25, Profiler_GetBusyCycles(wait_info_st));
+  TEST_ASSERT_EQUAL(75, Profiler_GetIdleCycles(wait_info_st));
+  TEST_ASSERT_EQUAL(1000, Profiler_GetBusyCycles(show_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetIdleCycles(show_info_st));
+}
+
+void testProfiler_BusyPercentShouldBeBusyOverTotalTime(void) {
+  Profiler_RecordBusy(wait_info_st, 25);
+  Profiler_RecordIdle(wait_info_st, 75);
+  TEST_ASSERT_EQUAL(25, Profiler_GetBusyPercent(wait_info_st));
+
+  Profiler_RecordBusy(show_info_st, 500);
+  TEST_ASSERT_EQUAL(100, Profiler_GetBusyPercent(show_info_st));
+
+  TEST_ASSERT_EQUAL(0, Profiler_GetBusyPercent(wait_stats_st));
+}
+
+void testProfiler_ShouldIgnoreInvalidStates(void) {
+  Profiler_RecordBusy(REFLEXTESTDATA_NUMBER_OF_STATES, 100);
+  Profiler_RecordIdle(REFLEXTESTDATA_NUMBER_OF_STATES, 100);
+}
+
+void testProfiler_InitShouldClearTickData(void) {
+  Profiler_SetTickBudget(wait_info_st, 1000);
+  Profiler_RecordTick(wait_info_st, 0, 2000);
+  Profiler_RecordTick(wait_info_st, 900, 1000);
+  Profiler_RecordMissedTicks(wait_info_st, 3);
+
+  Profiler_Init();
+
+  TEST_ASSERT_EQUAL(0, Profiler_GetTicks(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetOverruns(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetMissedTicks(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetLongestTick(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetTickHistogram(wait_info_st, PROFILER_NUMBER_OF_TICK_BUCKETS - 1));
+  TEST_ASSERT_EQUAL(0, Profiler_GetMaxJitter());
+  TEST_ASSERT_EQUAL(0, Profiler_GetTickBudget(wait_info_st));
+}
+
+void testProfiler_TicksOverTheBudgetShouldBeOverruns(void) {
+  Profiler_SetTickBudget(show_info_st, 1000);
+  Profiler_SetTickBudget(wait_info_st, 1000);
+  Profiler_RecordTick(show_info_st, 0, 1000);
+  Profiler_RecordTick(show_info_st, 1000, 2001);
+  Profiler_RecordTick(show_info_st, 2001, 7000);
+  Profiler_RecordTick(wait_info_st, 7000, 7010);
+
+  TEST_ASSERT_EQUAL(3, Profiler_GetTicks(show_info_st));
+  TEST_ASSERT_EQUAL(2, Profiler_GetOverruns(show_info_st));
+  TEST_ASSERT_EQUAL(4999, Profiler_GetLongestTick(show_info_st));
+  TEST_ASSERT_EQUAL(1, Profiler_GetTicks(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetOverruns(wait_info_st));
+  TEST_ASSERT_EQUAL(10, Profiler_GetLongestTick(wait_info_st));
+}
+
+void testProfiler_TicksShouldBeBucketedByFractionOfTheBudget(void) {
+  Profiler_SetTickBudget(blink_led_st, 6400);
+  Profiler_RecordTick(blink_led_st, 0, 99);      // under 1/64 of the budget
+  Profiler_RecordTick(blink_led_st, 0, 100);     // 1/64 to 1/32
+  Profiler_RecordTick(blink_led_st, 0, 3200);    // top half of the budget
+  Profiler_RecordTick(blink_led_st, 0, 6399);
+  Profiler_RecordTick(blink_led_st, 0, 6400);    // up to twice the budget
+  Profiler_RecordTick(blink_led_st, 0, 12800);   // more than twice
+
+  TEST_ASSERT_EQUAL(1, Profiler_GetTickHistogram(blink_led_st, 0));
+  TEST_ASSERT_EQUAL(1, Profiler_GetTickHistogram(blink_led_st, 1));
+  TEST_ASSERT_EQUAL(0, Profiler_GetTickHistogram(blink_led_st, 5));
+  TEST_ASSERT_EQUAL(2, Profiler_GetTickHistogram(blink_led_st, PROFILER_BUDGET_BUCKET));
+  TEST_ASSERT_EQUAL(1, Profiler_GetTickHistogram(blink_led_st, PROFILER_BUDGET_BUCKET + 1));
+  TEST_ASSERT_EQUAL(1, Profiler_GetTickHistogram(blink_led_st, PROFILER_NUMBER_OF_TICK_BUCKETS - 1));
+}
+
+void testProfiler_JitterShouldBeTheWorstTickPeriodError(void) {
+  Profiler_SetTickBudget(wait_info_st, 1000);
+  Profiler_RecordTick(wait_info_st, 1000, 1010);
+  Profiler_RecordTick(wait_info_st, 2000, 2010);
+  TEST_ASSERT_EQUAL(0, Profiler_GetMaxJitter());
+
+  Profiler_RecordTick(wait_info_st, 3250, 3260);   // late
+  Profiler_RecordTick(wait_info_st, 3350, 3360);   // early
+  TEST_ASSERT_EQUAL(900, Profiler_GetMaxJitter());
+}
+
+void testProfiler_EachStateShouldBeCheckedAgainstItsOwnBudget(void) {
+  Profiler_SetTickBudget(blink_led_st, 3250000);
+  Profiler_SetTickBudget(wait_for_button_st, 16250);
+  Profiler_RecordTick(blink_led_st, 0, 20000);
+  Profiler_RecordTick(wait_for_button_st, 3250000, 3250100);
+  Profiler_RecordTick(wait_for_button_st, 3266250, 3266300);
+
+  TEST_ASSERT_EQUAL(3250000, Profiler_GetTickBudget(blink_led_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetOverruns(blink_led_st));
+  TEST_ASSERT_EQUAL(1, Profiler_GetTickHistogram(blink_led_st, 0));
+  TEST_ASSERT_EQUAL(0, Profiler_GetOverruns(wait_for_button_st));
+  TEST_ASSERT_EQUAL(2, Profiler_GetTickHistogram(wait_for_button_st, 0));
+}
+
+void testProfiler_JitterShouldNotSpanAChangeOfBudget(void) {
+  Profiler_SetTickBudget(wait_five_seconds_st, 1000);
+  Profiler_SetTickBudget(blink_led_st, 100);
+  Profiler_RecordTick(wait_five_seconds_st, 1000, 1010);
+  // The timer restarted at the new rate somewhere in between.
+  Profiler_RecordTick(blink_led_st, 1500, 1510);
+  TEST_ASSERT_EQUAL(0, Profiler_GetMaxJitter());
+
+  Profiler_RecordTick(blink_led_st, 1610, 1620);
+  TEST_ASSERT_EQUAL(10, Profiler_GetMaxJitter());
+}
+
+void testProfiler_ShouldCountMissedTicksPerState(void) {
+  Profiler_RecordMissedTicks(show_info_st, 2);
+  Profiler_RecordMissedTicks(show_info_st, 3);
+  Profiler_RecordMissedTicks(REFLEXTESTDATA_NUMBER_OF_STATES, 1);
+
+  TEST_ASSERT_EQUAL(5, Profiler_GetMissedTicks(show_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetMissedTicks(wait_info_st));
+}
+
+void testProfiler_TicksShouldOnlyBeCountedWithoutABudget(void) {
+  Profiler_RecordTick(wait_info_st, 0, 5000);
+
+  TEST_ASSERT_EQUAL(1, Profiler_GetTicks(wait_info_st));
+  TEST_ASSERT_EQUAL(5000, Profiler_GetLongestTick(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetOverruns(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetTickHistogram(wait_info_st, PROFILER_NUMBER_OF_TICK_BUCKETS - 1));
+}
+
+void testProfiler_ShouldCountLedWritesPerState(void) {
+  Profiler_RecordLedWrites(wait_info_st, 1, 0);
+  Profiler_RecordLedWrites(wait_info_st, 0, 2);
+  Profiler_RecordLedWrites(blink_led_st, 1, 0);
+  Profiler_RecordLedWrites(REFLEXTESTDATA_NUMBER_OF_STATES, 1, 1);
+
+  TEST_ASSERT_EQUAL(1, Profiler_GetIssuedLedWrites(wait_info_st));
+  TEST_ASSERT_EQUAL(2, Profiler_GetElidedLedWrites(wait_info_st));
+  TEST_ASSERT_EQUAL(1, Profiler_GetIssuedLedWrites(blink_led_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetElidedLedWrites(blink_led_st));
+
+  Profiler_Init();
+
+  TEST_ASSERT_EQUAL(0, Profiler_GetIssuedLedWrites(wait_info_st));
+  TEST_ASSERT_EQUAL(0, Profiler_GetElidedLedWrites(wait_info_st));
+}
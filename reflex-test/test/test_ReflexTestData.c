@@ -1,6 +1,9 @@
 #include "unity.h"
 #include "ReflexTestData.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup(void) {
 }
 
@@ -9,80 +12,80 @@ void tearDown(void) {
 
 void testReflexTestData_InitShouldInitAllStateVariables() {
   // Set the internal state variables to various things
-  ReflexTestData_SetResponseTime(1.234);
-  ReflexTestData_IncrementIndex();
-  ReflexTestData_GenerateSequence(123);
-  ReflexTestData_SetPressedButton(0x4);
-  ReflexTestData_SetCurrentState(show_info_st);
-  ReflexTestData_SetMaxResponseTime(0.345);
-  ReflexTestData_SetMinResponseTime(0.002);
-  ReflexTestData_SetAverageResponseTime(0.123);
+  ReflexTestData_SetResponseTime(&context, 1234000);
+  ReflexTestData_IncrementIndex(&context);
+  ReflexTestData_GenerateSequence(&context, 123);
+  ReflexTestData_SetPressedButton(&context, 0x4);
+  ReflexTestData_SetCurrentState(&context, show_info_st);
+  ReflexTestData_SetMaxResponseTime(&context, 345000);
+  ReflexTestData_SetMinResponseTime(&context, 2000);
+  ReflexTestData_SetAverageResponseTime(&context, 123000);
 
   // Call Init
-  ReflexTestData_Init();
+  ReflexTestData_Init(&context);
 
   // Verify that data was re-initialized
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetCurrentIndex());
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetResponseTime());
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetPressedButton());
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetMaxResponseTime());
-  TEST_ASSERT_EQUAL(5, ReflexTestData_GetMinResponseTime());
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetAverageResponseTime());
-  TEST_ASSERT_EQUAL(init_st, ReflexTestData_GetCurrentState());
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetCurrentIndex(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetResponseTime(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetPressedButton(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetMaxResponseTime(&context));
+  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SLOWEST_RESPONSE_TIME, ReflexTestData_GetMinResponseTime(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetAverageResponseTime(&context));
+  TEST_ASSERT_EQUAL(init_st, ReflexTestData_GetCurrentState(&context));
 
   // NOTE: Sequence cannot be directly tested, but if the above worked,
   // the sequence will have been cleared as well.
 }
 
 void testReflexTestData_CheckIfIsCorrectButtonWorks() {
-  ReflexTestData_Init();
+  ReflexTestData_Init(&context);
   // Generate a sequence of:
-  // {2, 2, 2, 3, 4, 4, 4, 3, 3, 2};
-  ReflexTestData_GenerateSequence(123);
+  // {2, 2, 4, 1, 1, 4, 2, 2, 2, 1};
+  ReflexTestData_GenerateSequence(&context, 123);
 
   // Set the button to the correct button
-  ReflexTestData_SetPressedButton(2);
-  TEST_ASSERT_TRUE(ReflexTestData_IsCorrectButtonPressed());
+  ReflexTestData_SetPressedButton(&context, 2);
+  TEST_ASSERT_TRUE(ReflexTestData_IsCorrectButtonPressed(&context));
 
   // Set button to incorrect button
-  ReflexTestData_SetPressedButton(1);
-  TEST_ASSERT_FALSE(ReflexTestData_IsCorrectButtonPressed());
+  ReflexTestData_SetPressedButton(&context, 1);
+  TEST_ASSERT_FALSE(ReflexTestData_IsCorrectButtonPressed(&context));
 }
 
 void testReflexTestData_IncrementIndexShouldOnlyIncrementToTotalLength() {
-  ReflexTestData_Init();
-  TEST_ASSERT_EQUAL(0, ReflexTestData_GetCurrentIndex());
+  ReflexTestData_Init(&context);
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetCurrentIndex(&context));
 
   int i;
   // Iterate more times than there are sequences
   for (i = 0; i < (REFLEXTESTDATA_SEQUENCE_LENGTH*2); i++) {
-    ReflexTestData_IncrementIndex();
+    ReflexTestData_IncrementIndex(&context);
   }
 
-  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SEQUENCE_LENGTH, ReflexTestData_GetCurrentIndex());
+  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SEQUENCE_LENGTH, ReflexTestData_GetCurrentIndex(&context));
 }
 
 void testReflexTestData_GetLEDShouldReturnCurrentLEDOfSequence() {
-  ReflexTestData_Init();
+  ReflexTestData_Init(&context);
   // Generate a sequence of:
-  // {2, 4, 2, 3, 2, 3, 4, 2, 4, 4};
-  ReflexTestData_GenerateSequence(88);
+  // {2, 2, 4, 2, 1, 4, 1, 4, 2, 3};
+  ReflexTestData_GenerateSequence(&context, 88);
 
-  TEST_ASSERT_EQUAL(2, ReflexTestData_GetLed());
+  TEST_ASSERT_EQUAL(2, ReflexTestData_GetLed(&context));
 }
 
 void testReflexTestData_IsSequenceDoneShouldReturnTrueWhenIndexReachesEnd() {
-  ReflexTestData_Init();
+  ReflexTestData_Init(&context);
 
-  TEST_ASSERT_FALSE(ReflexTestData_IsSequenceDone());
+  TEST_ASSERT_FALSE(ReflexTestData_IsSequenceDone(&context));
 
   // Increment the index to the end.
   int i;
   for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
-    ReflexTestData_IncrementIndex();
+    ReflexTestData_IncrementIndex(&context);
   }
 
-  TEST_ASSERT_TRUE(ReflexTestData_IsSequenceDone());
+  TEST_ASSERT_TRUE(ReflexTestData_IsSequenceDone(&context));
 }
 
 void testReflexTestData_UpdateScoresShouldSortTheListOfHighScores() {
@@ -96,47 +99,119 @@ void testReflexTestData_UpdateScoresShouldSortTheListOfHighScores() {
   //  adds the average to the list, if the average is faster than the slowest
   //  high score.
 
-  double testScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES] =
+  uint32_t testScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES] =
   {
-    9.111,
-    8.222,
-    7.333,
-    6.444,
-    5.555,
-    4.666,
-    3.777,
-    2.888,
-    1.999,
-    15.50 //this time will be dropped
+    9111000,
+    8222000,
+    7333000,
+    6444000,
+    5555000,
+    4666000,
+    3777000,
+    2888000,
+    1999000,
+    15500000 //this time will be dropped
   };
 
 
-  double sortedScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES] =
+  uint32_t sortedScores[REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES] =
   {
-    1.111, //update scores updates with the current average
-    1.999,
-    2.888,
-    3.777,
-    4.666,
-    5.555,
-    6.444,
-    7.333,
-    8.222,
-    9.111
+    1111000, //update scores updates with the current average
+    1999000,
+    2888000,
+    3777000,
+    4666000,
+    5555000,
+    6444000,
+    7333000,
+    8222000,
+    9111000
   };
 
-  double inputAverage = 1.111;
-  ReflexTestData_TestOnly_SetScores(testScores);
-  ReflexTestData_SetAverageResponseTime(inputAverage);
+  uint32_t inputAverage = 1111000;
+  ReflexTestData_TestOnly_SetScores(&context, testScores);
+  ReflexTestData_SetAverageResponseTime(&context, inputAverage);
 
-  ReflexTestData_UpdateScores();
+  ReflexTestData_UpdateScores(&context);
 
-  double* returnedScores = ReflexTestData_GetHighScores();
+  uint32_t* returnedScores = ReflexTestData_GetHighScores(&context);
 
   int i;
   for (i = 0; i < REFLEXTESTDATA_NUMBER_OF_HIGH_SCORES; i++) {
-    TEST_ASSERT_EQUAL_FLOAT(returnedScores[i], sortedScores[i]);
-    printf("returnedScore: %lf    sortedScore: %lf\n", returnedScores[i], sortedScores[i]);
+    TEST_ASSERT_EQUAL(returnedScores[i], sortedScores[i]);
+    printf("returnedScore: %lu    sortedScore: %lu\n",
+           (unsigned long) returnedScores[i], (unsigned long) sortedScores[i]);
   }
 
 }
+
+void testReflexTestData_GetStateNameShouldNameEveryState() {
+  TEST_ASSERT_EQUAL_STRING("init_st", ReflexTestData_GetStateName(init_st));
+  TEST_ASSERT_EQUAL_STRING("wait_between_flash_st",
+                           ReflexTestData_GetStateName(wait_between_flash_st));
+  TEST_ASSERT_EQUAL_STRING("update_scores_st",
+                           ReflexTestData_GetStateName(update_scores_st));
+  TEST_ASSERT_EQUAL_STRING("unknown_st",
+                           ReflexTestData_GetStateName(REFLEXTESTDATA_NUMBER_OF_STATES));
+}
+
+void testReflexTestData_GamesShouldNotShareState() {
+  ReflexTest_Context otherGame;
+  ReflexTestData_Init(&context);
+  ReflexTestData_Init(&otherGame);
+
+  ReflexTestData_IncrementIndex(&context);
+  ReflexTestData_SetCurrentState(&context, wait_stats_st);
+  ReflexTestData_SetPressedButton(&otherGame, 3);
+
+  TEST_ASSERT_EQUAL(1, ReflexTestData_GetCurrentIndex(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetCurrentIndex(&otherGame));
+  TEST_ASSERT_EQUAL(wait_stats_st, ReflexTestData_GetCurrentState(&context));
+  TEST_ASSERT_EQUAL(init_st, ReflexTestData_GetCurrentState(&otherGame));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetPressedButton(&context));
+  TEST_ASSERT_EQUAL(3, ReflexTestData_GetPressedButton(&otherGame));
+}
+
+void testReflexTestData_PressTimeShouldStartUnknown() {
+  ReflexTestData_Init(&context);
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetPressTime(&context));
+  ReflexTestData_SetPressTime(&context, 42);
+  TEST_ASSERT_EQUAL(42, ReflexTestData_GetPressTime(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetStimulusTime(&context));
+  ReflexTestData_SetStimulusTime(&context, 40);
+  TEST_ASSERT_EQUAL(40, ReflexTestData_GetStimulusTime(&context));
+}
+
+void testReflexTestData_UpdateScoresShouldSkipRoundsWithTooManyFalseStarts() {
+  ReflexTestData_Init(&context);
+  ReflexTestData_SetAverageResponseTime(&context, 150000);
+  ReflexTestData_SetFalseStarts(&context, REFLEXTESTDATA_MAX_FALSE_STARTS + 1);
+  ReflexTestData_UpdateScores(&context);
+  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SLOWEST_RESPONSE_TIME, ReflexTestData_GetHighScores(&context)[0]);
+
+  // A few false starts are forgiven, since they did not count anyway.
+  ReflexTestData_SetFalseStarts(&context, REFLEXTESTDATA_MAX_FALSE_STARTS);
+  ReflexTestData_UpdateScores(&context);
+  TEST_ASSERT_EQUAL(150000, ReflexTestData_GetHighScores(&context)[0]);
+}
+
+void testReflexTestData_InitShouldClearFalseStarts() {
+  ReflexTestData_SetAnticipated(&context, true);
+  ReflexTestData_SetFalseStarts(&context, 3);
+  ReflexTestData_Init(&context);
+  TEST_ASSERT_FALSE(ReflexTestData_IsAnticipated(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetFalseStarts(&context));
+}
+
+void testReflexTestData_WrongPressesShouldStartOverWithEverySequence() {
+  ReflexTestData_Init(&context);
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetWrongPressLatency(&context));
+  ReflexTestData_RecordWrongPresses(&context, 1, 200000);
+  ReflexTestData_RecordWrongPresses(&context, 3, 100000);
+  TEST_ASSERT_EQUAL(4, ReflexTestData_GetWrongPresses(&context));
+  TEST_ASSERT_EQUAL(150000, ReflexTestData_GetWrongPressLatency(&context));
+
+  ReflexTestData_GenerateSequence(&context, 1);
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetWrongPresses(&context));
+  TEST_ASSERT_EQUAL(0, ReflexTestData_GetWrongPressLatency(&context));
+}
@@ -0,0 +1,98 @@
+#include "unity.h"
+#include "SoftTimer.h"
+
+static SoftTimer_Group timers;
+
+void setUp(void) {
+  SoftTimer_Init(&timers);
+}
+
+void tearDown(void) {
+}
+
+void testSoftTimer_InitShouldLeaveNoTimersPending(void) {
+  int i;
+  for (i = 0; i < SOFTTIMER_MAX_TIMERS; i++) {
+    TEST_ASSERT_FALSE(SoftTimer_IsPending(&timers, i));
+    TEST_ASSERT_FALSE(SoftTimer_HasExpired(&timers, i));
+  }
+  TEST_ASSERT_EQUAL_UINT64(SOFTTIMER_NEVER, SoftTimer_GetNextDeadline(&timers));
+  TEST_ASSERT_EQUAL(0, SoftTimer_Poll(&timers, SOFTTIMER_NEVER));
+}
+
+void testSoftTimer_TimerShouldExpireOnlyOnceItsDeadlineHasPassed(void) {
+  SoftTimer_Arm(&timers, 2, 1000);
+  TEST_ASSERT_TRUE(SoftTimer_IsPending(&timers, 2));
+
+  TEST_ASSERT_EQUAL(0, SoftTimer_Poll(&timers, 999));
+  TEST_ASSERT_FALSE(SoftTimer_HasExpired(&timers, 2));
+
+  TEST_ASSERT_EQUAL(1 << 2, SoftTimer_Poll(&timers, 1000));
+  TEST_ASSERT_TRUE(SoftTimer_HasExpired(&timers, 2));
+  TEST_ASSERT_FALSE(SoftTimer_IsPending(&timers, 2));
+
+  // A timer only expires once.
+  TEST_ASSERT_EQUAL(0, SoftTimer_Poll(&timers, 2000));
+  TEST_ASSERT_TRUE(SoftTimer_HasExpired(&timers, 2));
+}
+
+void testSoftTimer_NextDeadlineShouldBeTheEarliestPendingDeadline(void) {
+  SoftTimer_Arm(&timers, 0, 500);
+  SoftTimer_Arm(&timers, 1, 300);
+  SoftTimer_Arm(&timers, 2, 700);
+  SoftTimer_Arm(&timers, 3, 100);
+  TEST_ASSERT_EQUAL_UINT64(100, SoftTimer_GetNextDeadline(&timers));
+
+  SoftTimer_Cancel(&timers, 3);
+  TEST_ASSERT_EQUAL_UINT64(300, SoftTimer_GetNextDeadline(&timers));
+
+  TEST_ASSERT_EQUAL((1 << 1) | (1 << 0), SoftTimer_Poll(&timers, 600));
+  TEST_ASSERT_EQUAL_UINT64(700, SoftTimer_GetNextDeadline(&timers));
+}
+
+void testSoftTimer_RearmingShouldReplaceTheDeadlineAndClearExpired(void) {
+  SoftTimer_Arm(&timers, 0, 100);
+  SoftTimer_Poll(&timers, 100);
+  TEST_ASSERT_TRUE(SoftTimer_HasExpired(&timers, 0));
+
+  SoftTimer_Arm(&timers, 0, 300);
+  TEST_ASSERT_FALSE(SoftTimer_HasExpired(&timers, 0));
+  SoftTimer_Arm(&timers, 0, 200);
+  TEST_ASSERT_EQUAL_UINT64(200, SoftTimer_GetNextDeadline(&timers));
+  TEST_ASSERT_EQUAL(1 << 0, SoftTimer_Poll(&timers, 250));
+}
+
+void testSoftTimer_CancelShouldClearExpiredAndIgnoreInvalidTimers(void) {
+  SoftTimer_Arm(&timers, 1, 100);
+  SoftTimer_Poll(&timers, 100);
+  SoftTimer_Cancel(&timers, 1);
+  TEST_ASSERT_FALSE(SoftTimer_HasExpired(&timers, 1));
+
+  SoftTimer_Arm(&timers, SOFTTIMER_MAX_TIMERS, 100);
+  SoftTimer_Cancel(&timers, SOFTTIMER_MAX_TIMERS);
+  TEST_ASSERT_FALSE(SoftTimer_IsPending(&timers, SOFTTIMER_MAX_TIMERS));
+  TEST_ASSERT_EQUAL_UINT64(SOFTTIMER_NEVER, SoftTimer_GetNextDeadline(&timers));
+}
+
+void testSoftTimer_AllTimersShouldExpireInDeadlineOrder(void) {
+  int i;
+  for (i = 0; i < SOFTTIMER_MAX_TIMERS; i++) {
+    SoftTimer_Arm(&timers, i, (SOFTTIMER_MAX_TIMERS - i) * 10);
+  }
+  for (i = SOFTTIMER_MAX_TIMERS - 1; i >= 0; i--) {
+    TEST_ASSERT_EQUAL_UINT64((SOFTTIMER_MAX_TIMERS - i) * 10, SoftTimer_GetNextDeadline(&timers));
+    TEST_ASSERT_EQUAL(1 << i, SoftTimer_Poll(&timers, (SOFTTIMER_MAX_TIMERS - i) * 10));
+  }
+}
+
+void testSoftTimer_GroupsShouldBeIndependent(void) {
+  SoftTimer_Group otherTimers;
+  SoftTimer_Init(&otherTimers);
+
+  SoftTimer_Arm(&timers, 0, 100);
+  SoftTimer_Arm(&otherTimers, 0, 200);
+  TEST_ASSERT_EQUAL(1 << 0, SoftTimer_Poll(&timers, 150));
+  TEST_ASSERT_EQUAL(0, SoftTimer_Poll(&otherTimers, 150));
+  TEST_ASSERT_TRUE(SoftTimer_HasExpired(&timers, 0));
+  TEST_ASSERT_TRUE(SoftTimer_IsPending(&otherTimers, 0));
+}
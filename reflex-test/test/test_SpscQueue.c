@@ -0,0 +1,70 @@
+#include "unity.h"
+#include "SpscQueue.h"
+
+#define CAPACITY 4
+
+static SpscQueue queue;
+static uint32_t storage[CAPACITY];
+
+void setUp(void) {
+  SpscQueue_Init(&queue, storage, sizeof(uint32_t), CAPACITY);
+}
+
+void tearDown(void) {
+}
+
+void testSpscQueue_InitShouldRequireAPowerOfTwo(void) {
+  TEST_ASSERT_FALSE(SpscQueue_Init(&queue, storage, sizeof(uint32_t), 3));
+  TEST_ASSERT_FALSE(SpscQueue_Init(&queue, storage, sizeof(uint32_t), 0));
+  TEST_ASSERT_TRUE(SpscQueue_Init(&queue, storage, sizeof(uint32_t), CAPACITY));
+  TEST_ASSERT_EQUAL(CAPACITY, SpscQueue_GetCapacity(&queue));
+  TEST_ASSERT_EQUAL(0, SpscQueue_GetCount(&queue));
+}
+
+void testSpscQueue_ElementsShouldComeOutInOrder(void) {
+  uint32_t value;
+  uint32_t i;
+  for (i = 1; i <= 3; i++) {
+    TEST_ASSERT_TRUE(SpscQueue_Push(&queue, &i));
+  }
+  TEST_ASSERT_EQUAL(3, SpscQueue_GetCount(&queue));
+
+  for (i = 1; i <= 3; i++) {
+    TEST_ASSERT_TRUE(SpscQueue_Pop(&queue, &value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+  TEST_ASSERT_FALSE(SpscQueue_Pop(&queue, &value));
+}
+
+void testSpscQueue_PushShouldDropWhenFull(void) {
+  uint32_t value;
+  uint32_t i;
+  for (i = 0; i < CAPACITY; i++) {
+    TEST_ASSERT_TRUE(SpscQueue_Push(&queue, &i));
+  }
+  TEST_ASSERT_FALSE(SpscQueue_Push(&queue, &i));
+  TEST_ASSERT_EQUAL(1, SpscQueue_GetDropped(&queue));
+  TEST_ASSERT_EQUAL(CAPACITY, SpscQueue_GetCount(&queue));
+
+  // The full queue still holds the oldest elements.
+  TEST_ASSERT_TRUE(SpscQueue_Pop(&queue, &value));
+  TEST_ASSERT_EQUAL(0, value);
+  TEST_ASSERT_TRUE(SpscQueue_Push(&queue, &i));
+}
+
+void testSpscQueue_ShouldWorkAcrossCounterWraparound(void) {
+  uint32_t value;
+  uint32_t i;
+  queue.head = UINT32_MAX - 1;
+  queue.tail = UINT32_MAX - 1;
+  for (i = 0; i < CAPACITY; i++) {
+    TEST_ASSERT_TRUE(SpscQueue_Push(&queue, &i));
+  }
+  TEST_ASSERT_EQUAL(CAPACITY, SpscQueue_GetCount(&queue));
+  TEST_ASSERT_FALSE(SpscQueue_Push(&queue, &i));
+  for (i = 0; i < CAPACITY; i++) {
+    TEST_ASSERT_TRUE(SpscQueue_Pop(&queue, &value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+  TEST_ASSERT_EQUAL(0, SpscQueue_GetCount(&queue));
+}
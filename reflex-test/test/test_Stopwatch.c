@@ -0,0 +1,102 @@
+#include "unity.h"
+#include "Stopwatch.h"
+#include "mock_globalTimer.h"
+
+static Stopwatch stopwatch;
+
+void setUp(void) {
+  Stopwatch_Init(&stopwatch);
+}
+
+void tearDown(void) {
+}
+
+void testStopwatch_InitShouldLeaveItStoppedAtZero(void) {
+  TEST_ASSERT_FALSE(Stopwatch_IsRunning(&stopwatch));
+  TEST_ASSERT_EQUAL_UINT64(0, Stopwatch_GetTicks(&stopwatch));
+  TEST_ASSERT_EQUAL(0, Stopwatch_GetMicroseconds(&stopwatch));
+}
+
+void testStopwatch_ShouldCountFromStartToStop(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(1000);
+  Stopwatch_Start(&stopwatch);
+  TEST_ASSERT_TRUE(Stopwatch_IsRunning(&stopwatch));
+  globalTimer_getTimerValue_ExpectAndReturn(1000 + 325 * 250000ULL);
+  Stopwatch_Stop(&stopwatch);
+  TEST_ASSERT_FALSE(Stopwatch_IsRunning(&stopwatch));
+
+  // A stopped stopwatch does not read the timer.
+  TEST_ASSERT_EQUAL_UINT64(325 * 250000ULL, Stopwatch_GetTicks(&stopwatch));
+  TEST_ASSERT_EQUAL(250000, Stopwatch_GetMicroseconds(&stopwatch));
+}
+
+void testStopwatch_RunningStopwatchShouldIncludeTheCurrentRun(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(500);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(500 + 325 * 3);
+  TEST_ASSERT_EQUAL(3, Stopwatch_GetMicroseconds(&stopwatch));
+}
+
+void testStopwatch_StartShouldAddToTheTimeAlreadyCounted(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(100);
+  Stopwatch_Stop(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(1000);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(1050);
+  Stopwatch_Stop(&stopwatch);
+  TEST_ASSERT_EQUAL_UINT64(150, Stopwatch_GetTicks(&stopwatch));
+}
+
+void testStopwatch_StartAndStopShouldBeIgnoredWhenRepeated(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(100);
+  Stopwatch_Stop(&stopwatch);
+  Stopwatch_Stop(&stopwatch);
+  TEST_ASSERT_EQUAL_UINT64(100, Stopwatch_GetTicks(&stopwatch));
+}
+
+void testStopwatch_ResetShouldRestartARunningStopwatchFromZero(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(700);
+  Stopwatch_Reset(&stopwatch);
+  TEST_ASSERT_TRUE(Stopwatch_IsRunning(&stopwatch));
+  globalTimer_getTimerValue_ExpectAndReturn(720);
+  TEST_ASSERT_EQUAL_UINT64(20, Stopwatch_GetTicks(&stopwatch));
+}
+
+void testStopwatch_ResetShouldClearAStoppedStopwatch(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(700);
+  Stopwatch_Stop(&stopwatch);
+  Stopwatch_Reset(&stopwatch);
+  TEST_ASSERT_EQUAL_UINT64(0, Stopwatch_GetTicks(&stopwatch));
+}
+
+void testStopwatch_StopwatchesShouldBeIndependent(void) {
+  Stopwatch other;
+  Stopwatch_Init(&other);
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(400);
+  Stopwatch_Start(&other);
+  globalTimer_getTimerValue_ExpectAndReturn(1000);
+  Stopwatch_Stop(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(1100);
+  Stopwatch_Stop(&other);
+  TEST_ASSERT_EQUAL_UINT64(1000, Stopwatch_GetTicks(&stopwatch));
+  TEST_ASSERT_EQUAL_UINT64(700, Stopwatch_GetTicks(&other));
+}
+
+void testStopwatch_GetMicrosecondsShouldSaturate(void) {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  Stopwatch_Start(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(325ULL * UINT32_MAX + 325 * 10);
+  Stopwatch_Stop(&stopwatch);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, Stopwatch_GetMicroseconds(&stopwatch));
+}
@@ -5,6 +5,9 @@
 #include "mock_TimerModel.h"
 #include "mock_intervalTimer.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup(void) {
 }
 
@@ -12,76 +15,92 @@ void tearDown(void) {
 }
 
 void testTimerConductorInitShouldCallHardwareInitAndModelInit() {
-  TimerHardware_Init_Expect();
-  TimerModel_Init_Expect();
+  TimerHardware_Init_Expect(&context.infoStopwatch);
+  TimerModel_Init_Expect(&context);
 
-  TimerConductor_Init();
+  TimerConductor_Init(&context);
 }
 
 void testTimerConductor_ResetAndStartTimerInShowInfoState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(show_info_st);
-  TimerHardware_ResetTimer_Expect();
-  TimerHardware_StartTimer_Expect();
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, show_info_st);
+  TimerHardware_ResetTimer_Expect(&context.infoStopwatch);
+  TimerHardware_StartTimer_Expect(&context.infoStopwatch);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInWaitInfoState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(wait_info_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, wait_info_st);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInWaitFiveSecState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(wait_five_seconds_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, wait_five_seconds_st);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_StopTimerInBlankScreenAndClearStatsState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(blank_screen_st);
-  TimerHardware_StopTimer_Expect();
-  TimerHardware_GetResponseTime_ExpectAndReturn(8.88);
-  TimerModel_SetMostRecentResponseTime_Expect(8.88);
-  TimerModel_ClearOldStats_Expect();
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, blank_screen_st);
+  TimerHardware_StopTimer_Expect(&context.infoStopwatch);
+  TimerHardware_GetResponseTime_ExpectAndReturn(&context.infoStopwatch, 8880000);
+  TimerModel_SetMostRecentResponseTime_Expect(&context, 8880000);
+  TimerModel_ClearOldStats_Expect(&context);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInWaitBetweenFlashState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(wait_between_flash_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, wait_between_flash_st);
+  TimerConductor_Run(&context);
 }
 
-void testTimerConductor_TurnOnTheTimerInBlinkLEDState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(blink_led_st);
-  TimerHardware_ResetTimer_Expect();
-  TimerHardware_StartTimer_Expect();
-  TimerConductor_Run();
+void testTimerConductor_ShouldDoNothingInBlinkLEDState(void) {
+  // The LED conductor stamps the stimulus itself.
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, blink_led_st);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInWaitForButtonState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(wait_for_button_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, wait_for_button_st);
+  TimerConductor_Run(&context);
 }
 
-void testTimerConductor_TurnOffTheTimerInButtonPressedState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(button_pressed_st);
-  TimerHardware_StopTimer_Expect();
-  TimerHardware_GetResponseTime_ExpectAndReturn(8.88);
-  TimerModel_SetMostRecentResponseTime_Expect(8.88);
-  TimerModel_RecordResponseTime_Expect(8.88);
-  TimerConductor_Run();
+void testTimerConductor_RecordTheResponseInButtonPressedState(void) {
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, button_pressed_st);
+  TimerHardware_GetTimestamp_ExpectAndReturn(8880000);
+  TimerModel_GetResponseTime_ExpectAndReturn(&context, 8880000, 250000);
+  TimerModel_SetMostRecentResponseTime_Expect(&context, 250000);
+  TimerModel_RecordResponseTime_Expect(&context, 250000);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_CalculateStatesAndProvideInfoInShowStatsState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(show_stats_st);
-  TimerModel_CalculateStats_Expect();
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, show_stats_st);
+  TimerModel_CalculateStats_Expect(&context);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInWaitStatsState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(wait_stats_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, wait_stats_st);
+  TimerConductor_Run(&context);
 }
 
 void testTimerConductor_ShouldDoNothingInUpdateScoresState(void) {
-  TimerModel_GetCurrentState_ExpectAndReturn(update_scores_st);
-  TimerConductor_Run();
+  TimerModel_GetCurrentState_ExpectAndReturn(&context, update_scores_st);
+  TimerConductor_Run(&context);
+}
+
+void testTimerConductor_GetActionShouldOnlyReturnActionsForActiveStates(void) {
+  TEST_ASSERT_NOT_NULL(TimerConductor_GetAction(show_info_st));
+  TEST_ASSERT_NOT_NULL(TimerConductor_GetAction(blank_screen_st));
+  TEST_ASSERT_NOT_NULL(TimerConductor_GetAction(button_pressed_st));
+  TEST_ASSERT_NOT_NULL(TimerConductor_GetAction(show_stats_st));
+
+  TEST_ASSERT_NULL(TimerConductor_GetAction(init_st));
+  TEST_ASSERT_NULL(TimerConductor_GetAction(blink_led_st));
+  TEST_ASSERT_NULL(TimerConductor_GetAction(wait_between_flash_st));
+  TEST_ASSERT_NULL(TimerConductor_GetAction(wait_stats_st));
+}
+
+void testTimerConductor_GetCurrentTimeShouldReturnTheHardwareTimestamp(void) {
+  TimerHardware_GetTimestamp_ExpectAndReturn(1234567);
+  TEST_ASSERT_EQUAL_UINT64(1234567, TimerConductor_GetCurrentTime());
 }
@@ -1,30 +1,61 @@
 #include "unity.h"
 #include "TimerHardware.h"
+#include "Stopwatch.h"
 
 #include "mock_TimerConductor.h"
 #include "mock_TimerModel.h"
 #include "mock_intervalTimer.h"
+#include "mock_globalTimer.h"
+#include "mock_InputLog.h"
 
-void testTimerHardware_InitShouldInitializeTimersAndStartTimer0() {
+static Stopwatch stopwatch;
+
+void testTimerHardware_InitShouldInitializeTimersAndStartTheStopwatch() {
   intervalTimer_initAll_ExpectAndReturn(0);
-  intervalTimer_start_ExpectAndReturn(INTERVALTIMER_TIMER0, 0);
+  globalTimer_startTimer_Expect(false);
+  globalTimer_getTimerValue_ExpectAndReturn(0);
 
-  TimerHardware_Init();
+  TimerHardware_Init(&stopwatch);
 }
 
-void testTimerHardware_StopTimerShouldStopIntervalTimer0() {
-  intervalTimer_stop_ExpectAndReturn(INTERVALTIMER_TIMER0, 0);
-
-  TimerHardware_StopTimer();
+void testTimerHardware_TimerShouldNotTouchTheIntervalTimers() {
+  intervalTimer_initAll_ExpectAndReturn(0);
+  globalTimer_startTimer_Expect(false);
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  TimerHardware_Init(&stopwatch);
+
+  // Only the global timer is read; any intervalTimer call would fail.
+  globalTimer_getTimerValue_ExpectAndReturn(1000);
+  TimerHardware_ResetTimer(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(1000 + GLOBAL_TIMER_TICKS_PER_SECOND / 4);
+  TimerHardware_StopTimer(&stopwatch);
+  InputLog_ResponseTime_ExpectAndReturn(250000, 250000);
+  TEST_ASSERT_EQUAL(250000, TimerHardware_GetResponseTime(&stopwatch));
+
+  globalTimer_getTimerValue_ExpectAndReturn(5000);
+  TimerHardware_StartTimer(&stopwatch);
 }
 
-void testTimerHardware_StartTimerShouldStartIntervalTimer0() {
-  intervalTimer_start_ExpectAndReturn(INTERVALTIMER_TIMER0, 0);
+void testTimerHardware_GetResponseTimeShouldReturnTheTimeFromTheInputLog() {
+  intervalTimer_initAll_ExpectAndReturn(0);
+  globalTimer_startTimer_Expect(false);
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  TimerHardware_Init(&stopwatch);
+  globalTimer_getTimerValue_ExpectAndReturn(GLOBAL_TIMER_TICKS_PER_SECOND);
+  TimerHardware_StopTimer(&stopwatch);
+
+  InputLog_ResponseTime_ExpectAndReturn(1000000, 420000);
+  TEST_ASSERT_EQUAL(420000, TimerHardware_GetResponseTime(&stopwatch));
+}
 
-  TimerHardware_StartTimer();
+void testTimerHardware_GetTimestampShouldConvertGlobalTimerTicksToMicroseconds() {
+  globalTimer_getTimerValue_ExpectAndReturn(GLOBAL_TIMER_TICKS_PER_SECOND * 3ULL);
+  InputLog_Timestamp_ExpectAndReturn(3000000, 3000000);
+  TEST_ASSERT_EQUAL_UINT64(3000000, TimerHardware_GetTimestamp());
 }
 
-void testTimerHardware_GetResponseTimeShouldReturnDurationThatTheTimerRan() {
-  intervalTimer_getTotalDurationInSeconds_IgnoreAndReturn(0);
-  TimerHardware_GetResponseTime();
+void testTimerHardware_GetTimestampShouldReturnTheTimeFromTheInputLog() {
+  globalTimer_getTimerValue_ExpectAndReturn(0);
+  InputLog_Timestamp_ExpectAndReturn(0, 1234);
+  TEST_ASSERT_EQUAL_UINT64(1234, TimerHardware_GetTimestamp());
 }
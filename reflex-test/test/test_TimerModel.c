@@ -2,6 +2,9 @@
 #include "TimerModel.h"
 #include "ReflexTestData.h"
 
+// The game that every test works on.
+static ReflexTest_Context context;
+
 void setup() {
 
 }
@@ -11,89 +14,190 @@ void tearDown() {
 }
 
 void testTimerModel_ShouldBeAbleToRecordResponseTimesAndCalculateCorrectly() {
-  TimerModel_ClearOldStats();
-  ReflexTestData_Init();
+  TimerModel_ClearOldStats(&context);
+  ReflexTestData_Init(&context);
 
   // Save a sequence of 10 "reponse times"
-  TimerModel_RecordResponseTime(0.2);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 200000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.1);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 100000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.9);
-  ReflexTestData_IncrementIndex(); // increment index
+  // An 11th response is past the end of the sequence and is not kept.
+  TimerModel_RecordResponseTime(&context, 900000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_CalculateStats();
+  TimerModel_CalculateStats(&context);
 
-  TEST_ASSERT_EQUAL(0.1, TimerModel_GetMin());
-  TEST_ASSERT_EQUAL(0.9, TimerModel_GetMax());
-  TEST_ASSERT_EQUAL(0.19, TimerModel_GetAverage());
+  TEST_ASSERT_EQUAL(100000, TimerModel_GetMin(&context));
+  TEST_ASSERT_EQUAL(200000, TimerModel_GetMax(&context));
+  TEST_ASSERT_EQUAL(110000, TimerModel_GetAverage(&context));
 
-  TimerModel_ClearOldStats();
-  ReflexTestData_Init();
+  TimerModel_ClearOldStats(&context);
+  ReflexTestData_Init(&context);
 
   // Save a sequence of 10 "reponse times"
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
+
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_RecordResponseTime(&context, 300000);
+  ReflexTestData_IncrementIndex(&context); // increment index
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  TimerModel_CalculateStats(&context);
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  TEST_ASSERT_EQUAL(300000, TimerModel_GetMin(&context));
+  TEST_ASSERT_EQUAL(300000, TimerModel_GetMax(&context));
+  TEST_ASSERT_EQUAL(300000, TimerModel_GetAverage(&context));
+}
+
+void testTimerModel_GetResponseTimeShouldRunFromTheStimulusToThePress() {
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  ReflexTestData_SetStimulusTime(&context, 1000000);
+
+  // A press from before the LED went on does not count, so the press is
+  // taken to be now.
+  ReflexTestData_SetPressTime(&context, 900000);
+  TEST_ASSERT_EQUAL(500000, TimerModel_GetResponseTime(&context, 1500000));
+
+  ReflexTestData_SetPressTime(&context, 1250125);
+  TEST_ASSERT_EQUAL(250125, TimerModel_GetResponseTime(&context, 1500000));
+}
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+void testTimerModel_GetResponseTimeShouldTakeOutTheOverhead() {
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  TimerModel_SetOverhead(&context, 1600);
+  ReflexTestData_SetStimulusTime(&context, 1000000);
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  // The LED came on 1.6 us after it was stamped.
+  ReflexTestData_SetPressTime(&context, 1250000);
+  TEST_ASSERT_EQUAL(249998, TimerModel_GetResponseTime(&context, 0));
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+  ReflexTestData_SetPressTime(&context, 1000001);
+  TEST_ASSERT_EQUAL(0, TimerModel_GetResponseTime(&context, 0));
+}
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+/**
+ * Records one response for each LED of the round.
+ */
+static void recordRound(const uint32_t* times) {
+  int i;
+  for (i = 0; i < REFLEXTESTDATA_SEQUENCE_LENGTH; i++) {
+    TimerModel_RecordResponseTime(&context, times[i]);
+    ReflexTestData_IncrementIndex(&context);
+  }
+}
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+void testTimerModel_ResponsesFasterThanTheFloorShouldNotCount() {
+  uint32_t times[REFLEXTESTDATA_SEQUENCE_LENGTH] = {
+    300000, 300000, 40000, 300000, 300000, 300000, 99999, 300000, 400000, 300000,
+  };
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  TimerModel_ClearOldStats(&context);
+  TEST_ASSERT_TRUE(TimerModel_IsFalseStart(&context, REFLEXTESTDATA_FALSE_START_FLOOR - 1));
+  TEST_ASSERT_FALSE(TimerModel_IsFalseStart(&context, REFLEXTESTDATA_FALSE_START_FLOOR));
+
+  recordRound(times);
+  TimerModel_CalculateStats(&context);
+
+  TEST_ASSERT_EQUAL(300000, TimerModel_GetMin(&context));
+  TEST_ASSERT_EQUAL(400000, TimerModel_GetMax(&context));
+  TEST_ASSERT_EQUAL(312500, TimerModel_GetAverage(&context));
+  TEST_ASSERT_EQUAL(2, ReflexTestData_GetFalseStarts(&context));
+}
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+void testTimerModel_AnEarlyPressShouldMakeTheNextResponseAFalseStart() {
+  uint32_t times[REFLEXTESTDATA_SEQUENCE_LENGTH] = {
+    200000, 200000, 200000, 200000, 200000, 200000, 200000, 200000, 200000, 200000,
+  };
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  TimerModel_ClearOldStats(&context);
+
+  // Only the first response follows the early press.
+  ReflexTestData_SetAnticipated(&context, true);
+  TEST_ASSERT_TRUE(TimerModel_IsFalseStart(&context, 250000));
+  times[0] = 150000;
+  recordRound(times);
+  TEST_ASSERT_FALSE(ReflexTestData_IsAnticipated(&context));
+  TimerModel_CalculateStats(&context);
+
+  TEST_ASSERT_EQUAL(200000, TimerModel_GetMin(&context));
+  TEST_ASSERT_EQUAL(200000, TimerModel_GetAverage(&context));
+  TEST_ASSERT_EQUAL(1, ReflexTestData_GetFalseStarts(&context));
+}
 
-  TimerModel_RecordResponseTime(0.3);
-  ReflexTestData_IncrementIndex(); // increment index
+void testTimerModel_FalseStartFloorShouldBeAdjustable() {
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  TimerModel_SetFalseStartFloor(&context, 150000);
+  TEST_ASSERT_TRUE(TimerModel_IsFalseStart(&context, 120000));
+  TimerModel_SetFalseStartFloor(&context, 0);
+  TEST_ASSERT_FALSE(TimerModel_IsFalseStart(&context, 0));
+}
 
-  TimerModel_CalculateStats();
+void testTimerModel_ARoundOfFalseStartsShouldKeepTheSlowestAverage() {
+  uint32_t times[REFLEXTESTDATA_SEQUENCE_LENGTH] = { 0 };
+  ReflexTestData_Init(&context);
+  TimerModel_Init(&context);
+  TimerModel_ClearOldStats(&context);
+  recordRound(times);
+  TimerModel_CalculateStats(&context);
 
-  TEST_ASSERT_EQUAL(0.3, TimerModel_GetMin());
-  TEST_ASSERT_EQUAL(0.3, TimerModel_GetMax());
-  TEST_ASSERT_EQUAL(0.3, TimerModel_GetAverage());
+  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SLOWEST_RESPONSE_TIME, TimerModel_GetAverage(&context));
+  TEST_ASSERT_EQUAL(REFLEXTESTDATA_SEQUENCE_LENGTH, ReflexTestData_GetFalseStarts(&context));
 }
@@ -0,0 +1,151 @@
+#include "unity.h"
+#include "TouchHardware.h"
+#include "SpscQueue.h"
+#include "mock_displayTouch.h"
+#include "mock_LcdHardware.h"
+#include "mock_globalTimer.h"
+#include "fakeGlobalTimer.h"
+
+// The touch controller's interrupt handler that TouchHardware_Init()
+// connected.
+static display_touchHandler_t touchHandler;
+
+// Samples waiting in the fake touch controller's FIFO.
+static display_touchPoint_t fifo[TOUCHHARDWARE_POINTS_PER_READ];
+static uint8_t fifoCount;
+
+static TouchHardware_Event events[TOUCHHARDWARE_MAX_EVENTS];
+static uint64_t lastPoll;
+
+// One poll period in global timer ticks.
+#define POLL_PERIOD ((uint64_t) TOUCHHARDWARE_POLL_PERIOD * (GLOBAL_TIMER_TICKS_PER_SECOND / 1000000))
+
+static int captureTouchHandler(display_touchHandler_t handler, int cmock_num_calls) {
+  touchHandler = handler;
+  return DISPLAY_TOUCH_STATUS_OK;
+}
+
+static int failToConnect(display_touchHandler_t handler, int cmock_num_calls) {
+  return DISPLAY_TOUCH_STATUS_FAIL;
+}
+
+static uint8_t fakeReadTouchedPoints(display_touchPoint_t* points, uint8_t maxPoints, int cmock_num_calls) {
+  uint8_t i;
+  uint8_t count = fifoCount;
+  for (i = 0; i < count && i < maxPoints; i++) {
+    points[i] = fifo[i];
+  }
+  fifoCount = 0;
+  return count;
+}
+
+/**
+ * A sample lands in the FIFO, and the interrupt fires if it is connected.
+ */
+static void sample(uint64_t timestamp, int16_t x) {
+  fakeGlobalTimer_set(timestamp);
+  fifo[fifoCount].x = x;
+  fifo[fifoCount].y = 120;
+  fifo[fifoCount].z = 30;
+  fifoCount++;
+  if (touchHandler != NULL) {
+    touchHandler();
+  }
+}
+
+/**
+ * Starts the touchscreen with or without its interrupt.
+ */
+static void init(bool withInterrupt) {
+  display_initTouch_Expect();
+  display_clearOldTouchData_Expect();
+  display_enableTouchInterrupts_StubWithCallback(withInterrupt ? captureTouchHandler : failToConnect);
+  TouchHardware_Init();
+}
+
+void setUp(void) {
+  fakeGlobalTimer_init(0);
+  fifoCount = 0;
+  lastPoll = 0;
+  touchHandler = NULL;
+  globalTimer_getTimerValue_StubWithCallback(fakeGlobalTimer_read);
+  display_readTouchedPoints_StubWithCallback(fakeReadTouchedPoints);
+}
+
+void tearDown(void) {
+}
+
+void testTouchHardware_InitShouldConnectTheInterrupt(void) {
+  init(true);
+  TEST_ASSERT_NOT_NULL(touchHandler);
+}
+
+void testTouchHardware_ReadShouldNotTouchTheBusUntilTheInterruptFires(void) {
+  init(true);
+  // No expectations: the FIFO is not read.
+  display_readTouchedPoints_StubWithCallback(NULL);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0, events));
+}
+
+void testTouchHardware_SamplesShouldBeDatedToTheFirstInterrupt(void) {
+  init(true);
+  sample(1000, 200);
+  sample(1300, 210);
+
+  fakeGlobalTimer_set(5000);
+  LcdHardware_GetTargetAt_ExpectAndReturn(200, 0x2);
+  LcdHardware_GetTargetAt_ExpectAndReturn(210, 0x2);
+  display_isTouched_ExpectAndReturn(true);
+  TEST_ASSERT_EQUAL(1, TouchHardware_Read(&lastPoll, 0, events));
+  TEST_ASSERT_EQUAL_UINT64(1000, events[0].timestamp);
+  TEST_ASSERT_EQUAL(0x2, events[0].targets);
+}
+
+void testTouchHardware_LettingGoShouldBeDatedToTheRead(void) {
+  init(true);
+  sample(1000, 20);
+  fakeGlobalTimer_set(90000);
+  touchHandler();  // the touch detection interrupt, with nothing in the FIFO
+
+  LcdHardware_GetTargetAt_ExpectAndReturn(20, 0x8);
+  display_isTouched_ExpectAndReturn(false);
+  TEST_ASSERT_EQUAL(2, TouchHardware_Read(&lastPoll, 0, events));
+  TEST_ASSERT_EQUAL_UINT64(1000, events[0].timestamp);
+  TEST_ASSERT_EQUAL(0x8, events[0].targets);
+  TEST_ASSERT_EQUAL_UINT64(90000, events[1].timestamp);
+  TEST_ASSERT_EQUAL(0x0, events[1].targets);
+}
+
+void testTouchHardware_WithoutTheInterruptTheFifoShouldBePolled(void) {
+  init(false);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0, events));
+
+  sample(POLL_PERIOD, 300);
+  LcdHardware_GetTargetAt_ExpectAndReturn(300, 0x1);
+  display_isTouched_ExpectAndReturn(true);
+  TEST_ASSERT_EQUAL(1, TouchHardware_Read(&lastPoll, 0, events));
+  TEST_ASSERT_EQUAL_UINT64(POLL_PERIOD, events[0].timestamp);
+
+  // Held down with an empty FIFO: only the panel is asked.
+  fakeGlobalTimer_set(2 * POLL_PERIOD);
+  display_isTouched_ExpectAndReturn(true);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0x1, events));
+}
+
+void testTouchHardware_PollingShouldWaitForThePollPeriod(void) {
+  init(false);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0, events));
+
+  // No expectations: a fast tick does not reach the bus before the period.
+  display_readTouchedPoints_StubWithCallback(NULL);
+  sample(POLL_PERIOD / 20, 300);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0, events));
+  fakeGlobalTimer_set(POLL_PERIOD - 1);
+  TEST_ASSERT_EQUAL(0, TouchHardware_Read(&lastPoll, 0, events));
+
+  display_readTouchedPoints_StubWithCallback(fakeReadTouchedPoints);
+  fakeGlobalTimer_set(POLL_PERIOD);
+  LcdHardware_GetTargetAt_ExpectAndReturn(300, 0x1);
+  display_isTouched_ExpectAndReturn(true);
+  TEST_ASSERT_EQUAL(1, TouchHardware_Read(&lastPoll, 0, events));
+}
@@ -0,0 +1,61 @@
+#include "unity.h"
+#include "Trace.h"
+#include "SpscQueue.h"
+
+void setUp(void) {
+  Trace_Init();
+}
+
+void tearDown(void) {
+}
+
+void testTrace_EntriesShouldBe16Bytes(void) {
+  TEST_ASSERT_EQUAL(16, sizeof(Trace_Entry));
+}
+
+void testTrace_ShouldRecordTransitionsInOrder(void) {
+  Trace_Entry entry;
+  Trace_RecordTransition(100, show_info_st, wait_info_st, TRACE_LED_ACTION);
+  Trace_RecordTransition(5000000000ULL, wait_info_st, wait_five_seconds_st, 0);
+  TEST_ASSERT_EQUAL(2, Trace_GetCount());
+
+  TEST_ASSERT_TRUE(Trace_Pop(&entry));
+  TEST_ASSERT_EQUAL_UINT64(100, entry.timestamp);
+  TEST_ASSERT_EQUAL(0, entry.sequence);
+  TEST_ASSERT_EQUAL(show_info_st, entry.from);
+  TEST_ASSERT_EQUAL(wait_info_st, entry.to);
+  TEST_ASSERT_EQUAL(TRACE_LED_ACTION, entry.actions);
+
+  TEST_ASSERT_TRUE(Trace_Pop(&entry));
+  TEST_ASSERT_EQUAL_UINT64(5000000000ULL, entry.timestamp);
+  TEST_ASSERT_EQUAL(1, entry.sequence);
+  TEST_ASSERT_EQUAL(wait_five_seconds_st, entry.to);
+
+  TEST_ASSERT_FALSE(Trace_Pop(&entry));
+}
+
+void testTrace_FullTraceShouldDropNewEntriesAndLeaveAGap(void) {
+  Trace_Entry entry;
+  int i;
+  for (i = 0; i < TRACE_CAPACITY + 2; i++) {
+    Trace_RecordTransition(i, show_info_st, wait_info_st, 0);
+  }
+  TEST_ASSERT_EQUAL(TRACE_CAPACITY, Trace_GetCount());
+  TEST_ASSERT_EQUAL(2, Trace_GetDropped());
+
+  TEST_ASSERT_EQUAL(TRACE_CAPACITY, Trace_Drain(UINT32_MAX));
+  Trace_RecordTransition(0, wait_info_st, show_info_st, 0);
+  TEST_ASSERT_TRUE(Trace_Pop(&entry));
+  TEST_ASSERT_EQUAL(TRACE_CAPACITY + 2, entry.sequence);
+}
+
+void testTrace_DrainShouldStopAtTheLimit(void) {
+  Trace_RecordTransition(1, show_info_st, wait_info_st, 0);
+  Trace_RecordTransition(2, wait_info_st, show_info_st, 0);
+  Trace_RecordTransition(3, show_info_st, wait_info_st, 0);
+
+  TEST_ASSERT_EQUAL(2, Trace_Drain(2));
+  TEST_ASSERT_EQUAL(1, Trace_GetCount());
+  TEST_ASSERT_EQUAL(1, Trace_Drain(2));
+  TEST_ASSERT_EQUAL(0, Trace_Drain(2));
+}